@@ -0,0 +1,96 @@
+function bench_command_buffer (N, prec, repeat)
+% Measure the latency of scalar MPFR operations with and without command
+% buffer.
+%
+%   bench_command_buffer ()
+%   bench_command_buffer (N)
+%   bench_command_buffer (N, prec)
+%   bench_command_buffer (N, prec, repeat)
+%
+% The recurrence of "doc/examples/listing_14_1.m" is computed for `N`
+% iterations (default: 200) at precision `prec` (default: 600) in three ways:
+%
+%   1. one MEX call per MPFR operation (six per iteration),
+%   2. one command buffer with six MPFR operations per iteration,
+%   3. one command buffer with all `6 * N` MPFR operations.
+%
+% `repeat` is the number of runs (default: 5), the fastest is reported.
+
+% Octave: pkg load apa
+% Matlab: cd /path/to/apa; install_apa ()
+
+  if (nargin < 1)
+    N = 200;
+  end
+  if (nargin < 2)
+    prec = 600;
+  end
+  if (nargin < 3)
+    repeat = 5;
+  end
+
+  u = mpfr_t (nan, prec);
+  v = mpfr_t (nan, prec);
+  x = mpfr_t (nan, prec);
+  y = mpfr_t (nan, prec);
+  z = mpfr_t (nan, prec);
+  iteration = { ...
+    {@mpfr_ui_div, x, 1130, v, MPFR_RNDN}, ...
+    {@mpfr_ui_sub, y, 111, x, MPFR_RNDN}, ...
+    {@mpfr_mul, z, v, u, MPFR_RNDN}, ...
+    {@mpfr_ui_div, x, 3000, z, MPFR_RNDN}, ...
+    {@mpfr_set, u, v, MPFR_RNDN}, ...
+    {@mpfr_add, v, y, x, MPFR_RNDN}};
+  buf_iteration = mpfr_t.command_buffer (iteration{:});
+  buf_all = repmat (buf_iteration, 1, N);
+
+  t = inf (3, 1);
+  result = zeros (3, 1);
+  for r = 1:repeat
+    init (u, v);
+    tic ();
+    for k = 1:N
+      mpfr_ui_div (x, 1130, v, MPFR_RNDN);
+      mpfr_ui_sub (y, 111, x, MPFR_RNDN);
+      mpfr_mul (z, v, u, MPFR_RNDN);
+      mpfr_ui_div (x, 3000, z, MPFR_RNDN);
+      mpfr_set (u, v, MPFR_RNDN);
+      mpfr_add (v, y, x, MPFR_RNDN);
+    end
+    t(1) = min (t(1), toc ());
+    result(1) = double (v);
+
+    init (u, v);
+    tic ();
+    for k = 1:N
+      mpfr_t.run_command_buffer (buf_iteration);
+    end
+    t(2) = min (t(2), toc ());
+    result(2) = double (v);
+
+    init (u, v);
+    tic ();
+    mpfr_t.run_command_buffer (buf_all);
+    t(3) = min (t(3), toc ());
+    result(3) = double (v);
+  end
+
+  if (any (result ~= result(1)))
+    error ('bench_command_buffer: results differ.');
+  end
+  num_ops = 6 * N;
+  fprintf ('%d MPFR operations at %d bit precision, u[%d] = %g:\n', ...
+           num_ops, prec, N + 1, result(1));
+  labels = {'one MEX call per operation', 'one MEX call per iteration', ...
+            'one MEX call in total'};
+  for i = 1:3
+    fprintf ('  %-27s %8.3f ms, %7.2f us per operation (%5.1fx)\n', ...
+             [labels{i}, ':'], 1e3 * t(i), 1e6 * t(i) / num_ops, t(1) / t(i));
+  end
+end
+
+
+function init (u, v)
+  mpfr_set_si (u, 2, MPFR_RNDN);
+  mpfr_set_si (v, -4, MPFR_RNDN);
+end
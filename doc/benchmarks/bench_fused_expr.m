@@ -0,0 +1,65 @@
+function bench_fused_expr (N, prec, repeat)
+% Compare the elementwise expression `a.*b + c./d - sqrt(e)` evaluated with
+% mpfr_t operators and with `mpfr_t.eval_expr`.
+%
+%   bench_fused_expr ()
+%   bench_fused_expr (N)
+%   bench_fused_expr (N, prec)
+%   bench_fused_expr (N, prec, repeat)
+%
+% The operands are [N x 1] vectors (default: N = 1e6) of precision `prec`
+% (default: 256).  With mpfr_t operators four temporary vectors are created,
+% `mpfr_t.eval_expr` only creates the result.
+%
+% `repeat` is the number of runs (default: 3), the fastest is reported.
+
+% Octave: pkg load apa
+% Matlab: cd /path/to/apa; install_apa ()
+
+  if (nargin < 1)
+    N = 1e6;
+  end
+  if (nargin < 2)
+    prec = 256;
+  end
+  if (nargin < 3)
+    repeat = 3;
+  end
+
+  a = mpfr_t (rand (N, 1), prec);
+  b = mpfr_t (rand (N, 1), prec);
+  c = mpfr_t (rand (N, 1), prec);
+  d = mpfr_t (rand (N, 1) + 1, prec);
+  e = mpfr_t (rand (N, 1), prec);
+
+  S = warning ('off', 'mpfr_t:inexactOperation');
+  t = inf (2, 1);
+  allocations = zeros (2, 1);
+  for r = 1:repeat
+    apa ('memory', 'reset');
+    tic ();
+    f1 = a.*b + c./d - sqrt (e);
+    t(1) = min (t(1), toc ());
+    stats = apa ('memory');
+    allocations(1) = stats.allocations;
+
+    apa ('memory', 'reset');
+    tic ();
+    f2 = mpfr_t.eval_expr ({a, b, '.*', c, d, './', '+', e, 'sqrt', '-'});
+    t(2) = min (t(2), toc ());
+    stats = apa ('memory');
+    allocations(2) = stats.allocations;
+  end
+  warning (S);
+
+  if (~ all (mpfr_equal_p (f1, f2)))
+    error ('bench_fused_expr: results differ.');
+  end
+  fprintf ('a.*b + c./d - sqrt(e) for N = %d at %d bit precision:\n', ...
+           N, prec);
+  labels = {'mpfr_t operators', 'mpfr_t.eval_expr'};
+  for i = 1:2
+    fprintf ('  %-17s %8.3f s, %d allocations (%4.1fx)\n', ...
+             [labels{i}, ':'], t(i), allocations(i), t(1) / t(i));
+  end
+end
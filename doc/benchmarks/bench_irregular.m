@@ -0,0 +1,85 @@
+function bench_irregular (N, prec, repeat)
+% Compare OpenMP schedules of elementwise functions whose cost varies by
+% orders of magnitude with the argument.
+%
+%   bench_irregular ()
+%   bench_irregular (N)
+%   bench_irregular (N, prec)
+%   bench_irregular (N, prec, repeat)
+%
+% `mpfr_gamma` and `mpfr_zeta` are evaluated for N (default: 2000) ascending
+% arguments of mixed magnitude 1e-2 ... 1e5, thus the hard arguments are
+% neighbors.  `mpfr_t (c)` parses a cell array `c` of N decimal strings of
+% 10 to 10000 digits.  All numbers have the precision `prec` (default: 256),
+% the strings are parsed at precision 10 * `prec`.
+%
+% The schedules are
+%
+%   1. serial,
+%   2. a static schedule, each thread gets one contiguous block,
+%   3. the default schedule of irregular commands with small chunks, which
+%      idle threads take over (`irregular_chunks` of `apa ('omp_cost_model')`).
+%
+% `repeat` is the number of runs (default: 3), the fastest is reported.
+
+% Octave: pkg load apa
+% Matlab: cd /path/to/apa; install_apa ()
+
+  if (nargin < 1)
+    N = 2000;
+  end
+  if (nargin < 2)
+    prec = 256;
+  end
+  if (nargin < 3)
+    repeat = 3;
+  end
+
+  x = mpfr_t (10.^linspace (-2, 5, N)', prec);
+  y = mpfr_t (zeros (N, 1), prec);
+  rnd = mpfr_get_default_rounding_mode ();
+  digits = round (10.^linspace (1, 4, N));
+  strs = cell (N, 1);
+  for i = 1:N
+    strs{i} = ['0.', char('0' + mod (1:digits(i), 10))];
+  end
+
+  model = apa ('omp_cost_model');
+  serial = model;
+  serial.threshold = 1e300;
+  static = model;
+  static.threshold = 0;
+  static.irregular_chunks = 0;
+  chunked = model;
+  chunked.threshold = 0;
+  schedules = {serial, static, chunked};
+
+  S = warning ('off', 'mpfr_t:inexactOperation');
+  t = inf (3, numel (schedules));
+  for r = 1:repeat
+    for s = 1:numel (schedules)
+      apa ('omp_cost_model', schedules{s});
+      tic ();
+      mpfr_gamma (y, x, rnd);
+      t(1,s) = min (t(1,s), toc ());
+      tic ();
+      mpfr_zeta (y, x, rnd);
+      t(2,s) = min (t(2,s), toc ());
+      tic ();
+      z = mpfr_t (strs, 10 * prec);
+      t(3,s) = min (t(3,s), toc ());
+    end
+  end
+  warning (S);
+  apa ('omp_cost_model', model);
+
+  threads = apa ('threads');
+  fprintf ('N = %d at %d bit precision, %d threads:\n', N, prec, ...
+           threads.team_size);
+  fprintf ('  %-12s %12s %12s %12s\n', '', 'serial', 'static', 'chunked');
+  labels = {'mpfr_gamma', 'mpfr_zeta', 'mpfr_strtofr'};
+  for i = 1:numel (labels)
+    fprintf ('  %-12s %10.3f s %10.3f s %10.3f s (%4.1fx)\n', ...
+             [labels{i}, ':'], t(i,:), t(i,2) / t(i,3));
+  end
+end
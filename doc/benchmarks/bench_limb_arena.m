@@ -0,0 +1,74 @@
+function bench_limb_arena (N, prec, repeat)
+% Compare matrix operations with and without the GMP limb arena.
+%
+%   bench_limb_arena ()
+%   bench_limb_arena (N)
+%   bench_limb_arena (N, prec)
+%   bench_limb_arena (N, prec, repeat)
+%
+% For both settings of `apa ('limb_arena')` the heap is fragmented first by
+% creating MPFR variables of mixed precisions and dropping some.  Then two
+% [N x N] matrices (default: N = 200) of precision `prec` (default: 256) are
+% created and the matrix multiplication and LU factorization are timed.
+%
+% `repeat` is the number of runs (default: 3), the fastest is reported.
+
+% Octave: pkg load apa
+% Matlab: cd /path/to/apa; install_apa ()
+
+  if (nargin < 1)
+    N = 200;
+  end
+  if (nargin < 2)
+    prec = 256;
+  end
+  if (nargin < 3)
+    repeat = 3;
+  end
+
+  old_limb_arena = apa ('limb_arena');
+  for limb_arena = [false, true]
+    apa ('limb_arena', limb_arena);
+    mex_apa_interface (3003, 1);  % Reset limb arena counters.
+
+    keep = fragment_heap (N, prec);
+    A = mpfr_t (rand (N), prec);
+    B = mpfr_t (rand (N), prec);
+
+    t_mtimes = inf;
+    t_lu = inf;
+    for r = 1:repeat
+      tic ();
+      C = A * B;
+      t_mtimes = min (t_mtimes, toc ());
+      tic ();
+      [L, U] = lu (A);
+      t_lu = min (t_lu, toc ());
+    end
+
+    stats = mex_apa_interface (3003);
+    fprintf ('limb_arena = %d: A * B %.3f s, lu (A) %.3f s\n', ...
+             limb_arena, t_mtimes, t_lu);
+    hit_rate = 100 * stats.hits / max (1, stats.hits + stats.misses);
+    fprintf (['  arena hit rate %.1f%% (%d hits, %d misses), ', ...
+              '%.1f MiB in %d chunks\n'], hit_rate, stats.hits, ...
+             stats.misses, stats.reserved_bytes / 2^20, stats.chunks);
+    clear A B C L U keep;
+  end
+  apa ('limb_arena', old_limb_arena);
+end
+
+
+function keep = fragment_heap (N, prec)
+  % Create and drop MPFR variables of mixed precisions, keeping every other
+  % alive.  Dropped variables are reused by the pool with their limbs.
+
+  keep = cell (N, 1);
+  for i = 1:N
+    x = mpfr_t (rand (N, 1), prec + 64 * mod (i, 5));
+    y = mpfr_t (rand (N, 1), prec);
+    if (mod (i, 2))
+      keep{i} = x;
+    end
+  end
+end
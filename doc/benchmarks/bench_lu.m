@@ -0,0 +1,70 @@
+function bench_lu (sizes, precs, threads, repeat)
+% Measure the thread scaling of the tiled LU factorization `mpfr_t.lu` and
+% of the linear solver `mpfr_t.mldivide` built on top of it.
+%
+%   bench_lu ()
+%   bench_lu (sizes)
+%   bench_lu (sizes, precs)
+%   bench_lu (sizes, precs, threads)
+%   bench_lu (sizes, precs, threads, repeat)
+%
+% Square random matrices of the sizes `sizes` (default: [200, 500, 1000,
+% 2000]) and precisions `precs` (default: [53, 256]) are factorized and
+% solved against one right-hand side with each number of OpenMP threads in
+% `threads` (default: 1, 2, 4, ... up to the current team size).  The speedup
+% is reported relative to the first entry of `threads`.
+%
+% `repeat` is the number of runs (default: 3), the fastest is reported.
+
+% Octave: pkg load apa
+% Matlab: cd /path/to/apa; install_apa ()
+
+  old_threads = apa ('threads');
+  if ((nargin < 1) || isempty (sizes))
+    sizes = [200, 500, 1000, 2000];
+  end
+  if ((nargin < 2) || isempty (precs))
+    precs = [53, 256];
+  end
+  if ((nargin < 3) || isempty (threads))
+    threads = unique ([2.^(0:floor (log2 (old_threads.team_size))), ...
+                       old_threads.team_size]);
+  end
+  if (nargin < 4)
+    repeat = 3;
+  end
+
+  fprintf ('time in seconds:\n');
+  fprintf ('  %5s %5s %7s %8s %8s %8s %8s\n', 'N', 'prec', 'threads', ...
+           't lu', 'speedup', 't \', 'speedup');
+
+  S = warning ('off', 'mpfr_t:inexactOperation');
+  for N = sizes
+    for prec = precs
+      A = mpfr_t (rand (N), prec);
+      b = mpfr_t (rand (N, 1), prec);
+
+      for t = threads
+        apa ('threads', t);
+        t_lu = inf;
+        t_solve = inf;
+        for r = 1:repeat
+          tic ();
+          [L, U, P] = lu (A);
+          t_lu = min (t_lu, toc ());
+          tic ();
+          x = A \ b;
+          t_solve = min (t_solve, toc ());
+        end
+        if (t == threads(1))
+          t_lu_1 = t_lu;
+          t_solve_1 = t_solve;
+        end
+        fprintf ('  %5d %5d %7d %8.3f %7.1fx %8.3f %7.1fx\n', N, prec, t, ...
+                 t_lu, t_lu_1 / t_lu, t_solve, t_solve_1 / t_solve);
+      end
+    end
+  end
+  warning (S);
+  apa ('threads', old_threads.team_size);
+end
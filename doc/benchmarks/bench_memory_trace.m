@@ -0,0 +1,147 @@
+function bench_memory_trace (trace_file, repeat)
+% Replay an allocation trace of MPFR variables and measure the time spent in
+% the memory management of the MEX interface (`mpfr_t.allocate` and
+% `mpfr_t.mark_free`).
+%
+%   bench_memory_trace ()
+%   bench_memory_trace (trace_file)
+%   bench_memory_trace (trace_file, repeat)
+%
+% `trace_file` is the diary of an Octave/Matlab session with very verbose
+% debug output `apa ('verbose', 3)`.  The allocation and free messages of the
+% memory management are extracted from it.  Without `trace_file` a trace of a
+% representative workload is recorded first: a scalar recurrence using the
+% overloaded operators (see "doc/examples/listing_14_1.m"), creating many
+% short-lived temporaries, interleaved with matrix operations.
+%
+% `repeat` is the number of replays (default: 5), the fastest is reported.
+
+% Octave: pkg load apa
+% Matlab: cd /path/to/apa; install_apa ()
+
+  if (nargin < 1)
+    trace_file = record_trace ();
+  end
+  if (nargin < 2)
+    repeat = 5;
+  end
+
+  ops = parse_trace (trace_file);
+  num_allocs = sum (ops(:,1) == 1);
+  fprintf ('Trace "%s": %d allocations, %d frees.\n', trace_file, ...
+           num_allocs, sum (ops(:,1) == 2));
+
+  t = inf;
+  for r = 1:repeat
+    t = min (t, replay_trace (ops, num_allocs));
+  end
+
+  fprintf ('Replay: %.3f s total, %.2f us per operation (best of %d).\n', ...
+           t, 1e6 * t / size (ops, 1), repeat);
+  fprintf ('Pool: data size = %d, data capacity = %d.\n', ...
+           mpfr_t.get_data_size (), mpfr_t.get_data_capacity ());
+end
+
+
+function trace_file = record_trace ()
+  % Record an allocation trace of a representative workload.
+
+  trace_file = [tempname(), '.log'];
+  old_verbose = apa ('verbose');
+  diary (trace_file);
+  apa ('verbose', 3);
+  try
+    % Scalar recurrence with temporaries.
+    u = mpfr_t (2, 600);
+    v = mpfr_t (-4, 600);
+    for k = 2:(200-1)
+      w = 111 - 1130 ./ v + 3000 ./ (v .* u);
+      u = v;
+      v = w;
+    end
+
+    % Matrix operations with longer living variables.
+    N = 20;
+    A = mpfr_t (rand (N) + N * eye (N), 128);
+    b = mpfr_t (rand (N, 1), 128);
+    for k = 1:10
+      x = A \ b;
+      r = A * x - b;
+      [L, U] = lu (A);
+      A = A + r(1);
+    end
+  catch err
+    apa ('verbose', old_verbose);
+    diary ('off');
+    rethrow (err);
+  end
+  apa ('verbose', old_verbose);
+  diary ('off');
+end
+
+
+function ops = parse_trace (trace_file)
+  % Extract allocation and free operations from a debug output diary.
+  %
+  % Each row of `ops` is `[type, id, count]` with `type = 1` for an allocation
+  % of `count` variables and `type = 2` for freeing the variables of
+  % allocation `id`.
+
+  str = fileread (trace_file);
+  [tok, pos] = regexp (str, ...
+    'New MPFR variable \[(\d+):(\d+)\]', 'tokens', 'start');
+  alloc = [pos(:), cellfun(@(t) str2double (t{1}), tok(:)), ...
+           cellfun(@(t) str2double (t{2}), tok(:))];
+  [tok, pos] = regexp (str, ...
+    '(?:mark_free|free_handles?)\]: \[(\d+):(\d+)\] will be marked as free', ...
+    'tokens', 'start');
+  free = [pos(:), cellfun(@(t) str2double (t{1}), tok(:)), ...
+          cellfun(@(t) str2double (t{2}), tok(:))];
+
+  events = sortrows ([ones(size (alloc, 1), 1), alloc; ...
+                      2 * ones(size (free, 1), 1), free], 2);
+
+  % Map recorded start indices to allocations.  Frees of variables allocated
+  % before the recording started are ignored.
+  live = containers.Map ('KeyType', 'double', 'ValueType', 'double');
+  ops = zeros (size (events, 1), 3);
+  num_ops = 0;
+  num_allocs = 0;
+  for i = 1:size (events, 1)
+    if (events(i,1) == 1)
+      num_allocs = num_allocs + 1;
+      live(events(i,3)) = num_allocs;
+      num_ops = num_ops + 1;
+      ops(num_ops,:) = [1, num_allocs, events(i,4) - events(i,3) + 1];
+    elseif (isKey (live, events(i,3)))
+      num_ops = num_ops + 1;
+      ops(num_ops,:) = [2, live(events(i,3)), 0];
+      remove (live, events(i,3));
+    end
+  end
+  ops = ops(1:num_ops,:);
+end
+
+
+function t = replay_trace (ops, num_allocs)
+  % Replay the operations and return the elapsed time.
+
+  idx = cell (num_allocs, 1);
+  tic ();
+  for i = 1:size (ops, 1)
+    if (ops(i,1) == 1)
+      idx{ops(i,2)} = mex_apa_interface (1902, ops(i,3));  % mpfr_t.allocate
+    else
+      mex_apa_interface (1903, idx{ops(i,2)});  % mpfr_t.mark_free
+      idx{ops(i,2)} = [];
+    end
+  end
+  t = toc ();
+
+  % Release variables still alive at the end of the trace.
+  for i = 1:num_allocs
+    if (~ isempty (idx{i}))
+      mex_apa_interface (1903, idx{i});
+    end
+  end
+end
@@ -0,0 +1,82 @@
+function bench_mtimes (sizes, precs, strategies, repeat)
+% Compare the strategies of the matrix multiplication `mpfr_t.mtimes`.
+%
+%   bench_mtimes ()
+%   bench_mtimes (sizes)
+%   bench_mtimes (sizes, precs)
+%   bench_mtimes (sizes, precs, strategies)
+%   bench_mtimes (sizes, precs, strategies, repeat)
+%
+% `sizes` is a [S x 3] matrix of dimensions [M, N, K] of `C = A * B`
+% (default: square, tall-skinny, vector-matrix, and inner product shapes).
+% All matrices have the precision `precs(p)` (default: [53, 256, 1024,
+% 4096]).  The strategies (default: 1:11) are
+%
+%   1, 2. serial loops ijk and jik,
+%   3, 4. one parallel loop over i or j,
+%   5, 6. two nested parallel loops,
+%   7.    parallel rows of A with correctly rounded dot products,
+%   8.    cache-blocked tiles of C in parallel (default),
+%   9.    exact fixed-point integer products, correctly rounded like 7,
+%   10.   like 9 in a residue number system (9 selects it for large sizes),
+%   11.   Strassen-Winograd recursion (see also `bench_strassen`).
+%
+% The serial strategies 1 and 2 are skipped for more than 1e7 multiply-adds.
+% `repeat` is the number of runs (default: 3), the fastest is reported.
+
+% Octave: pkg load apa
+% Matlab: cd /path/to/apa; install_apa ()
+
+  if ((nargin < 1) || isempty (sizes))
+    sizes = [200, 200, 200; 1000, 20, 200; 1, 400, 400; 20, 20, 5000];
+  end
+  if ((nargin < 2) || isempty (precs))
+    precs = [53, 256, 1024, 4096];
+  end
+  if ((nargin < 3) || isempty (strategies))
+    strategies = 1:11;
+  end
+  if (nargin < 4)
+    repeat = 3;
+  end
+
+  rnd = mpfr_get_default_rounding_mode ();
+  threads = apa ('threads');
+  fprintf ('%d threads, time in seconds:\n', threads.team_size);
+  fprintf ('  %5s %5s %5s %5s', 'M', 'N', 'K', 'prec');
+  fprintf (' %8d', strategies);
+  fprintf ('   speedup 8, 9, 10 vs 7\n');
+
+  S = warning ('off', 'mpfr_t:inexactOperation');
+  for s = 1:size (sizes, 1)
+    M = sizes(s,1);
+    N = sizes(s,2);
+    K = sizes(s,3);
+    for prec = precs
+      A = mpfr_t (rand (M, K), prec);
+      B = mpfr_t (rand (K, N), prec);
+      t = nan (1, numel (strategies));
+      for i = 1:numel (strategies)
+        if ((strategies(i) <= 2) && (M * N * K > 1e7))
+          continue;
+        end
+        t(i) = inf;
+        for r = 1:repeat
+          tic ();
+          C = mtimes (A, B, rnd, prec, strategies(i));
+          t(i) = min (t(i), toc ());
+        end
+      end
+      fprintf ('  %5d %5d %5d %5d', M, N, K, prec);
+      fprintf (' %8.3f', t);
+      i7 = find (strategies == 7);
+      if (~ isempty (i7))
+        for i = find ((strategies >= 8) & (strategies <= 10))
+          fprintf ('   %5.1fx', t(i7) / t(i));
+        end
+      end
+      fprintf ('\n');
+    end
+  end
+  warning (S);
+end
@@ -0,0 +1,52 @@
+function bench_pool_growth (N, step)
+% Measure the growth of the pool of MPFR variables to `N` elements.
+%
+%   bench_pool_growth ()
+%   bench_pool_growth (N)
+%   bench_pool_growth (N, step)
+%
+% The pool is grown by allocating `step` MPFR variables (default: 1e4) per
+% call of `mpfr_t.allocate` until `N` variables (default: 1e7) are in use.
+% The time and the pool capacity after each call are recorded, the calls that
+% grow the pool show its cost.  Finally all variables are freed again.
+%
+% Run this benchmark in a fresh Octave/Matlab session.  A pool of 1e7 MPFR
+% variables of 53 bit precision requires about 500 MB of memory.
+
+% Octave: pkg load apa
+% Matlab: cd /path/to/apa; install_apa ()
+
+  if (nargin < 1)
+    N = 1e7;
+  end
+  if (nargin < 2)
+    step = 1e4;
+  end
+
+  num_calls = ceil (N / step);
+  t = zeros (num_calls, 1);
+  capacity = zeros (num_calls, 1);
+  idx = cell (num_calls, 1);
+
+  t_total = tic ();
+  for i = 1:num_calls
+    t_call = tic ();
+    idx{i} = mex_apa_interface (1902, step, 53);  % mpfr_t.allocate
+    t(i) = toc (t_call);
+    capacity(i) = mpfr_t.get_data_capacity ();
+  end
+  t_total = toc (t_total);
+
+  for i = num_calls:-1:1
+    mex_apa_interface (1903, idx{i});  % mpfr_t.mark_free
+  end
+
+  grow = [true; diff(capacity) > 0];
+  fprintf ('Allocated %d MPFR variables in %d calls: %.3f s total.\n', ...
+           num_calls * step, num_calls, t_total);
+  fprintf ('  %.2f us per call without growth (median).\n', ...
+           1e6 * median (t(~grow)));
+  fprintf ('  %d calls with growth, %.2f ms slowest call.\n', ...
+           sum (grow), 1e3 * max (t(grow)));
+  fprintf ('  Final capacity: %d MPFR variables.\n', capacity(end));
+end
@@ -0,0 +1,77 @@
+function bench_scalar_latency (N, prec, repeat)
+% Measure the per-call latency of scalar mpfr_t additions.
+%
+%   bench_scalar_latency ()
+%   bench_scalar_latency (N)
+%   bench_scalar_latency (N, prec)
+%   bench_scalar_latency (N, prec, repeat)
+%
+% `N` scalar additions (default: 2000) at precision `prec` (default: 128)
+% are computed in four ways:
+%
+%   1. `c = a + b`, the mpfr_t operator, which creates `c`,
+%   2. `mpfr_add (c, a, b, rnd)` with mpfr_t objects, where the generated
+%      wrapper passes the "handle" property of each object,
+%   3. `mpfr_add (c.handle, a.handle, b.handle, rnd)` with uint64 handles,
+%   4. `mex_apa_interface (1031, ...)` with uint64 handles.
+%
+% `repeat` is the number of runs (default: 5), the fastest is reported.
+
+% Octave: pkg load apa
+% Matlab: cd /path/to/apa; install_apa ()
+
+  if (nargin < 1)
+    N = 2000;
+  end
+  if (nargin < 2)
+    prec = 128;
+  end
+  if (nargin < 3)
+    repeat = 5;
+  end
+
+  a = mpfr_t (1 / 3, prec);
+  b = mpfr_t (2 / 3, prec);
+  c = mpfr_t (0, prec);
+  rnd = mpfr_get_default_rounding_mode ();
+  ah = a.handle;
+  bh = b.handle;
+  ch = c.handle;
+
+  S = warning ('off', 'mpfr_t:inexactOperation');
+  t = inf (4, 1);
+  for r = 1:repeat
+    tic ();
+    for k = 1:N
+      d = a + b;
+    end
+    t(1) = min (t(1), toc ());
+
+    tic ();
+    for k = 1:N
+      mpfr_add (c, a, b, rnd);
+    end
+    t(2) = min (t(2), toc ());
+
+    tic ();
+    for k = 1:N
+      mpfr_add (ch, ah, bh, rnd);
+    end
+    t(3) = min (t(3), toc ());
+
+    tic ();
+    for k = 1:N
+      mex_apa_interface (1031, ch, ah, bh, rnd);
+    end
+    t(4) = min (t(4), toc ());
+  end
+  warning (S);
+
+  fprintf ('%d scalar additions at %d bit precision:\n', N, prec);
+  labels = {'c = a + b', 'mpfr_add, mpfr_t objects', ...
+            'mpfr_add, uint64 handles', 'mex_apa_interface, handles'};
+  for i = 1:4
+    fprintf ('  %-28s %8.2f us per call (%5.1fx)\n', [labels{i}, ':'], ...
+             1e6 * t(i) / N, t(1) / t(i));
+  end
+end
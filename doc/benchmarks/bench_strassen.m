@@ -0,0 +1,74 @@
+function bench_strassen (sizes, precs, cutoffs, repeat)
+% Compare the Strassen-Winograd recursion of `mpfr_t.mtimes` (strategy 11)
+% with the default cache-blocked multiplication (strategy 8).
+%
+%   bench_strassen ()
+%   bench_strassen (sizes)
+%   bench_strassen (sizes, precs)
+%   bench_strassen (sizes, precs, cutoffs)
+%   bench_strassen (sizes, precs, cutoffs, repeat)
+%
+% Square random matrices of the sizes `sizes` (default: [128, 256, 512]) and
+% precisions `precs` (default: [53, 256, 1024]) are multiplied with each
+% recursion cutoff `cutoffs` (default: [16, 32, 64]).  Next to the speedup,
+% the maximal error relative to the maximal element of the exact product is
+% reported in units of `2^-prec` for both strategies.
+%
+% `repeat` is the number of runs (default: 3), the fastest is reported.
+
+% Octave: pkg load apa
+% Matlab: cd /path/to/apa; install_apa ()
+
+  if ((nargin < 1) || isempty (sizes))
+    sizes = [128, 256, 512];
+  end
+  if ((nargin < 2) || isempty (precs))
+    precs = [53, 256, 1024];
+  end
+  if ((nargin < 3) || isempty (cutoffs))
+    cutoffs = [16, 32, 64];
+  end
+  if (nargin < 4)
+    repeat = 3;
+  end
+
+  rnd = mpfr_get_default_rounding_mode ();
+  threads = apa ('threads');
+  fprintf ('%d threads, time in seconds, error in units of 2^-prec:\n', ...
+           threads.team_size);
+  fprintf ('  %5s %5s %6s %8s %8s %8s %8s %8s\n', 'N', 'prec', 'cutoff', ...
+           't 8', 't 11', 'speedup', 'err 8', 'err 11');
+
+  S = warning ('off', 'mpfr_t:inexactOperation');
+  for N = sizes
+    for prec = precs
+      A = mpfr_t (rand (N), prec);
+      B = mpfr_t (rand (N), prec);
+
+      % The exact product is correctly rounded to twice the precision.
+      R = mtimes (A, B, rnd, 2 * prec, 9);
+      scale = max (max (double (abs (R)))) * 2^-prec;
+
+      t8 = inf;
+      for r = 1:repeat
+        tic ();
+        C = mtimes (A, B, rnd, prec, 8);
+        t8 = min (t8, toc ());
+      end
+      err8 = max (max (double (abs (C - R)))) / scale;
+
+      for cutoff = cutoffs
+        t11 = inf;
+        for r = 1:repeat
+          tic ();
+          C = mtimes (A, B, rnd, prec, 11, cutoff);
+          t11 = min (t11, toc ());
+        end
+        err11 = max (max (double (abs (C - R)))) / scale;
+        fprintf ('  %5d %5d %6d %8.3f %8.3f %7.1fx %8.1f %8.1f\n', N, ...
+                 prec, cutoff, t8, t11, t8 / t11, err8, err11);
+      end
+    end
+  end
+  warning (S);
+end
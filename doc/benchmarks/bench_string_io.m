@@ -0,0 +1,67 @@
+function bench_string_io (N, prec, repeat)
+% Measure the throughput of converting between mpfr_t and decimal strings.
+%
+%   bench_string_io ()
+%   bench_string_io (N)
+%   bench_string_io (N, prec)
+%   bench_string_io (N, prec, repeat)
+%
+% N (default: 1e6) random numbers of precision `prec` (default: 128) are
+% converted to decimal strings by `mpfr_get_str` with the full number of
+% digits and parsed again by `mpfr_set_str`.  Both conversions are run
+% serially and in parallel.
+%
+% `repeat` is the number of runs (default: 3), the fastest is reported.
+
+% Octave: pkg load apa
+% Matlab: cd /path/to/apa; install_apa ()
+
+  if (nargin < 1)
+    N = 1e6;
+  end
+  if (nargin < 2)
+    prec = 128;
+  end
+  if (nargin < 3)
+    repeat = 3;
+  end
+
+  x = mpfr_t (rand (N, 1) .* 10.^randi ([-20, 20], N, 1), prec);
+  y = mpfr_t (zeros (N, 1), prec);
+  rnd = mpfr_get_default_rounding_mode ();
+
+  model = apa ('omp_cost_model');
+  serial = model;
+  serial.threshold = 1e300;
+  parallel = model;
+  parallel.threshold = 0;
+  schedules = {serial, parallel};
+
+  t = inf (2, numel (schedules));
+  for r = 1:repeat
+    for s = 1:numel (schedules)
+      apa ('omp_cost_model', schedules{s});
+      tic ();
+      [significant, expptr] = mpfr_get_str (10, 0, x, rnd);
+      t(1,s) = min (t(1,s), toc ());
+      strs = strcat ('0.', significant, 'e', ...
+                     cellfun (@num2str, num2cell (expptr), ...
+                              'UniformOutput', false));
+      tic ();
+      mpfr_set_str (y, strs, 10, rnd);
+      t(2,s) = min (t(2,s), toc ());
+    end
+  end
+  apa ('omp_cost_model', model);
+  assert (all (mpfr_equal_p (x, y)));
+
+  threads = apa ('threads');
+  fprintf ('N = %d at %d bit precision, %d threads:\n', N, prec, ...
+           threads.team_size);
+  fprintf ('  %-14s %12s %12s\n', '', 'serial', 'parallel');
+  labels = {'mpfr_get_str', 'mpfr_set_str'};
+  for i = 1:numel (labels)
+    fprintf ('  %-14s %10.3f s %10.3f s (%4.1fx, %.2e numbers/s)\n', ...
+             [labels{i}, ':'], t(i,:), t(i,1) / t(i,2), N / t(i,2));
+  end
+end
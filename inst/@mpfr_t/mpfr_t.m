@@ -1,12 +1,17 @@
 classdef mpfr_t
 
   properties (SetAccess = protected)
-    dims  % Object dimensions.
-    idx   % Internal MPFR variable indices.
+    dims    % Object dimensions.
+    handle  % Internal uint64 handle of the MPFR variables.
     cleanupObj  % Destructor object.
   end
 
 
+  properties (Dependent)
+    idx  % Internal MPFR variable indices, only valid until `mpfr_t.compact`.
+  end
+
+
   methods (Static)
     function num = get_data_capacity ()
       % [internal] Return the number of pre-allocated MPFR variables.
@@ -22,24 +27,219 @@ classdef mpfr_t
     end
 
 
-    function idx = allocate (count)
+    function idx = allocate (count, prec)
       % [internal] Return the start and end index of a newly created MPFR
-      % variable for `count` elements.
+      % variable for `count` elements.  Unused MPFR variables of at least
+      % precision `prec` are preferred (default: `mpfr_get_default_prec ()`).
 
-      idx = mex_apa_interface (1902, count);
+      if (nargin < 2)
+        idx = mex_apa_interface (1902, count);
+      else
+        idx = mex_apa_interface (1902, count, prec);
+      end
     end
 
 
     function mark_free (idx)
       % [internal] Mark a MPFR variable or index range as free.  It is no
       % longer safe to use that variable or index range after calling this
-      % method.
+      % method.  Several MPFR variables can be given as cell array.
 
-      if (isa (idx, 'mpfr_t'))
-        idx = idx.idx;
+      if (iscell (idx))
+        handles = cellfun (@(x) x.handle, idx);
+        mex_apa_interface (1910, handles);  % mpfr_t.free_handles
+      elseif (isa (idx, 'mpfr_t'))
+        mex_apa_interface (1906, idx.handle);  % mpfr_t.free_handle
+      else
+        mex_apa_interface (1903, idx);
       end
+    end
 
-      mex_apa_interface (1903, idx);
+
+    function buf = command_buffer (varargin)
+      % [internal] Encode MPFR function calls `{@mpfr_fcn, arg1, arg2, ...}`
+      % for `mpfr_t.run_command_buffer`.  Arguments may be mpfr_t variables,
+      % index ranges, or numeric scalars.  mpfr_t variables are stored by
+      % their handle and remain valid after `mpfr_t.compact`, index ranges
+      % are invalid afterwards.
+
+      buf = cell (1, nargin);
+      for i = 1:nargin
+        code = mpfr_t.cmd_code (varargin{i}{1}, 'mpfr_t:command_buffer');
+        args = varargin{i}(2:end);
+        rec = cell (1, numel (args));
+        for j = 1:numel (args)
+          if (isa (args{j}, 'mpfr_t'))
+            rec{j} = [3, double(args{j}.handle)];
+          elseif (isnumeric (args{j}) && (numel (args{j}) == 2))
+            rec{j} = [2, args{j}(:)'];
+          elseif (isnumeric (args{j}) && isscalar (args{j}))
+            rec{j} = [1, double(args{j})];
+          else
+            error ('mpfr_t:command_buffer', ...
+                   'Invalid argument %d of call %d.', j, i);
+          end
+        end
+        buf{i} = [code, numel(args), rec{:}];
+      end
+      buf = [buf{:}];
+    end
+
+
+    function ret = run_command_buffer (buf)
+      % [internal] Execute all MPFR function calls of a command buffer created
+      % by `mpfr_t.command_buffer` in a single MEX call.  Return the number of
+      % inexact results of each call.
+
+      ret = mex_apa_interface (1911, buf);  % mpfr_t.run_command_buffer
+    end
+
+
+    function [flags, ret] = elementwise_flags (fcn, rop, varargin)
+      % [internal] Call the MPFR function `fcn (rop, varargin{:})` and return
+      % the MPFR exception flags raised by the computation of each element of
+      % `rop` as bitmask of the dimension of `rop`:
+      %
+      %   1 underflow, 2 overflow, 4 NaN, 8 inexact, 16 erange, 32 divby0.
+      %
+      % `ret` are the ternary return values of `fcn`.  The flags of all
+      % elements are also raised globally, e.g. for `mpfr_overflow_p`.
+
+      code = mpfr_t.cmd_code (fcn, 'mpfr_t:elementwise_flags');
+      if (isa (rop, 'mpfr_t'))
+        dims = rop.dims;
+        rop = rop.handle;
+      else
+        dims = [1, diff(rop) + 1];
+      end
+      args = varargin;
+      for i = 1:numel (args)
+        if (isa (args{i}, 'mpfr_t'))
+          args{i} = args{i}.handle;
+        end
+      end
+      [flags, ret] = mex_apa_interface (1914, code, rop, args{:});
+      flags = reshape (flags, dims);
+      ret = reshape (ret, dims);
+    end
+
+
+    function warm_up_cache (prec)
+      % [internal] Precompute the constants pi, log(2), Euler's constant, and
+      % Catalan's constant of precision `prec` (default:
+      % `mpfr_get_default_prec ()`) on all OpenMP threads.  The per-thread
+      % caches persist between calls and are reused by all MPFR functions.
+
+      if (nargin < 1)
+        prec = mex_apa_interface (1002);  % mpfr_get_default_prec
+      end
+      mex_apa_interface (1912, prec);  % mpfr_t.warm_up_cache
+    end
+
+
+    function free_cache ()
+      % [internal] Free the MPFR constant caches of all OpenMP threads.
+
+      mex_apa_interface (1913);  % mpfr_t.free_cache
+    end
+
+
+    function varargout = zeros_batch (dims, prec)
+      % [internal] Create `numel (dims)` mpfr_t zero matrices of dimensions
+      % `dims{i}` and precision `prec` (scalar or `prec(i)`) with a single
+      % allocation.
+
+      if (nargin < 2)
+        prec = mex_apa_interface (1002);  % mpfr_get_default_prec
+      end
+      counts = cellfun (@prod, dims);
+      % mpfr_t.allocate_handles
+      handles = mex_apa_interface (1909, counts(:), prec(:));
+      varargout = cell (1, numel (dims));
+      for i = 1:numel (dims)
+        varargout{i} = mpfr_t (dims{i}, [], [], handles(i));
+      end
+    end
+
+
+    function c = eval_expr (expr, rnd, prec)
+      % Evaluate the postfix expression `expr` elementwise in one pass using
+      % rounding mode `rnd`.  For example `a.*b + c./d - sqrt(e)` is
+      %
+      %   c = mpfr_t.eval_expr ({a, b, '.*', c, d, './', '+', e, 'sqrt', '-'})
+      %
+      % The elements of the cell array `expr` are mpfr_t operands of equal
+      % size or scalars, double scalars, binary operators '+', '-', '.*',
+      % './', '.^', 'min', 'max', and unary functions 'uminus', 'abs', 'sqrt',
+      % 'sqr', 'exp', 'log', 'sin', 'cos', 'tan'.  Intermediate results are
+      % only kept in scratch variables of precision `prec`, no temporary
+      % mpfr_t objects are created.
+      %
+      % If no rounding mode `rnd` is given, the default rounding mode is used.
+      %
+      % If no precision `prec` is given for `c` the maximum precision of all
+      % mpfr_t operands is used.
+
+      if (nargin < 2)
+        rnd = mpfr_get_default_rounding_mode ();
+      end
+      if (nargin < 3)
+        prec = [];
+      end
+      if (~ iscell (expr) || isempty (expr))
+        error ('mpfr_t:eval_expr', 'EXPR must be a non-empty cell array.');
+      end
+
+      binary_ops = {'+', '-', '.*', './', '.^', 'min', 'max'};
+      unary_ops = {'uminus', 'abs', 'sqrt', 'sqr', 'exp', 'log', 'sin', ...
+                   'cos', 'tan'};
+      prog = zeros (2, numel (expr));
+      ops = {};
+      dims = [1, 1];
+      max_prec = 0;
+      for i = 1:numel (expr)
+        e = expr{i};
+        if (isa (e, 'mpfr_t'))
+          ops{end+1} = e;
+          prog(:,i) = [1; numel(ops)];
+          max_prec = max ([max_prec; mpfr_get_prec(e)]);
+          if (prod (e.dims) ~= 1)
+            if ((prod (dims) ~= 1) && ~isequal (dims, e.dims))
+              error ('mpfr_t:eval_expr', ...
+                     'Incompatible dimensions of operand %d.', numel (ops));
+            end
+            dims = e.dims;
+          end
+        elseif (isnumeric (e) && isscalar (e))
+          prog(:,i) = [2; double(e)];
+        elseif (ischar (e) && any (strcmp (e, binary_ops)))
+          prog(:,i) = [3; find(strcmp (e, binary_ops))];
+        elseif (ischar (e) && any (strcmp (e, unary_ops)))
+          prog(:,i) = [4; find(strcmp (e, unary_ops))];
+        else
+          error ('mpfr_t:eval_expr', 'Invalid element %d of EXPR.', i);
+        end
+      end
+      if (isempty (ops))
+        error ('mpfr_t:eval_expr', 'EXPR must contain an mpfr_t operand.');
+      end
+      if (isempty (prec))
+        prec = max_prec;
+      end
+
+      c = mpfr_t.zeros_batch ({dims}, prec);
+      ret = mex_apa_interface (2005, c, prog, prec, rnd, ops{:});
+      c.warnInexactOperation (ret);
+    end
+
+
+    function num = compact ()
+      % [internal] Move all MPFR variables of mpfr_t objects to the beginning
+      % of the pool and release the memory of unused MPFR variables.  Index
+      % ranges of mpfr_t objects obtained before are invalid afterwards.
+      % Return the number of released MPFR variables.
+
+      num = mex_apa_interface (1907);
     end
   end
 
@@ -74,19 +274,59 @@ classdef mpfr_t
 
 
   methods (Static, Access = private)
-    function c = call_comparison_op (a, b, op)
+    function code = cmd_code (fcn, err_id)
+      % [internal] Return the command code of the MPFR interface function
+      % handle `fcn`, read from its generated m-file.  Raise error `err_id`
+      % for other functions.
+
+      persistent cmd_codes;
+      if (isempty (cmd_codes))
+        cmd_codes = containers.Map ();
+      end
+
+      fcn = func2str (fcn);
+      if (~ isKey (cmd_codes, fcn))
+        tok = [];
+        try
+          tok = regexp (fileread (which (fcn)), ...
+                        'mex_apa_interface \((\d+),', 'tokens', 'once');
+        catch
+          % Built-in or unknown function.
+        end
+        if (isempty (tok))
+          error (err_id, '"%s" is no MPFR interface function.', fcn);
+        end
+        cmd_codes(fcn) = str2double (tok{1});
+      end
+      code = cmd_codes(fcn);
+    end
+
+
+    function c = call_comparison_op (a, b, op, rel)
       % [internal] Handle calls to all sorts of MPFR comparision functions.
+      %
+      % A double operand is not converted, but compared by `mpfr_cmp_d` and
+      % the relation `rel` of the result to zero.  NaN compares false.
+      if (isa (a, 'mpfr_t') && isa (b, 'mpfr_t'))
+        c = (op (a, b) ~= 0);
+        c = reshape (c, a.dims);
+        return;
+      end
       if (isa (a, 'mpfr_t'))
-        new_dims = a.dims;
+        x = a;
+        d = double (b);
+        c = rel (mpfr_cmp_d (x, d(:)), 0);
       else
-        a = mpfr_t (a);
-        new_dims = b.dims;
+        x = b;
+        d = double (a);
+        c = rel (0, mpfr_cmp_d (x, d(:)));
       end
-      if (~isa (b, 'mpfr_t'))
-         b = mpfr_t (b);
+      c = c & ~(mpfr_nan_p (x) | isnan (d(:)));
+      if (prod (x.dims) == 1)
+        c = reshape (c, size (d));
+      else
+        c = reshape (c, x.dims);
       end
-      c = (op (a, b) ~= 0);
-      c = reshape (c, new_dims);
     end
   end
 
@@ -103,14 +343,24 @@ classdef mpfr_t
     obj = subsasgn (obj, s, b, rnd)
 
 
-    function obj = mpfr_t (x, prec, rnd)
+    function obj = mpfr_t (x, prec, rnd, handle)
       % Construct a mpfr_t variable of precision `prec` from `x` using rounding
       % mode `rnd`.
+      %
+      % [internal] With `handle` the MPFR variables were already created by
+      % `mpfr_t.zeros_batch` and `x` are the object dimensions.
 
       if (nargin < 1)
         error ('mpfr_t:mpfr_t', 'At least one argument must be provided.');
       end
 
+      if (nargin > 3)
+        obj.dims = x;
+        obj.handle = handle;
+        obj.cleanupObj = onCleanup(@() mex_apa_interface (1906, handle));
+        return;
+      end
+
       if (~ismatrix (x))
         error ('mpfr_t:mpfr_t', ...
           'Only two dimensional matrix input is supported.');
@@ -128,24 +378,27 @@ classdef mpfr_t
       end
       if (isa (x, 'mpfr_t'))
         obj.dims = x.dims;
-        prec = max (mex_apa_interface (1004, x.idx));  % mpfr_get_prec
+        prec = max (mex_apa_interface (1004, x.handle));  % mpfr_get_prec
       else
         obj.dims = size (x);
       end
       num_elems = prod (obj.dims);
-      obj.idx = mex_apa_interface (1902, num_elems)';  % mpfr_t.allocate
+      % mpfr_t.allocate_handle
+      obj.handle = mex_apa_interface (1904, num_elems, prec);
 
       % Register destructor
-      obj.cleanupObj = onCleanup(@() mex_apa_interface (1903, obj.idx));
+      handle = obj.handle;
+      obj.cleanupObj = onCleanup(@() mex_apa_interface (1906, handle));
 
-      mex_apa_interface (1003, obj.idx, prec);  % mpfr_set_prec
+      % Pass the uint64 handle instead of the object to the MEX interface.
+      mex_apa_interface (1003, handle, prec);  % mpfr_set_prec
 
       if (isa (x, 'mpfr_t'))
-        ret = mpfr_set (obj.idx, x.idx, rnd);
+        ret = mpfr_set (handle, x.handle, rnd);
       elseif (isnumeric (x))
-        ret = mex_apa_interface (1300, obj.idx, x(:), rnd);  % mpfr_set_d
+        ret = mex_apa_interface (1300, handle, x(:), rnd);  % mpfr_set_d
       elseif (iscellstr (x))
-        [ret, strpos] = mpfr_strtofr (obj.idx, x(:), 0, rnd);
+        [ret, strpos] = mpfr_strtofr (handle, x(:), 0, rnd);
         bad_strs = (cellfun (@numel, x(:)) >= strpos);
         if (any (bad_strs))
           % Assign x to mpfr variable using slower subsasgn function.
@@ -167,11 +420,18 @@ classdef mpfr_t
     end
 
 
+    function idx = get.idx (obj)
+      % [internal] Resolve the handle to the current index range.
+
+      idx = mex_apa_interface (1905, obj.handle)';  % mpfr_t.get_idx
+    end
+
+
     function prec = prec (obj)
       % Return the precision of obj, i.e., the number of bits used to store
       % its significant.
 
-      prec = mpfr_get_prec (obj);
+      prec = mpfr_get_prec (obj.handle);
     end
 
 
@@ -181,7 +441,7 @@ classdef mpfr_t
       if (nargin < 2)
         rnd = mpfr_get_default_rounding_mode ();
       end
-      d = reshape (mpfr_get_d (obj, rnd), obj.dims(1), obj.dims(2));
+      d = reshape (mpfr_get_d (obj.handle, rnd), obj.dims(1), obj.dims(2));
     end
 
 
@@ -211,7 +471,7 @@ classdef mpfr_t
       end
 
       % Get string representation of all elements.
-      [significant, exp] = mpfr_get_str (base, 0, obj.idx, rnd);
+      [significant, exp] = mpfr_get_str (base, 0, obj.handle, rnd);
 
       is_negative = cellfun (@(str) (str(1) == '-'), significant);
       if (strcmp (fmt, 'scientific'))
@@ -371,18 +631,19 @@ classdef mpfr_t
       elseif (isa (a, 'mpfr_t') && isnumeric (b))
         if (isscalar (b) || isequal (a.dims, size (b)))
           if (isempty (prec))
-            prec = max (mpfr_get_prec (a));
+            prec = max (mpfr_get_prec (a.handle));
           end
           cc = mpfr_t (zeros (a.dims), prec);
         else
           error ('mpfr_t:plus', 'Incompatible dimensions of a and b.');
         end
-        ret = mpfr_add_d (cc, a, double (b(:)), rnd);
+        ret = mpfr_add_d (cc.handle, a.handle, double (b(:)), rnd);
         cc.warnInexactOperation (ret);
         c = cc;  % Do not assign c before calculation succeeded!
       elseif (isa (a, 'mpfr_t') && isa (b, 'mpfr_t'))
         if (isempty (prec))
-          prec = max (max (mpfr_get_prec (a)), max (mpfr_get_prec (b)));
+          prec = max (max (mpfr_get_prec (a.handle)), ...
+                      max (mpfr_get_prec (b.handle)));
         end
         if (isequal (a.dims, b.dims) || isequal (b.dims, [1 1]))
           cc = mpfr_t (zeros (a.dims), prec);
@@ -391,7 +652,7 @@ classdef mpfr_t
         else
           error ('mpfr_t:plus', 'Incompatible dimensions of a and b.');
         end
-        ret = mpfr_add (cc, a, b, rnd);
+        ret = mpfr_add (cc.handle, a.handle, b.handle, rnd);
         cc.warnInexactOperation (ret);
         c = cc;  % Do not assign c before calculation succeeded!
       else
@@ -417,28 +678,29 @@ classdef mpfr_t
       if (isnumeric (a) && isa (b, 'mpfr_t'))
         if (isscalar (a) || isequal (size (a), b.dims))
           if (isempty (prec))
-            prec = max (mpfr_get_prec (b));
+            prec = max (mpfr_get_prec (b.handle));
           end
           cc = mpfr_t (zeros (b.dims), prec);
         else
           error ('mpfr_t:minus', 'Incompatible dimensions of a and b.');
         end
-        ret = mpfr_d_sub (cc, double (a(:)), b, rnd);
+        ret = mpfr_d_sub (cc.handle, double (a(:)), b.handle, rnd);
         c = cc;  % Do not assign c before calculation succeeded!
       elseif (isa (a, 'mpfr_t') && isnumeric (b))
         if (isscalar (b) || isequal (a.dims, size (b)))
           if (isempty (prec))
-            prec = max (mpfr_get_prec (a));
+            prec = max (mpfr_get_prec (a.handle));
           end
           cc = mpfr_t (zeros (a.dims), prec);
         else
           error ('mpfr_t:minus', 'Incompatible dimensions of a and b.');
         end
-        ret = mpfr_sub_d (cc, a, double (b(:)), rnd);
+        ret = mpfr_sub_d (cc.handle, a.handle, double (b(:)), rnd);
         c = cc;  % Do not assign c before calculation succeeded!
       elseif (isa (a, 'mpfr_t') && isa (b, 'mpfr_t'))
         if (isempty (prec))
-          prec = max (max (mpfr_get_prec (a)), max (mpfr_get_prec (b)));
+          prec = max (max (mpfr_get_prec (a.handle)), ...
+                      max (mpfr_get_prec (b.handle)));
         end
         if (isequal (a.dims, b.dims) || isequal (b.dims, [1 1]))
           cc = mpfr_t (zeros (a.dims), prec);
@@ -447,7 +709,7 @@ classdef mpfr_t
         else
           error ('mpfr_t:minus', 'Incompatible dimensions of a and b.');
         end
-        ret = mpfr_sub (cc, a, b, rnd);
+        ret = mpfr_sub (cc.handle, a.handle, b.handle, rnd);
         c = cc;  % Do not assign c before calculation succeeded!
       else
         error ('mpfr_t:minus', 'Invalid operands a and b.');
@@ -485,22 +747,27 @@ classdef mpfr_t
         prec = [];
       end
       if (isnumeric (a))
-        c = times (b, a);
+        c = times (b, a, rnd, prec);
       elseif (isa (a, 'mpfr_t') && isnumeric (b))
+        if (isempty (prec))
+          prec = max (mpfr_get_prec (a.handle));
+        end
         if (isscalar (b) || isequal (a.dims, size (b)))
-          if (isempty (prec))
-            prec = max (mpfr_get_prec (a));
-          end
           cc = mpfr_t (zeros (a.dims), prec);
+          ret = mpfr_mul_d (cc.handle, a.handle, double (b(:)), rnd);
+        elseif (prod (a.dims) == 1)
+          % Product `[1 x 1] * [1 x numel(b)]` without conversion of b.
+          cc = mpfr_t (zeros (size (b)), prec);
+          ret = mex_apa_interface (2006, cc, a, double (b(:)'), rnd, 1);
         else
           error ('mpfr_t:times', 'Incompatible dimensions of a and b.');
         end
-        ret = mpfr_mul_d (cc, a, double (b(:)), rnd);
         cc.warnInexactOperation (ret);
         c = cc;  % Do not assign c before calculation succeeded!
       elseif (isa (a, 'mpfr_t') && isa (b, 'mpfr_t'))
         if (isempty (prec))
-          prec = max (max (mpfr_get_prec (a)), max (mpfr_get_prec (b)));
+          prec = max (max (mpfr_get_prec (a.handle)), ...
+                      max (mpfr_get_prec (b.handle)));
         end
         if (isequal (a.dims, b.dims) || isequal (b.dims, [1 1]))
           cc = mpfr_t (zeros (a.dims), prec);
@@ -509,7 +776,7 @@ classdef mpfr_t
         else
           error ('mpfr_t:times', 'Incompatible dimensions of a and b.');
         end
-        ret = mpfr_mul (cc, a, b, rnd);
+        ret = mpfr_mul (cc.handle, a.handle, b.handle, rnd);
         cc.warnInexactOperation (ret);
         c = cc;  % Do not assign c before calculation succeeded!
       else
@@ -518,7 +785,7 @@ classdef mpfr_t
     end
 
 
-    function c = mtimes (a, b, rnd, prec, strategy)
+    function c = mtimes (a, b, rnd, prec, strategy, cutoff)
       % Matrix multiplication `c = a * b` using rounding mode `rnd`.
       %
       % If at least one input is scalar, then `a * b` is equivalent to
@@ -528,6 +795,22 @@ classdef mpfr_t
       %
       % If no precision `prec` is given for `c` the maximum precision of a and
       % is used b.
+      %
+      % The default `strategy` 8 accumulates each element of `c` by fused
+      % multiply-adds in precision `prec`.  Strategy 7 computes each element
+      % as correctly rounded dot product, independent of the number of
+      % threads.  Strategy 9 gives the same result from exact integer
+      % matrix products, which is faster for moderate exponent ranges.  For
+      % large matrices, it multiplies the integers modulo many word-size
+      % primes (residue number system), strategy 10 always does.
+      %
+      % Strategy 11 uses the Strassen-Winograd recursion, which saves
+      % multiplications for larger errors.  The recursion stops, if a
+      % dimension does not exceed `cutoff` (default: 32).
+      %
+      % If `a` or `b` is a double matrix, it is not converted to mpfr_t and
+      % each element of `c` is a correctly rounded dot product.  The
+      % `strategy` is ignored.
 
       if (nargin < 3)
         rnd = mpfr_get_default_rounding_mode ();
@@ -536,26 +819,52 @@ classdef mpfr_t
         prec = [];
       end
       if (nargin < 5)
-        strategy = 7;
+        strategy = 8;
       end
-
-      % TODO: mpfr_t * double
-      if (~ isa (a, 'mpfr_t'))
-        a = mpfr_t (a, max (mpfr_get_prec (b.idx)));
-      end
-      if (~ isa (b, 'mpfr_t'))
-        b = mpfr_t (b, max (mpfr_get_prec (a.idx)));
+      if (nargin < 6)
+        cutoff = 0;  % Default.
       end
+
       % Test for scalars `a .* b`.
-      if ((isa (a, 'mpfr_t') && (prod (a.dims) == 1)) ...
+      if ((~ isa (a, 'mpfr_t') && isscalar (a)) ...
+          || (~ isa (b, 'mpfr_t') && isscalar (b)) ...
+          || (isa (a, 'mpfr_t') && (prod (a.dims) == 1)) ...
           || (isa (b, 'mpfr_t') && (prod (b.dims) == 1)))
-        c = times (a, b, rnd);
+        c = times (a, b, rnd, prec);
+        return;
+      end
+
+      % A double matrix is multiplied without conversion to mpfr_t, each
+      % element of `c` is correctly rounded.
+      if (~ isa (a, 'mpfr_t') || ~ isa (b, 'mpfr_t'))
+        if (isa (a, 'mpfr_t'))
+          X = a;
+          sizeA = a.dims;
+          sizeB = size (b);
+        else
+          X = b;
+          sizeA = size (a);
+          sizeB = b.dims;
+        end
+        if (sizeA(2) ~= sizeB(1))
+          error ('mpfr_t:mtimes', 'Incompatible dimensions of a and b.');
+        end
+        if (isempty (prec))
+          prec = max (mpfr_get_prec (X.handle));
+        end
+        c = mpfr_t (zeros (sizeA(1), sizeB(2)), prec, rnd);
+        if (isa (a, 'mpfr_t'))
+          ret = mex_apa_interface (2006, c, a, double (b), rnd, sizeA(1));
+        else
+          ret = mex_apa_interface (2007, c, double (a), b, rnd, sizeA(1));
+        end
+        c.warnInexactOperation (ret);
         return;
       end
 
       if (isempty (prec))
-        precA = mpfr_get_prec (a);
-        precB = mpfr_get_prec (b);
+        precA = mpfr_get_prec (a.handle);
+        precB = mpfr_get_prec (b.handle);
         prec = max ([precA(:); precB(:)]);
       end
 
@@ -566,8 +875,8 @@ classdef mpfr_t
       end
 
       c = mpfr_t (zeros (sizeA(1), sizeB(2)), prec, rnd);
-      ret = mex_apa_interface (2001, c.idx, a.idx, b.idx, prec, rnd, ...
-                               sizeA(1), strategy);
+      ret = mex_apa_interface (2001, c, a, b, prec, rnd, ...
+                               sizeA(1), strategy, cutoff);
       c.warnInexactOperation (ret);
     end
 
@@ -589,28 +898,29 @@ classdef mpfr_t
       if (isnumeric (a) && isa (b, 'mpfr_t'))
         if (isscalar (a) || isequal (size (a), b.dims))
           if (isempty (prec))
-            prec = max (mpfr_get_prec (b));
+            prec = max (mpfr_get_prec (b.handle));
           end
           cc = mpfr_t (zeros (b.dims), prec);
         else
           error ('mpfr_t:rdivide', 'Incompatible dimensions of a and b.');
         end
-        ret = mpfr_d_div (cc, double (a(:)), b, rnd);
+        ret = mpfr_d_div (cc.handle, double (a(:)), b.handle, rnd);
         c = cc;  % Do not assign c before calculation succeeded!
       elseif (isa (a, 'mpfr_t') && isnumeric (b))
         if (isscalar (b) || isequal (a.dims, size (b)))
           if (isempty (prec))
-            prec = max (mpfr_get_prec (a));
+            prec = max (mpfr_get_prec (a.handle));
           end
           cc = mpfr_t (zeros (a.dims), prec);
         else
           error ('mpfr_t:rdivide', 'Incompatible dimensions of a and b.');
         end
-        ret = mpfr_div_d (cc, a, double (b(:)), rnd);
+        ret = mpfr_div_d (cc.handle, a.handle, double (b(:)), rnd);
         c = cc;  % Do not assign c before calculation succeeded!
       elseif (isa (a, 'mpfr_t') && isa (b, 'mpfr_t'))
         if (isempty (prec))
-          prec = max (max (mpfr_get_prec (a)), max (mpfr_get_prec (b)));
+          prec = max (max (mpfr_get_prec (a.handle)), ...
+                      max (mpfr_get_prec (b.handle)));
         end
         if (isequal (a.dims, b.dims) || isequal (b.dims, [1 1]))
           cc = mpfr_t (zeros (a.dims), prec);
@@ -619,7 +929,7 @@ classdef mpfr_t
         else
           error ('mpfr_t:rdivide', 'Incompatible dimensions of a and b.');
         end
-        ret = mpfr_div (cc, a, b, rnd);
+        ret = mpfr_div (cc.handle, a.handle, b.handle, rnd);
         c = cc;  % Do not assign c before calculation succeeded!
       else
         error ('mpfr_t:rdivide', 'Invalid operands a and b.');
@@ -691,13 +1001,13 @@ classdef mpfr_t
       x = mpfr_t (b);
 
       if (nargin < 4)
-        prec = max (mpfr_get_prec (A));
+        prec = max (mpfr_get_prec (A.handle));
       end
 
       sizeA = A.dims;
       if (sizeA(1) == sizeA(2))
         % A and x are overwritten after the function call!
-        [ret, INFO] = mex_apa_interface (2003, A.idx, x.idx, prec, rnd);
+        [ret, INFO] = mex_apa_interface (2003, A, x, prec, rnd);
       else
         error ('mpfr_t:mrdivide', ...
           'Only square systems of linear equations are yet supported.');
@@ -728,17 +1038,18 @@ classdef mpfr_t
       if (isa (a, 'mpfr_t') && isnumeric (b))
         if (isscalar (b) || isequal (a.dims, size (b)))
           if (isempty (prec))
-            prec = max (mpfr_get_prec (a));
+            prec = max (mpfr_get_prec (a.handle));
           end
           cc = mpfr_t (zeros (a.dims), prec);
         else
           error ('mpfr_t:power', 'Incompatible dimensions of a and b.');
         end
-        ret = mpfr_pow_si (cc, a, double (b(:)), rnd);
+        ret = mpfr_pow_si (cc.handle, a.handle, double (b(:)), rnd);
         c = cc;  % Do not assign c before calculation succeeded!
       elseif (isa (a, 'mpfr_t') && isa (b, 'mpfr_t'))
         if (isempty (prec))
-          prec = max (max (mpfr_get_prec (a)), max (mpfr_get_prec (b)));
+          prec = max (max (mpfr_get_prec (a.handle)), ...
+                      max (mpfr_get_prec (b.handle)));
         end
         if (isequal (a.dims, b.dims) || isequal (b.dims, [1 1]))
           cc = mpfr_t (zeros (a.dims), prec);
@@ -747,7 +1058,7 @@ classdef mpfr_t
         else
           error ('mpfr_t:power', 'Incompatible dimensions of a and b.');
         end
-        ret = mpfr_pow (cc, a, b, rnd);
+        ret = mpfr_pow (cc.handle, a.handle, b.handle, rnd);
         c = cc;  % Do not assign c before calculation succeeded!
       else
         error ('mpfr_t:power', 'Invalid operands a and b.');
@@ -786,28 +1097,28 @@ classdef mpfr_t
     function c = lt (a, b)
       % Less than `c = (a < b)`.
 
-      c = mpfr_t.call_comparison_op (a, b, @mpfr_less_p);
+      c = mpfr_t.call_comparison_op (a, b, @mpfr_less_p, @lt);
     end
 
 
     function c = gt (a, b)
       % Greater than `a > b`.
 
-      c = mpfr_t.call_comparison_op (a, b, @mpfr_greater_p);
+      c = mpfr_t.call_comparison_op (a, b, @mpfr_greater_p, @gt);
     end
 
 
     function c = le (a, b)
       % Less than or equal to `a <= b`.
 
-      c = mpfr_t.call_comparison_op (a, b, @mpfr_lessequal_p);
+      c = mpfr_t.call_comparison_op (a, b, @mpfr_lessequal_p, @le);
     end
 
 
     function c = ge (a, b)
       % Greater than or equal to `a >= b`.
 
-      c = mpfr_t.call_comparison_op (a, b, @mpfr_greaterequal_p);
+      c = mpfr_t.call_comparison_op (a, b, @mpfr_greaterequal_p, @ge);
     end
 
 
@@ -821,7 +1132,7 @@ classdef mpfr_t
     function c = eq (a, b)
       % Equality `a == b`.
 
-      c = mpfr_t.call_comparison_op (a, b, @mpfr_equal_p);
+      c = mpfr_t.call_comparison_op (a, b, @mpfr_equal_p, @eq);
     end
 
 
@@ -868,9 +1179,9 @@ classdef mpfr_t
       end
 
       % Allocate memory for b.
-      b = mpfr_t (nan (fliplr (a.dims)), max (mpfr_get_prec (a)), rnd);
+      b = mpfr_t (nan (fliplr (a.dims)), max (mpfr_get_prec (a.handle)), rnd);
 
-      ret = mex_apa_interface (2000, b.idx, a.idx, rnd, b.dims(1));
+      ret = mex_apa_interface (2000, b, a, rnd, b.dims(1));
       a.warnInexactOperation (ret);
     end
 
@@ -981,11 +1292,11 @@ classdef mpfr_t
         rnd = mpfr_get_default_rounding_mode ();
       end
       if (nargin < 3)
-        prec = max (mpfr_get_prec (a));
+        prec = max (mpfr_get_prec (a.handle));
       end
 
       bb = mpfr_t (zeros (a.dims), prec);
-      ret = mpfr_sqrt (bb, a, rnd);
+      ret = mpfr_sqrt (bb.handle, a.handle, rnd);
       a.warnInexactOperation (ret);
       b = bb;  % Do not assign b before calculation succeeded!
     end
@@ -1002,11 +1313,11 @@ classdef mpfr_t
         rnd = mpfr_get_default_rounding_mode ();
       end
       if (nargin < 3)
-        prec = max (mpfr_get_prec (a));
+        prec = max (mpfr_get_prec (a.handle));
       end
 
       bb = mpfr_t (zeros (a.dims), prec);
-      ret = mpfr_abs (bb, a, rnd);
+      ret = mpfr_abs (bb.handle, a.handle, rnd);
       a.warnInexactOperation (ret);
       b = bb;  % Do not assign b before calculation succeeded!
     end
@@ -1026,7 +1337,7 @@ classdef mpfr_t
         rnd = mpfr_get_default_rounding_mode ();
       end
       if (nargin < 3)
-        prec = max (mpfr_get_prec (a));
+        prec = max (mpfr_get_prec (a.handle));
       end
 
       N = a.dims(2);
@@ -1034,7 +1345,7 @@ classdef mpfr_t
         N = 1;
       end
       bb = mpfr_t (zeros (1, N), prec);
-      ret = mex_apa_interface (2004, bb.idx, a.idx, rnd);
+      ret = mex_apa_interface (2004, bb, a, rnd);
       a.warnInexactOperation (ret);
       b = bb;  % Do not assign b before calculation succeeded!
     end
@@ -1062,15 +1373,15 @@ classdef mpfr_t
       end
 
       sizeA = A.dims;
-      L = mpfr_t (zeros (sizeA(1), min (sizeA)), prec, rnd);
-      U = mpfr_t (zeros (min (sizeA), sizeA(2)), prec, rnd);
+      [L, U] = mpfr_t.zeros_batch ({[sizeA(1), min(sizeA)], ...
+                                    [min(sizeA), sizeA(2)]}, prec);
 
       % A is overwritten after the function call!
       if (nargout == 2)
-        [ret, INFO] = mex_apa_interface (2002, L.idx, U.idx, A.idx, ...
+        [ret, INFO] = mex_apa_interface (2002, L, U, A, ...
                                          prec, rnd, sizeA(1));
       else
-        [ret, INFO, P] = mex_apa_interface (2002, L.idx, U.idx, A.idx, ...
+        [ret, INFO, P] = mex_apa_interface (2002, L, U, A, ...
                                             prec, rnd, sizeA(1));
         if (strcmp (outputForm, 'matrix'))
           p = P;
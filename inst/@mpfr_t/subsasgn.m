@@ -10,7 +10,8 @@ function obj = subsasgn (obj, s, b, rnd)
     if (nargin < 4)
       rnd = mpfr_get_default_rounding_mode ();
     end
-    obj_numel = obj.idx(2) - obj.idx(1) + 1;
+    obj_idx = obj.idx;  % Resolve handle once.
+    obj_numel = obj_idx(2) - obj_idx(1) + 1;
 
     % Analyze indices.
     if (length (s.subs) == 2)
@@ -95,7 +96,7 @@ function obj = subsasgn (obj, s, b, rnd)
         [ret, strpos] = mpfr_strtofr (obj, b(:), 0, rnd);
         bad_strs = (cellfun (@numel, b(:)) >= strpos);
         if (any (bad_strs))
-          bad_strs = try_eval (obj.idx, b, rnd, bad_strs);
+          bad_strs = try_eval (obj_idx, b, rnd, bad_strs);
         end
         if (any (bad_strs))
           warning ('mpfr_t:bad_conversion', ...
@@ -107,6 +108,9 @@ function obj = subsasgn (obj, s, b, rnd)
     % 1D or 2D index, e.g. `obj(1:end) = b` or `obj(1:end,1:end) = b`.
     else
       ret = zeros (s_dims);
+      if (isa (b, 'mpfr_t'))
+        b_idx = b.idx;
+      end
       k = 1;
       for j = columns  % Iterate over all columns.
         b_col_offset = (k - 1) * b_dims(1);
@@ -114,13 +118,13 @@ function obj = subsasgn (obj, s, b, rnd)
 
         % Avoid nested for-loop if indices are contiguous.
         if (isequal (subs, (subs(1):subs(end))))
-          oidx = obj.idx(1) + [subs(1), subs(end)] - 1 + o_col_offset;
+          oidx = obj_idx(1) + [subs(1), subs(end)] - 1 + o_col_offset;
           ridx = 1:length(subs);
           if (isa (b, 'mpfr_t'))
-            if (diff (b.idx) == 0)  % b is mpfr_t scalar
+            if (diff (b_idx) == 0)  % b is mpfr_t scalar
               op = b;
             else
-              op = b.idx(1) + [1, length(subs)] - 1 + b_col_offset;
+              op = b_idx(1) + [1, length(subs)] - 1 + b_col_offset;
             end
             ret(ridx,k) = mpfr_set (oidx, op, rnd);
           elseif (isnumeric (b))
@@ -148,12 +152,12 @@ function obj = subsasgn (obj, s, b, rnd)
             end
           end
         else
-          oidx = @(i) obj.idx(1) + [i, i] - 1 + o_col_offset;
+          oidx = @(i) obj_idx(1) + [i, i] - 1 + o_col_offset;
           if (isa (b, 'mpfr_t'))
-            if (diff (b.idx) == 0)  % b is mpfr_t scalar
+            if (diff (b_idx) == 0)  % b is mpfr_t scalar
               op = @(i,k) b;
             else
-              op = @(i,k) b.idx(1) + [i, i] - 1 + b_col_offset;
+              op = @(i,k) b_idx(1) + [i, i] - 1 + b_col_offset;
             end
             for i = 1:length (subs)
               ret(i,k) = mpfr_set (oidx(subs(i)), op(i), rnd);
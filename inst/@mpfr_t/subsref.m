@@ -10,7 +10,8 @@ function varargout = subsref (obj, s, rnd)
     if (nargin < 3)
       rnd = mpfr_get_default_rounding_mode ();
     end
-    obj_numel = obj.idx(2) - obj.idx(1) + 1;
+    obj_idx = obj.idx;  % Resolve handle once.
+    obj_numel = obj_idx(2) - obj_idx(1) + 1;
 
     % Analyze indices.
     if (length (s.subs) == 2)
@@ -60,6 +61,7 @@ function varargout = subsref (obj, s, rnd)
     % 1D or 2D index, e.g. `obj(1:end)` or `obj(1:end,1:end)`.
     else
       c = mpfr_t (zeros (length (subs), length (columns)), max (obj.prec));
+      c_idx = c.idx;
       k = 1;
       for j = columns  % Iterate over all columns.
         c_col_offset = (k - 1) * c.dims(1);
@@ -67,13 +69,13 @@ function varargout = subsref (obj, s, rnd)
 
         % Avoid nested for-loop if indices are contiguous.
         if (isequal (subs, (subs(1):subs(end))))
-          cidx =   c.idx(1) + [1,    length(subs)] - 1 + c_col_offset;
-          oidx = obj.idx(1) + [subs(1), subs(end)] - 1 + o_col_offset;
+          cidx =   c_idx(1) + [1,    length(subs)] - 1 + c_col_offset;
+          oidx = obj_idx(1) + [subs(1), subs(end)] - 1 + o_col_offset;
           ret = mpfr_set (cidx, oidx, rnd);
         else
           ret = zeros (length (subs), 1);
-          cidx = @(i)   c.idx(1) + [i, i] - 1 + c_col_offset;
-          oidx = @(i) obj.idx(1) + [i, i] - 1 + o_col_offset;
+          cidx = @(i)   c_idx(1) + [i, i] - 1 + c_col_offset;
+          oidx = @(i) obj_idx(1) + [i, i] - 1 + o_col_offset;
           for i = 1:length (subs)
             ret(i) = mpfr_set (cidx(i), oidx(subs(i)), rnd);
           end
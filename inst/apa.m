@@ -13,8 +13,82 @@ function settings = apa (key, val)
   %  'format.inner_padding' (integer scalar): positive
   %  'format.break_at_col'  (integer scalar): positive
   %
+  % 'limb_arena' (logical scalar):
+  %
+  %   [true]: allocate the significands of new MPFR variables contiguously
+  %           in a memory arena [default]
+  %   false : use the default GMP memory functions (malloc)
+  %
   % Use 'clear apa' to reset to default values.
   %
+  % 'memory' (read-only struct):
+  %
+  %   Statistics of the pool of MPFR variables and the limb arena, e.g.
+  %   live and free MPFR variables, high-water marks, and the significand
+  %   memory by precision `limb_bytes_by_prec = [prec, variables, bytes]`.
+  %   `apa ('memory', 'reset')` resets the allocation counters and the
+  %   high-water marks after reading.
+  %
+  % 'profile' (logical scalar or 'reset'):
+  %
+  %   Count the calls, the failed calls, the wall time, the number of MPFR
+  %   variables, and the precision of each MEX interface command.
+  %   `apa ('profile', true)` enables and `apa ('profile', false)` disables
+  %   profiling [default].  `apa ('profile', 'reset')` resets all counters.
+  %   `apa ('profile')` prints a report sorted by wall time or returns it as
+  %   struct.
+  %
+  % 'trace' (string or false):
+  %
+  %   `apa ('trace', filename)` writes begin and end events of each MEX
+  %   interface command and of the phases of the LU factorization, matrix
+  %   multiplication, and string conversion to `filename` in Chrome
+  %   trace-event JSON format, see https://ui.perfetto.dev/.
+  %   `apa ('trace', false)` closes the trace file [default].  `apa ('trace')`
+  %   returns the current trace file name or ''.
+  %
+  % 'omp_cost_model' (struct, 'tune', or string):
+  %
+  %   Cost model deciding if the elementwise MPFR commands run serially or in
+  %   parallel and about the OpenMP chunk size.  The cost of `N` variables of
+  %   precision `prec` is `N * weight(c) * (prec / 64)^exponent(c)` for the
+  %   cost classes c = 1:5 (cheap, add, mul, elementary, and special
+  %   functions) in units of one 64 bit `mpfr_add`.  Commands run in parallel
+  %   if the cost is at least `threshold`.  Special functions and string
+  %   conversion, whose cost varies by orders of magnitude with the argument,
+  %   are split into `irregular_chunks` chunks per thread (0: static
+  %   schedule), which idle threads take over.  `apa ('omp_cost_model')` returns
+  %   the model as struct, `apa ('omp_cost_model', s)` sets it.
+  %   `apa ('omp_cost_model', 'tune')` calibrates the model on this machine.
+  %   `apa ('omp_cost_model', filename)` loads the model from `filename`, if
+  %   it exists, otherwise the calibrated model is stored there.  Files
+  %   without `irregular_chunks` of older versions get its default 16.
+  %
+  % 'threads' (non-negative integer scalar):
+  %
+  %   Number of OpenMP threads of all parallel regions of the MEX interface,
+  %   [0] is the OpenMP default, e.g. from the environment variable
+  %   OMP_NUM_THREADS.  `apa ('threads')` returns the settings and the
+  %   effective team sizes of a parallel region and of a nested parallel
+  %   region as struct.
+  %
+  % 'nested' (logical scalar):
+  %
+  %   true   : nested parallel regions, e.g. of the matrix multiplication,
+  %            run in parallel
+  %   [false]: nested parallel regions run with one thread, which avoids
+  %            oversubscription of the CPUs [default, unless enabled by the
+  %            environment variables OMP_MAX_ACTIVE_LEVELS or OMP_NESTED]
+  %
+  % 'affinity' (string):
+  %
+  %   ['none']: threads are not pinned to CPUs [default]
+  %   'close' : pin thread `t` to the t-th CPU available to the process
+  %   'spread': distribute the threads evenly over the available CPUs
+  %
+  %   Pinning threads is only supported on Linux.  The interpreter thread,
+  %   which is thread 0 of the team, is never pinned.
+  %
 
   persistent m_settings;
 
@@ -24,6 +98,134 @@ function settings = apa (key, val)
 
   % Update settings which could be altered outside this function.
   m_settings.verbose = mex_apa_interface (9001);
+  m_settings.limb_arena = logical (mex_apa_interface (3002));
+
+  if ((nargin > 0) && ischar (key) && strcmp (key, 'memory'))
+    reset = false;
+    if (nargin == 2)
+      if (~ (ischar (val) && strcmp (val, 'reset')))
+        error ('apa:badInput', 'apa: "memory" can only be reset');
+      end
+      reset = true;
+    end
+    settings = mex_apa_interface (1908, reset);  % mpfr_t.get_pool_stats
+    settings.limb_arena = mex_apa_interface (3003, reset);
+    return;
+  end
+
+  if ((nargin > 0) && ischar (key) && strcmp (key, 'profile'))
+    if (nargin == 1)
+      report = profile_report ();
+      if (nargout > 0)
+        settings = report;
+      else
+        print_profile_report (report);
+      end
+    elseif (ischar (val) && strcmp (val, 'reset'))
+      mex_apa_interface (9005);  % mpfr_t.reset_profile
+    elseif ((islogical (val) || isnumeric (val)) && isscalar (val) ...
+            && any (val == [0, 1]))
+      mex_apa_interface (9002, double (val));  % mpfr_t.set_profile
+    else
+      error ('apa:badInput', ...
+             'apa: "profile" must be true, false, or "reset"');
+    end
+    return;
+  end
+
+  if ((nargin > 0) && ischar (key) && strcmp (key, 'trace'))
+    if (nargin == 1)
+      settings = mex_apa_interface (9008);  % mpfr_t.trace_get_filename
+    elseif (ischar (val) && ~ isempty (val))
+      try
+        mex_apa_interface (9006, val);  % mpfr_t.trace_open
+      catch
+        error ('apa:badInput', 'apa: cannot open trace file "%s"', val);
+      end
+    elseif ((islogical (val) || isnumeric (val)) && isscalar (val) ...
+            && (val == 0))
+      mex_apa_interface (9007);  % mpfr_t.trace_close
+    else
+      error ('apa:badInput', 'apa: "trace" must be a file name or false');
+    end
+    return;
+  end
+
+  if ((nargin > 0) && ischar (key) && strcmp (key, 'omp_cost_model'))
+    if (nargin == 1)
+      settings = omp_model_struct (mex_apa_interface (9010));
+    elseif (ischar (val) && strcmp (val, 'tune'))
+      settings = omp_model_struct (mex_apa_interface (9011));
+    elseif (ischar (val) && ~ isempty (val))
+      if (exist (val, 'file'))
+        fid = fopen (val, 'r');
+        vec = fscanf (fid, '%f');
+        fclose (fid);
+        if (numel (vec) == 12)
+          % Files without `irregular_chunks` get its default 16.
+          vec = [vec(1:2); 16; vec(3:end)];
+        end
+        settings = omp_model_struct (vec);
+        mex_apa_interface (9009, omp_model_vector (settings));
+      else
+        settings = omp_model_struct (mex_apa_interface (9011));
+        fid = fopen (val, 'w');
+        if (fid < 0)
+          error ('apa:badInput', 'apa: cannot write "%s"', val);
+        end
+        fprintf (fid, '%.17g\n', omp_model_vector (settings));
+        fclose (fid);
+      end
+    elseif (isstruct (val))
+      mex_apa_interface (9009, omp_model_vector (val));
+    else
+      error ('apa:badInput', ...
+             'apa: "omp_cost_model" must be a struct, "tune", or a file name');
+    end
+    return;
+  end
+
+  if ((nargin > 0) && ischar (key) ...
+      && any (strcmp (key, {'threads', 'nested', 'affinity'})))
+    policies = {'none', 'close', 'spread'};
+    if (nargin == 1)
+      info = mex_apa_interface (9015);  % mpfr_t.get_threads
+      threads.threads          = info(1);
+      threads.nested           = logical (info(2));
+      threads.affinity         = policies{info(3) + 1};
+      threads.team_size        = info(4);
+      threads.nested_team_size = info(5);
+      threads.num_procs        = info(6);
+      settings = threads.(key);
+      if (strcmp (key, 'threads'))
+        settings = threads;
+      end
+    elseif (strcmp (key, 'threads'))
+      if (~ (isnumeric (val) && isscalar (val) && (val >= 0) ...
+             && (val == fix (val))))
+        error ('apa:badInput', ...
+               'apa: "threads" must be a non-negative integer');
+      end
+      mex_apa_interface (9012, double (val));  % mpfr_t.set_threads
+    elseif (strcmp (key, 'nested'))
+      if (~ ((islogical (val) || isnumeric (val)) && isscalar (val) ...
+             && any (val == [0, 1])))
+        error ('apa:badInput', 'apa: "nested" must be true or false');
+      end
+      mex_apa_interface (9013, double (val));  % mpfr_t.set_nested
+    else
+      if (~ (ischar (val) && any (strcmp (val, policies))))
+        error ('apa:badInput', ...
+               'apa: "affinity" must be "none", "close", or "spread"');
+      end
+      try
+        mex_apa_interface (9014, find (strcmp (val, policies)) - 1);
+      catch
+        error ('apa:badInput', 'apa: cannot set "affinity" to "%s"', val);
+      end
+    end
+    return;
+  end
 
   switch (nargin) 
     case 0  % Get all mode.
@@ -76,6 +278,103 @@ function settings = apa_defaults ()
   settings.format.base = 10;
   settings.format.inner_padding = 3;
   settings.format.break_at_col = 80;
+
+  settings.limb_arena = logical (mex_apa_interface (3002));
+end
+
+
+function report = profile_report ()
+  % Get the profiling counters sorted by descending wall time.
+
+  data = mex_apa_interface (9004);  % mpfr_t.get_profile_report
+  [~, order] = sort (data(:,3), 'descend');
+  data = data(order,:);
+  report.enabled  = logical (mex_apa_interface (9003));  % get_profile
+  report.cmd_code = data(:,1);
+  report.name     = profile_cmd_names (data(:,1));
+  report.calls    = data(:,2);
+  report.seconds  = data(:,3);
+  report.elements = data(:,4);
+  report.bits     = data(:,5);
+  report.max_prec = data(:,6);
+  report.errors   = data(:,7);
+end
+
+
+function names = profile_cmd_names (cmd_codes)
+  % Find the generated m-file function calling each command code.
+
+  names = repmat ({''}, numel (cmd_codes), 1);
+  apa_dir = fileparts (mfilename ('fullpath'));
+  files = dir (fullfile (apa_dir, 'mpfr_*.m'));
+  for i = 1:numel (files)
+    tok = regexp (fileread (fullfile (apa_dir, files(i).name)), ...
+                  'mex_apa_interface \((\d+),', 'tokens', 'once');
+    if (~ isempty (tok))
+      names(cmd_codes == str2double (tok{1})) = {files(i).name(1:end-2)};
+    end
+  end
+end
+
+
+function print_profile_report (report)
+  % Print the profiling report as table.
+
+  if (~ report.enabled)
+    fprintf ('Profiling is disabled, enable with apa (''profile'', true).\n');
+  end
+  total = sum (report.seconds);
+  fprintf ('%6s  %-24s %10s %8s %12s %6s %12s %12s %9s\n', 'code', ...
+           'name', 'calls', 'errors', 'time [ms]', '%', 'us/call', ...
+           'elements', 'mean prec');
+  for i = 1:numel (report.cmd_code)
+    fprintf ('%6d  %-24s %10d %8d %12.3f %6.1f %12.2f %12d %9.0f\n', ...
+             report.cmd_code(i), report.name{i}, report.calls(i), ...
+             report.errors(i), 1e3 * report.seconds(i), ...
+             100 * report.seconds(i) / total, ...
+             1e6 * report.seconds(i) / report.calls(i), ...
+             report.elements(i), ...
+             report.bits(i) / max (1, report.elements(i)));
+  end
+end
+
+
+function s = omp_model_struct (vec)
+  % Convert the vector representation of the OpenMP cost model to a struct.
+
+  if (~ (isnumeric (vec) && (numel (vec) == 13) && all (isfinite (vec)) ...
+         && all (vec >= 0)))
+    error ('apa:badInput', 'apa: invalid "omp_cost_model"');
+  end
+  s.threshold        = vec(1);
+  s.chunk_cost       = vec(2);
+  s.irregular_chunks = vec(3);
+  s.weight           = vec(4:8)';
+  s.exponent         = vec(9:13)';
+end
+
+
+function vec = omp_model_vector (s)
+  % Convert the OpenMP cost model struct to its vector representation.
+
+  fnames = {'threshold', 'chunk_cost', 'irregular_chunks', 'weight', ...
+            'exponent'};
+  if (~ (isstruct (s) && all (isfield (s, fnames)) ...
+         && all (cellfun (@isnumeric, struct2cell (s))) ...
+         && isscalar (s.threshold) && isscalar (s.chunk_cost) ...
+         && isscalar (s.irregular_chunks) ...
+         && (numel (s.weight) == 5) && (numel (s.exponent) == 5)))
+    error ('apa:badInput', ['apa: "omp_cost_model" must have the fields ', ...
+      '"threshold", "chunk_cost", "irregular_chunks", "weight", and ', ...
+      '"exponent"']);
+  end
+  vec = [s.threshold; s.chunk_cost; s.irregular_chunks; s.weight(:); ...
+         s.exponent(:)];
+  try
+    omp_model_struct (vec);
+  catch
+    error ('apa:badInput', 'apa: "omp_cost_model" values must be non-negative');
+  end
 end
 
 
@@ -83,11 +382,11 @@ function bool = validate_apa_struct (s)
   fnames = fieldnames (s);
 
   % Check for missing fields.
-  if (length (fnames) > 2)
+  if (length (fnames) > 3)
     error ('apa:badInput', 'apa: struct has too many fields');
   end
 
-  for f = {'verbose', 'format'}
+  for f = {'verbose', 'format', 'limb_arena'}
     if (~ any (strcmp (fnames, f{1})))
       error ('apa:badInput', 'apa: setting "%s" is missing', f{1});
     end
@@ -129,6 +428,12 @@ function bool = validate_apa_struct (s)
       'positive scalar']);
   end
 
+  fval = s.limb_arena;
+  if (~ ((islogical (fval) || isnumeric (fval)) && isscalar (fval) ...
+         && any (fval == [0, 1])))
+    error ('apa:badInput', 'apa: "limb_arena" must be true or false');
+  end
+
   bool = true;
 end
 
@@ -139,5 +444,6 @@ function bool = apply_apa_struct (s)
   catch
     error ('apa:badInput', 'apa: "verbose" invalid value {0,1,2,3}');
   end
+  mex_apa_interface (3001, double (s.limb_arena));
   bool = true;
 end
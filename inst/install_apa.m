@@ -20,14 +20,19 @@ function install_apa (cmd)
     header = {'gmp.h', 'mpfr.h', 'mpf2mpfr.h'};
     static_libs = {'libmpfr.a', 'libgmp.a'};
     cfiles = {'mex_apa_interface.c', ...
+              'mex_apa_interface_trace.c', ...
+              'mex_apa_interface_threads.c', ...
               'mex_gmp_interface.c', ...
+              'mex_gmp_interface_limb_arena.c', ...
               'mex_mpfr_interface.c', ...
               'mex_mpfr_interface_extractors.c', ...
               'mex_mpfr_interface_memory_managment.c', ...
+              'mex_mpfr_interface_omp.c', ...
               'mex_mpfr_algorithms.c', ...
               'mex_mpfr_algorithms_dot.c', ...
               'mex_mpfr_algorithms_mmm.c', ...
-              'mex_mpfr_algorithms_gauss.c'};
+              'mex_mpfr_algorithms_gauss.c', ...
+              'mex_mpfr_algorithms_expr.c'};
 
     % Set cflags and ldflags according to OS and Octave/Matlab.
     cflags = {'--std=c11', '-Wall', '-Wextra'};
@@ -142,6 +142,18 @@ function generate_m_files ()
       disp ('                 no help text');
     end
 
+    % Pass the uint64 handles of mpfr_t objects, which avoids the slow
+    % property lookup in the MEX interface.
+    for j = 1:length (fcn.in_args)
+      if (~ isempty (regexp (fcn.in_args(j).type, ...
+                             '^(const )?mpfr_(t|ptr|srcptr)$', 'once')))
+        name = fcn.in_args(j).name;
+        fcn_str = [fcn_str, '  if (isa (', name, ', ''mpfr_t''))\n', ...
+                            '    ', name, ' = ', name, '.handle;\n', ...
+                            '  end\n'];
+      end
+    end
+
     % Write mex_apa_interface function call.
     fcn_str = [fcn_str, '  ', fcn_str_ret, 'mex_apa_interface (', ...
                               fcn_str_args2, ');\n'];
@@ -28,6 +28,103 @@
 int VERBOSE = 2;
 
 
+// Profiling counters of the MPFR, algorithm, and GMP commands indexed by
+// `cmd_code`, only updated if `profile_enabled` is non-zero.  Elements and
+// precision are taken from the first MPFR variable argument, e.g. `rop`.
+
+#define PROFILE_NUM_CMD_CODES 4000
+
+typedef struct
+{
+  uint64_t calls;     // Number of calls, including failed calls.
+  uint64_t errors;    // Number of calls failed with an error.
+  double   seconds;   // Total wall time.
+  uint64_t elements;  // Total number of MPFR variables processed.
+  uint64_t bits;      // Total precision (bits) of all processed variables.
+  uint64_t max_prec;  // Maximal precision (bits) of a call.
+} profile_counter_t;
+
+static int               profile_enabled = 0;
+static profile_counter_t profile_counters[PROFILE_NUM_CMD_CODES];
+
+// Profiling counters and trace event of the current command, updated and
+// closed by `mex_apa_command_end`.
+static int               command_trace = 0;
+static char              command_trace_name[32];
+static profile_counter_t *command_profile = NULL;
+static profile_counter_t command_sample;
+static double            command_t_start = 0.0;
+
+
+/**
+ * Reset all profiling counters.
+ */
+static void
+profile_reset (void)
+{
+  memset (profile_counters, 0, sizeof(profile_counters));
+}
+
+
+/**
+ * Get the elements and precision of the first MPFR variable argument of a
+ * command.  Memory management commands (1900 - 1999) and GMP commands do not
+ * process MPFR variables.
+ *
+ * @param[in] nrhs MEX parameter.
+ * @param[in] prhs MEX parameter.
+ * @param[in] cmd_code command code.
+ * @param[out] elements number of MPFR variables.
+ * @param[out] prec precision of the first MPFR variable.
+ */
+static void
+profile_get_elements (int nrhs, const mxArray *prhs[], uint64_t cmd_code,
+                      uint64_t *elements, uint64_t *prec)
+{
+  idx_t idx;
+
+  *elements = 0;
+  *prec     = 0;
+  if (((1000 <= cmd_code) && (cmd_code < 1900))
+      || ((2000 <= cmd_code) && (cmd_code < 3000)))
+    {
+      if (extract_idx (1, nrhs, prhs, &idx))
+        {
+          *elements = length (&idx);
+          *prec     = (uint64_t) mpfr_get_prec (mex_mpfr_ptr (&idx));
+        }
+    }
+}
+
+
+/**
+ * Finish profiling and tracing of the current command.  Called at the end of
+ * each MEX call and by `MEX_FCN_ERR` before raising an error, which leaves
+ * the MEX call.  Subsequent calls have no effect.
+ *
+ * @param failed non-zero, if the command failed with an error.
+ */
+void
+mex_apa_command_end (int failed)
+{
+  if (command_profile != NULL)
+    {
+      profile_counter_t *c = command_profile;
+      c->calls++;
+      c->errors   += (failed != 0);
+      c->seconds  += omp_get_wtime () - command_t_start;
+      c->elements += command_sample.elements;
+      c->bits     += command_sample.bits;
+      if (command_sample.max_prec > c->max_prec)
+        c->max_prec = command_sample.max_prec;
+    }
+  command_profile = NULL;
+  if (command_trace)
+    MEX_TRACE_END (command_trace_name);
+  command_trace = 0;
+}
+
+
 /**
  * Octave/Matlab MEX interface for GMP and MPFR.
  *
@@ -37,6 +134,17 @@ void
 mexFunction (int nlhs, mxArray *plhs[],
              int nrhs, const mxArray *prhs[])
 {
+  // MPFR caches the GMP memory functions on first use.
+  mex_gmp_limb_arena_install ();
+
+  // Apply the thread count and nesting of `apa ('threads')` to all parallel
+  // regions of this call.
+  mex_apa_threads_apply ();
+
+  // Recording elementwise flags ends with the command, which might have
+  // been interrupted by an error.
+  mex_mpfr_flags_out = NULL;
+
   // Read command code.
   uint64_t cmd_code = 0;
 
@@ -47,6 +155,33 @@ mexFunction (int nlhs, mxArray *plhs[],
   DBG_PRINTF ("Command: code = %d, nlhs = %d, nrhs = %d\n", (int) cmd_code,
               nlhs, nrhs);
 
+  // Profile and trace MPFR, algorithm, and GMP commands.
+  int      profile  = profile_enabled && (cmd_code < PROFILE_NUM_CMD_CODES);
+  int      trace    = (mex_apa_trace_file != NULL)
+                      && (cmd_code < PROFILE_NUM_CMD_CODES);
+  uint64_t elements = 0;
+  uint64_t prec     = 0;
+  if (profile || trace)
+    profile_get_elements (nrhs, prhs, cmd_code, &elements, &prec);
+  if (trace)
+    {
+      snprintf (command_trace_name, sizeof(command_trace_name), "cmd %d",
+                (int) cmd_code);
+      command_trace = 1;
+      MEX_TRACE_BEGIN (command_trace_name, "\"cmd_code\": %d, \"nlhs\": %d, "
+                       "\"nrhs\": %d, \"elements\": %lu, \"prec\": %lu",
+                       (int) cmd_code, nlhs, nrhs,
+                       (unsigned long) elements, (unsigned long) prec);
+    }
+  if (profile)
+    {
+      command_sample.elements = elements;
+      command_sample.bits     = elements * prec;
+      command_sample.max_prec = prec;
+      command_profile         = profile_counters + cmd_code;
+      command_t_start         = omp_get_wtime ();
+    }
+
   /**
    * Branch to specialized interface.
    */
@@ -77,8 +212,157 @@ mexFunction (int nlhs, mxArray *plhs[],
       plhs[0] = mxCreateDoubleScalar ((double) VERBOSE);
     }
 
+  else if (cmd_code == 9002)  // void mpfr_t.set_profile (int enabled)
+    {
+      MEX_NARGINCHK (2);
+      uint64_t enabled = 0;
+      if (extract_ui (1, nrhs, prhs, &enabled) && (enabled <= 1))
+        profile_enabled = (int) enabled;
+      else
+        MEX_FCN_ERR ("cmd[%s]: ENABLED must be 0 or 1.\n",
+                     "mpfr_t.set_profile");
+    }
+
+  else if (cmd_code == 9003)  // int mpfr_t.get_profile (void)
+    {
+      MEX_NARGINCHK (1);
+      plhs[0] = mxCreateDoubleScalar ((double) profile_enabled);
+    }
+
+  else if (cmd_code == 9004)  // double[] mpfr_t.get_profile_report (void)
+    {
+      // One row `[cmd_code, calls, seconds, elements, bits, max_prec,
+      // errors]` for each command called since the last reset.
+      MEX_NARGINCHK (1);
+      size_t rows = 0;
+      for (size_t i = 0; i < PROFILE_NUM_CMD_CODES; i++)
+        if (profile_counters[i].calls > 0)
+          rows++;
+      plhs[0] = mxCreateNumericMatrix (rows, 7, mxDOUBLE_CLASS, mxREAL);
+      double *ptr = mxGetPr (plhs[0]);
+      for (size_t i = 0, r = 0; i < PROFILE_NUM_CMD_CODES; i++)
+        {
+          profile_counter_t *c = profile_counters + i;
+          if (c->calls == 0)
+            continue;
+          ptr[r]            = (double) i;
+          ptr[r + rows]     = (double) c->calls;
+          ptr[r + 2 * rows] = c->seconds;
+          ptr[r + 3 * rows] = (double) c->elements;
+          ptr[r + 4 * rows] = (double) c->bits;
+          ptr[r + 5 * rows] = (double) c->max_prec;
+          ptr[r + 6 * rows] = (double) c->errors;
+          r++;
+        }
+    }
+
+  else if (cmd_code == 9005)  // void mpfr_t.reset_profile (void)
+    {
+      MEX_NARGINCHK (1);
+      profile_reset ();
+    }
+
+  else if (cmd_code == 9006)  // void mpfr_t.trace_open (char *filename)
+    {
+      MEX_NARGINCHK (2);
+      char *filename = mxIsChar (prhs[1]) ? mxArrayToString (prhs[1]) : NULL;
+      int   success  = (filename != NULL) && mex_apa_trace_open (filename);
+      if (filename != NULL)
+        mxFree (filename);
+      if (! success)
+        MEX_FCN_ERR ("cmd[%s]: Cannot open trace file.\n",
+                     "mpfr_t.trace_open");
+    }
+
+  else if (cmd_code == 9007)  // void mpfr_t.trace_close (void)
+    {
+      MEX_NARGINCHK (1);
+      mex_apa_trace_close ();
+    }
+
+  else if (cmd_code == 9008)  // char * mpfr_t.trace_get_filename (void)
+    {
+      MEX_NARGINCHK (1);
+      plhs[0] = mxCreateString (mex_apa_trace_get_filename ());
+    }
+
+  else if (cmd_code == 9009)  // void mpfr_t.set_omp_cost_model (double[] model)
+    {
+      // See `mex_mpfr_omp_model_from_vector` for the vector representation.
+      MEX_NARGINCHK (2);
+      if (! mxIsDouble (prhs[1]) || (mxGetNumberOfElements (prhs[1])
+                                     != MEX_MPFR_OMP_MODEL_LENGTH)
+          || ! mex_mpfr_omp_model_from_vector (mxGetPr (prhs[1]),
+                                               &mex_mpfr_omp_model))
+        MEX_FCN_ERR ("cmd[%s]: MODEL must be a vector of %d non-negative "
+                     "numbers.\n", "mpfr_t.set_omp_cost_model",
+                     MEX_MPFR_OMP_MODEL_LENGTH);
+    }
+
+  else if (cmd_code == 9010)  // double[] mpfr_t.get_omp_cost_model (void)
+    {
+      MEX_NARGINCHK (1);
+      plhs[0] = mxCreateNumericMatrix (MEX_MPFR_OMP_MODEL_LENGTH, 1,
+                                       mxDOUBLE_CLASS, mxREAL);
+      mex_mpfr_omp_model_to_vector (&mex_mpfr_omp_model, mxGetPr (plhs[0]));
+    }
+
+  else if (cmd_code == 9011)  // double[] mpfr_t.tune_omp_cost_model (void)
+    {
+      MEX_NARGINCHK (1);
+      mex_mpfr_omp_model = mex_mpfr_omp_tune ();
+      plhs[0] = mxCreateNumericMatrix (MEX_MPFR_OMP_MODEL_LENGTH, 1,
+                                       mxDOUBLE_CLASS, mxREAL);
+      mex_mpfr_omp_model_to_vector (&mex_mpfr_omp_model, mxGetPr (plhs[0]));
+    }
+
+  else if (cmd_code == 9012)  // void mpfr_t.set_threads (int threads)
+    {
+      MEX_NARGINCHK (2);
+      uint64_t threads = 0;
+      if (extract_ui (1, nrhs, prhs, &threads) && (threads <= 4096))
+        mex_apa_threads_set ((int) threads);
+      else
+        MEX_FCN_ERR ("cmd[%s]: THREADS must be an integer between 0 and "
+                     "4096.\n", "mpfr_t.set_threads");
+    }
+
+  else if (cmd_code == 9013)  // void mpfr_t.set_nested (int nested)
+    {
+      MEX_NARGINCHK (2);
+      uint64_t nested = 0;
+      if (extract_ui (1, nrhs, prhs, &nested) && (nested <= 1))
+        mex_apa_threads_set_nested ((int) nested);
+      else
+        MEX_FCN_ERR ("cmd[%s]: NESTED must be 0 or 1.\n",
+                     "mpfr_t.set_nested");
+    }
+
+  else if (cmd_code == 9014)  // void mpfr_t.set_affinity (int policy)
+    {
+      MEX_NARGINCHK (2);
+      uint64_t policy = 0;
+      if (! extract_ui (1, nrhs, prhs, &policy)
+          || (policy > MEX_APA_AFFINITY_SPREAD))
+        MEX_FCN_ERR ("cmd[%s]: POLICY must be 0, 1, or 2.\n",
+                     "mpfr_t.set_affinity");
+      if (! mex_apa_threads_set_affinity ((int) policy))
+        MEX_FCN_ERR ("cmd[%s]: Cannot set thread affinity.\n",
+                     "mpfr_t.set_affinity");
+    }
+
+  else if (cmd_code == 9015)  // double[] mpfr_t.get_threads (void)
+    {
+      // `[threads, nested, affinity, team_size, nested_team_size, num_procs]`
+      MEX_NARGINCHK (1);
+      plhs[0] = mxCreateNumericMatrix (6, 1, mxDOUBLE_CLASS, mxREAL);
+      mex_apa_threads_get (mxGetPr (plhs[0]));
+    }
+
   else
     MEX_FCN_ERR ("Unknown command code '%d'\n", cmd_code);
+
+  mex_apa_command_end (0);
 }
 
 
@@ -181,8 +465,15 @@ extract_ui_vector (int idx, int nrhs, const mxArray *prhs[], uint64_t **ui,
   if ((nrhs > idx) && mxIsNumeric (prhs[idx])
       && ((mxGetM (prhs[idx]) * mxGetN (prhs[idx]) >= len)))
     {
-      double *vec = mxGetPr (prhs[idx]);
       *ui = (uint64_t *) mxMalloc (len * sizeof(uint64_t));
+      if (mxIsUint64 (prhs[idx]))  // e.g. handles of mpfr_t objects
+        {
+          const uint64_t *vec = (const uint64_t *) mxGetData (prhs[idx]);
+          for (size_t i = 0; i < len; i++)
+            (*ui)[i] = vec[i];
+          return (1);
+        }
+      double *vec = mxGetPr (prhs[idx]);
       int good = 1;
       for (size_t i = 0; i < len; i++)
         {
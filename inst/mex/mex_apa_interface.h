@@ -21,6 +21,7 @@
 
 #include <math.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <string.h>
 
 #include <omp.h>
@@ -40,15 +41,30 @@ extern int VERBOSE;
 
 
 // Macro to immediately return from current function.
-// Depending on `VERBOSE` variable an error message is printed.
+// Depending on `VERBOSE` variable an error message is printed.  The error
+// leaves the MEX call, thus the current command is finished before.
 
 #define MEX_FCN_ERR(fmt, ...)                                   \
-  { if (VERBOSE > 0)                                            \
+  { mex_apa_command_end (1);                                    \
+    if (VERBOSE > 0)                                            \
       mexErrMsgIdAndTxt ("apa:mexFunction",                     \
                          "%s:%d:%s():" fmt, __FILE__, __LINE__, \
                          __func__, __VA_ARGS__);                \
     return; }
 
+// Macros to write begin and end events of a named phase to the trace file,
+// if tracing is enabled.  The optional arguments are a printf format and
+// values of the JSON event arguments, e.g.
+// `MEX_TRACE_BEGIN ("phase", "\"k\": %d", k)` or
+// `MEX_TRACE_BEGIN ("phase", NULL)`.
+#define MEX_TRACE_BEGIN(name, ...)                       \
+  { if (mex_apa_trace_file != NULL)                      \
+      mex_apa_trace_event ('B', (name), __VA_ARGS__); }
+
+#define MEX_TRACE_END(name)                       \
+  { if (mex_apa_trace_file != NULL)               \
+      mex_apa_trace_event ('E', (name), NULL); }
+
 // Macro to print very verbose debug output, depends on `VERBOSE` variable.
 #define DBG_PRINTF(fmt, ...)                                \
   { if (VERBOSE > 2)                                        \
@@ -89,6 +105,17 @@ length (idx_t *idx)
 }
 
 
+/**
+ * Finish profiling and tracing of the current command.  Called at the end of
+ * each MEX call and by `MEX_FCN_ERR` before raising an error, which leaves
+ * the MEX call.  Subsequent calls have no effect.
+ *
+ * @param failed non-zero, if the command failed with an error.
+ */
+void
+mex_apa_command_end (int failed);
+
+
 /**
  * Safely read numeric double scalar from MEX input.
  *
@@ -154,5 +181,111 @@ int
 extract_ui_vector (int idx, int nrhs, const mxArray *prhs[], uint64_t **ui,
                    size_t len);
 
+
+// Chrome trace-event output, see "mex_apa_interface_trace.c".
+
+extern FILE *mex_apa_trace_file;
+
+
+/**
+ * Start tracing to a new file.  An open trace file is closed before.
+ *
+ * @param filename path of the trace file, existing files are overwritten.
+ *
+ * @returns `1` on success, otherwise `0`.
+ */
+int
+mex_apa_trace_open (const char *filename);
+
+
+/**
+ * Stop tracing and close the trace file.  No effect if tracing is disabled.
+ */
+void
+mex_apa_trace_close (void);
+
+
+/**
+ * Get the name of the current trace file.
+ *
+ * @returns trace file name, or the empty string if tracing is disabled.
+ */
+const char *
+mex_apa_trace_get_filename (void);
+
+
+/**
+ * Append an event to the trace file.  Thread-safe, the OpenMP thread number
+ * is used as thread id.
+ *
+ * @param phase event type, 'B' (begin) or 'E' (end).
+ * @param name event name.
+ * @param args_fmt NULL or printf format of the JSON object members of the
+ *                 event arguments, e.g. `"\"k\": %d"`.
+ */
+void
+mex_apa_trace_event (char phase, const char *name, const char *args_fmt, ...);
+
+// OpenMP team settings, see "mex_apa_interface_threads.c".
+
+#define MEX_APA_AFFINITY_NONE   0  // Threads are not pinned.
+#define MEX_APA_AFFINITY_CLOSE  1  // Pin threads to consecutive CPUs.
+#define MEX_APA_AFFINITY_SPREAD 2  // Distribute threads over all CPUs.
+
+
+/**
+ * Apply the OpenMP team settings to the calling thread.  Called at the start
+ * of each MEX call.
+ */
+void
+mex_apa_threads_apply (void);
+
+
+/**
+ * Set the size of the OpenMP teams.
+ *
+ * @param threads team size, `0` for the OpenMP default.
+ */
+void
+mex_apa_threads_set (int threads);
+
+
+/**
+ * Allow or forbid nested OpenMP parallel regions.  If forbidden, inner
+ * parallel regions, e.g. in `mpfr_apa_mmm`, run with one thread.  Until
+ * called, the OpenMP default of the environment is kept, e.g. from
+ * OMP_MAX_ACTIVE_LEVELS, which usually forbids nesting.
+ *
+ * @param nested non-zero to allow nested parallel regions.
+ */
+void
+mex_apa_threads_set_nested (int nested);
+
+
+/**
+ * Set the thread affinity policy of the OpenMP team.
+ *
+ * @param policy one of `MEX_APA_AFFINITY_NONE`, `MEX_APA_AFFINITY_CLOSE`, or
+ *               `MEX_APA_AFFINITY_SPREAD`.
+ *
+ * @returns `1` on success, otherwise `0`, e.g. pinning threads is only
+ *          supported on Linux.
+ */
+int
+mex_apa_threads_set_affinity (int policy);
+
+
+/**
+ * Get the OpenMP team settings and the effective team sizes.
+ *
+ * @param[out] info vector of length 6 `[threads, nested, affinity,
+ *                  team_size, nested_team_size, num_procs]`, where
+ *                  `threads` is 0 for the OpenMP default and
+ *                  `nested_team_size` is the team size of a parallel region
+ *                  inside a parallel region.
+ */
+void
+mex_apa_threads_get (double *info);
+
 #endif  // MEX_APA_INTERFACE_H_
 
@@ -0,0 +1,215 @@
+/*
+ * This file is part of APA.
+ *
+ *  APA is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  APA is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with APA.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if defined(__linux__)
+# define _GNU_SOURCE  // pthread_setaffinity_np, CPU_SET
+# include <pthread.h>
+# include <sched.h>
+#endif
+
+#include "mex_apa_interface.h"
+
+// OpenMP team settings of all parallel regions of the MEX interface.  The
+// OpenMP internal control variables belong to the calling thread, thus they
+// are applied at the start of each MEX call by `mex_apa_threads_apply`, in
+// case another MEX file or the interpreter changed them.
+
+static int threads_default  = 0;  // `omp_get_max_threads` at first use.
+static int threads_num      = 0;  // Requested team size, 0 for default.
+static int threads_nested   = -1; // Allow nested parallel regions, -1 for
+                                  // the OpenMP default.
+static int threads_affinity = MEX_APA_AFFINITY_NONE;
+
+#if defined(__linux__)
+static cpu_set_t threads_initial_mask;  // Process affinity at first use.
+#endif
+
+
+/**
+ * Remember the OpenMP and affinity defaults on first use.
+ */
+static void
+threads_init (void)
+{
+  if (threads_default > 0)
+    return;
+  threads_default = omp_get_max_threads ();
+#if defined(__linux__)
+  if (sched_getaffinity (0, sizeof(cpu_set_t), &threads_initial_mask) != 0)
+    {
+      CPU_ZERO (&threads_initial_mask);
+      for (int i = 0; i < omp_get_num_procs (); i++)
+        CPU_SET (i, &threads_initial_mask);
+    }
+#endif
+}
+
+
+/**
+ * Apply the OpenMP team settings to the calling thread.  Called at the start
+ * of each MEX call.
+ */
+void
+mex_apa_threads_apply (void)
+{
+  threads_init ();
+  omp_set_num_threads ((threads_num > 0) ? threads_num : threads_default);
+  // Keep the setting of the environment, e.g. OMP_MAX_ACTIVE_LEVELS, unless
+  // set explicitly by `mex_apa_threads_set_nested`.
+  if (threads_nested >= 0)
+    omp_set_max_active_levels (threads_nested ? 2 : 1);
+}
+
+
+/**
+ * Pin the worker threads of the top-level OpenMP team according to the
+ * affinity policy.  The primary thread is the interpreter thread, it is never
+ * pinned, as it and all threads created by it later would be restricted to a
+ * single CPU after the MEX call.
+ *
+ * @param policy `MEX_APA_AFFINITY_NONE` restores the initial affinity of the
+ *               process.  `MEX_APA_AFFINITY_CLOSE` pins thread `t` to the
+ *               t-th allowed CPU, `MEX_APA_AFFINITY_SPREAD` distributes the
+ *               threads evenly over the allowed CPUs.
+ *
+ * @returns `1` on success, otherwise `0`.
+ */
+static int
+threads_pin (int policy)
+{
+#if defined(__linux__)
+  int cpus[CPU_SETSIZE];
+  int num_cpus = 0;
+  for (int i = 0; i < CPU_SETSIZE; i++)
+    if (CPU_ISSET (i, &threads_initial_mask))
+      cpus[num_cpus++] = i;
+  if (num_cpus == 0)
+    return (0);
+
+  int failed = 0;
+  #pragma omp parallel reduction (|:failed)
+  {
+    int       t = omp_get_thread_num ();
+    int       n = omp_get_num_threads ();
+    cpu_set_t set;
+    CPU_ZERO (&set);
+    if (policy == MEX_APA_AFFINITY_CLOSE)
+      CPU_SET (cpus[t % num_cpus], &set);
+    else if (policy == MEX_APA_AFFINITY_SPREAD)
+      CPU_SET (cpus[((size_t) t * num_cpus / n) % num_cpus], &set);
+    else
+      set = threads_initial_mask;
+    if (t > 0)
+      failed |= (pthread_setaffinity_np (pthread_self (), sizeof(cpu_set_t),
+                                         &set) != 0);
+  }
+  return (! failed);
+#else
+  return (policy == MEX_APA_AFFINITY_NONE);
+#endif
+}
+
+
+/**
+ * Set the size of the OpenMP teams.
+ *
+ * @param threads team size, `0` for the OpenMP default.
+ */
+void
+mex_apa_threads_set (int threads)
+{
+  threads_num = threads;
+  mex_apa_threads_apply ();
+
+  // New threads of the team must be pinned, too.
+  if (threads_affinity != MEX_APA_AFFINITY_NONE)
+    threads_pin (threads_affinity);
+}
+
+
+/**
+ * Allow or forbid nested OpenMP parallel regions.  If forbidden, inner
+ * parallel regions, e.g. in `mpfr_apa_mmm`, run with one thread.  Until
+ * called, the OpenMP default of the environment is kept, e.g. from
+ * OMP_MAX_ACTIVE_LEVELS, which usually forbids nesting.
+ *
+ * @param nested non-zero to allow nested parallel regions.
+ */
+void
+mex_apa_threads_set_nested (int nested)
+{
+  threads_nested = (nested != 0);
+  mex_apa_threads_apply ();
+}
+
+
+/**
+ * Set the thread affinity policy of the OpenMP team.
+ *
+ * @param policy one of `MEX_APA_AFFINITY_NONE`, `MEX_APA_AFFINITY_CLOSE`, or
+ *               `MEX_APA_AFFINITY_SPREAD`.
+ *
+ * @returns `1` on success, otherwise `0`, e.g. pinning threads is only
+ *          supported on Linux.
+ */
+int
+mex_apa_threads_set_affinity (int policy)
+{
+  mex_apa_threads_apply ();
+  if (! threads_pin (policy))
+    return (0);
+  threads_affinity = policy;
+  return (1);
+}
+
+
+/**
+ * Get the OpenMP team settings and the effective team sizes.
+ *
+ * @param[out] info vector of length 6 `[threads, nested, affinity,
+ *                  team_size, nested_team_size, num_procs]`, where
+ *                  `threads` is 0 for the OpenMP default and
+ *                  `nested_team_size` is the team size of a parallel region
+ *                  inside a parallel region.
+ */
+void
+mex_apa_threads_get (double *info)
+{
+  int team_size        = 1;
+  int nested_team_size = 1;
+
+  mex_apa_threads_apply ();
+  #pragma omp parallel
+  {
+    if (omp_get_thread_num () == 0)
+      {
+        team_size = omp_get_num_threads ();
+        #pragma omp parallel
+        {
+          if (omp_get_thread_num () == 0)
+            nested_team_size = omp_get_num_threads ();
+        }
+      }
+  }
+
+  info[0] = (double) threads_num;
+  info[1] = (double) (omp_get_max_active_levels () > 1);
+  info[2] = (double) threads_affinity;
+  info[3] = (double) team_size;
+  info[4] = (double) nested_team_size;
+  info[5] = (double) omp_get_num_procs ();
+}
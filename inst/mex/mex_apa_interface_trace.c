@@ -0,0 +1,122 @@
+/*
+ * This file is part of APA.
+ *
+ *  APA is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  APA is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with APA.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdarg.h>
+
+#include "mex_apa_interface.h"
+
+// Trace file in Chrome trace-event JSON format, NULL if tracing is disabled.
+// The file is a JSON array of events
+//
+//   {"name": "...", "ph": "B", "ts": 12.3, "pid": 1, "tid": 0, "args": {...}}
+//
+// which can be opened with "chrome://tracing" or https://ui.perfetto.dev/.
+
+FILE *mex_apa_trace_file = NULL;
+
+static char   trace_filename[1024];
+static double trace_t0     = 0.0;  // Time of `mex_apa_trace_open`.
+static int    trace_events = 0;    // Number of events written.
+
+
+/**
+ * Start tracing to a new file.  An open trace file is closed before.
+ *
+ * @param filename path of the trace file, existing files are overwritten.
+ *
+ * @returns `1` on success, otherwise `0`.
+ */
+int
+mex_apa_trace_open (const char *filename)
+{
+  mex_apa_trace_close ();
+  if (strlen (filename) >= sizeof(trace_filename))
+    return (0);
+  mex_apa_trace_file = fopen (filename, "w");
+  if (mex_apa_trace_file == NULL)
+    return (0);
+  strcpy (trace_filename, filename);
+  fputs ("[", mex_apa_trace_file);
+  trace_t0     = omp_get_wtime ();
+  trace_events = 0;
+  return (1);
+}
+
+
+/**
+ * Stop tracing and close the trace file.  No effect if tracing is disabled.
+ */
+void
+mex_apa_trace_close (void)
+{
+  if (mex_apa_trace_file == NULL)
+    return;
+  fputs ("\n]\n", mex_apa_trace_file);
+  fclose (mex_apa_trace_file);
+  mex_apa_trace_file = NULL;
+  trace_filename[0]  = '\0';
+}
+
+
+/**
+ * Get the name of the current trace file.
+ *
+ * @returns trace file name, or the empty string if tracing is disabled.
+ */
+const char *
+mex_apa_trace_get_filename (void)
+{
+  return ((mex_apa_trace_file == NULL) ? "" : trace_filename);
+}
+
+
+/**
+ * Append an event to the trace file.  Thread-safe, the OpenMP thread number
+ * is used as thread id.  Use the macros `MEX_TRACE_BEGIN` and
+ * `MEX_TRACE_END`, which check if tracing is enabled.
+ *
+ * @param phase event type, 'B' (begin) or 'E' (end).
+ * @param name event name.
+ * @param args_fmt NULL or printf format of the JSON object members of the
+ *                 event arguments, e.g. `"\"k\": %d"`.
+ */
+void
+mex_apa_trace_event (char phase, const char *name, const char *args_fmt, ...)
+{
+  double ts  = 1e6 * (omp_get_wtime () - trace_t0);
+  int    tid = omp_get_thread_num ();
+
+  #pragma omp critical (mex_apa_trace)
+  {
+    if (mex_apa_trace_file != NULL)
+      {
+        fprintf (mex_apa_trace_file, "%s\n{\"name\": \"%s\", \"ph\": \"%c\", "
+                 "\"ts\": %.3f, \"pid\": 1, \"tid\": %d",
+                 (trace_events++ > 0) ? "," : "", name, phase, ts, tid);
+        if (args_fmt != NULL)
+          {
+            va_list args;
+            va_start (args, args_fmt);
+            fputs (", \"args\": {", mex_apa_trace_file);
+            vfprintf (mex_apa_trace_file, args_fmt, args);
+            fputs ("}", mex_apa_trace_file);
+            va_end (args);
+          }
+        fputs ("}", mex_apa_trace_file);
+      }
+  }
+}
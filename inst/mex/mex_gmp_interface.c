@@ -50,6 +50,47 @@ mex_gmp_interface (int nlhs, mxArray *plhs[],
         return;
       }
 
+      case 3001:  // void gmp_limb_arena_set_enabled (int enabled)
+      {
+        MEX_NARGINCHK (2);
+        int64_t enabled = 1;
+        if (! extract_si (1, nrhs, prhs, &enabled))
+          MEX_FCN_ERR ("cmd[%s]: ENABLED must be a numeric scalar.\n",
+                       "gmp_limb_arena_set_enabled");
+        mex_gmp_limb_arena_set_enabled (enabled != 0);
+        return;
+      }
+
+      case 3002:  // int gmp_limb_arena_get_enabled (void)
+      {
+        MEX_NARGINCHK (1);
+        plhs[0] = mxCreateDoubleScalar (
+          (double) mex_gmp_limb_arena_get_enabled ());
+        return;
+      }
+
+      case 3003:  // struct gmp_limb_arena_get_stats (int reset)
+      {
+        if ((nrhs < 1) || (nrhs > 2))
+          MEX_FCN_ERR ("cmd[%d]: Invalid number of arguments.\n", cmd_code);
+        int64_t reset = 0;
+        if ((nrhs == 2) && ! extract_si (1, nrhs, prhs, &reset))
+          MEX_FCN_ERR ("cmd[%s]: RESET must be a numeric scalar.\n",
+                       "gmp_limb_arena_get_stats");
+        gmp_limb_arena_stats_t stats = mex_gmp_limb_arena_get_stats (
+          reset != 0);
+        const char *fnames[] = {"hits", "misses", "frees", "chunks",
+                                "reserved_bytes", "used_bytes"};
+        double      fvals[]  = {(double) stats.hits, (double) stats.misses,
+                                (double) stats.frees, (double) stats.chunks,
+                                (double) stats.reserved_bytes,
+                                (double) stats.used_bytes};
+        plhs[0] = mxCreateStructMatrix (1, 1, 6, fnames);
+        for (int i = 0; i < 6; i++)
+          mxSetFieldByNumber (plhs[0], 0, i, mxCreateDoubleScalar (fvals[i]));
+        return;
+      }
+
       default:
         MEX_FCN_ERR ("Unknown command code '%d'\n", cmd_code);
     }
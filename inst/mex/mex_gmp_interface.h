@@ -36,5 +36,107 @@ mex_gmp_interface (int nlhs, mxArray *plhs[],
                    int nrhs, const mxArray *prhs[],
                    uint64_t cmd_code);
 
+
+// GMP limb arena, see "mex_gmp_interface_limb_arena.c".
+
+typedef struct
+{
+  uint64_t hits;            // Arena allocations served by the arena.
+  uint64_t misses;          // Arena allocations served by the default.
+  uint64_t frees;           // Blocks returned to the arena.
+  uint64_t chunks;          // Number of chunks.
+  uint64_t reserved_bytes;  // Bytes of all chunks.
+  uint64_t used_bytes;      // Bytes of blocks in use.
+} gmp_limb_arena_stats_t;
+
+
+/**
+ * Replace the GMP memory functions by the limb arena.
+ *
+ * Must be called before the first use of GMP or MPFR.  Subsequent calls have
+ * no effect.
+ */
+void
+mex_gmp_limb_arena_install (void);
+
+
+/**
+ * Restore the default GMP memory functions replaced by
+ * `mex_gmp_limb_arena_install`.
+ *
+ * All blocks owned by the arena must have been freed before, e.g. by
+ * `mex_gmp_limb_arena_release`.  MPFR forgets the cached memory functions of
+ * all threads of the OpenMP team.  No effect if not installed.
+ */
+void
+mex_gmp_limb_arena_uninstall (void);
+
+
+/**
+ * Open a scope, in which GMP allocations are served by the limb arena.
+ *
+ * Must not be called from within an OpenMP parallel region.
+ */
+void
+mex_gmp_limb_arena_begin (void);
+
+
+/**
+ * Close a scope opened by `mex_gmp_limb_arena_begin`.
+ */
+void
+mex_gmp_limb_arena_end (void);
+
+
+/**
+ * Free all chunks of the limb arena.
+ *
+ * All blocks owned by the arena must have been freed before.  The GMP memory
+ * functions remain installed until `mex_gmp_limb_arena_uninstall`.
+ */
+void
+mex_gmp_limb_arena_release (void);
+
+
+/**
+ * Return empty chunks of the limb arena to the system.
+ *
+ * Must not be called from within an OpenMP parallel region.
+ *
+ * @returns number of bytes returned.
+ */
+size_t
+mex_gmp_limb_arena_trim (void);
+
+
+/**
+ * Enable or disable the limb arena for future allocations.
+ *
+ * @param enabled `0` to use the default GMP memory functions.
+ */
+void
+mex_gmp_limb_arena_set_enabled (int enabled);
+
+
+/**
+ * Check if the limb arena is enabled.
+ *
+ * @returns `1` if the limb arena is enabled, otherwise `0`.
+ */
+int
+mex_gmp_limb_arena_get_enabled (void);
+
+
+/**
+ * Get the limb arena statistics.
+ *
+ * @param reset if non-zero, reset the counters `hits`, `misses`, and `frees`
+ *              after reading.
+ *
+ * @returns current limb arena statistics.
+ */
+gmp_limb_arena_stats_t
+mex_gmp_limb_arena_get_stats (int reset);
+
 #endif  // MEX_GMP_INTERFACE_H_
 
@@ -0,0 +1,497 @@
+/*
+ * This file is part of APA.
+ *
+ *  APA is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  APA is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with APA.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mex_gmp_interface.h"
+#include "mpfr.h"
+
+// GMP limb arena
+// ==============
+//
+// The significands (limbs) of MPFR variables are allocated by GMP's memory
+// functions.  Using the system `malloc`, the limbs of neighboring MPFR
+// variables are scattered across the heap.
+//
+// The limb arena serves allocations of equal size from contiguous slabs
+// ("chunks").  Each block size, a multiple of `LIMB_ARENA_ALIGN` bytes, has
+// its own chunks.  Consecutive allocations of a block size are placed
+// consecutively in memory, freed blocks are reused first.
+//
+// The arena only serves allocations while a scope opened by
+// `mex_gmp_limb_arena_begin` is active.  The MPFR memory management opens a
+// scope to initialize new MPFR variables, all other allocations (for example
+// temporary variables of MPFR functions) use the default GMP memory
+// functions.  Thus the limbs of a MPFR matrix allocated at once are stored
+// in column order.
+//
+// GMP's memory functions are replaced before the first use of MPFR, as MPFR
+// caches them in each thread.  Blocks not owned by the arena are passed to
+// the default functions.  If the arena is disabled, all allocations use the
+// default functions, existing blocks remain valid.
+//
+// Each chunk counts its blocks in use.  Empty chunks are returned to the
+// system by `mex_gmp_limb_arena_trim`, e.g. after compacting the MPFR
+// variables.
+
+#define LIMB_ARENA_ALIGN       8
+#define LIMB_ARENA_BLOCK_MAX   4096      // Larger blocks use the default.
+#define LIMB_ARENA_CHUNK_SIZE  (1 << 18) // Bytes of a chunk.
+#define LIMB_ARENA_CLASSES     (LIMB_ARENA_BLOCK_MAX / LIMB_ARENA_ALIGN + 1)
+
+typedef struct
+{
+  void *free_list;  // Freed blocks, linked by their first bytes.
+  char *top;        // Unused part of the most recent chunk.
+  char *end;
+} limb_arena_class_t;
+
+typedef struct
+{
+  char  *begin;
+  char  *end;
+  size_t live;  // Number of blocks in use.
+} limb_arena_chunk_t;
+
+static limb_arena_class_t  limb_arena_classes[LIMB_ARENA_CLASSES];
+static limb_arena_chunk_t *limb_arena_chunks          = NULL;
+static size_t              limb_arena_chunks_capacity = 0;
+static size_t              limb_arena_chunks_size     = 0;
+
+static int limb_arena_installed = 0;
+static int limb_arena_enabled   = 1;
+static int limb_arena_scope     = 0;
+
+static gmp_limb_arena_stats_t limb_arena_stats;
+
+// Default GMP memory functions.
+static void *(*limb_arena_default_alloc) (size_t);
+static void *(*limb_arena_default_realloc) (void *, size_t, size_t);
+static void (*limb_arena_default_free) (void *, size_t);
+
+
+/**
+ * Get the size class of a block.
+ *
+ * @param size block size in bytes, `0 < size <= LIMB_ARENA_BLOCK_MAX`.
+ *
+ * @returns size class, the block size is `class * LIMB_ARENA_ALIGN`.
+ */
+static inline size_t
+limb_arena_class_of (size_t size)
+{
+  return ((size + LIMB_ARENA_ALIGN - 1) / LIMB_ARENA_ALIGN);
+}
+
+
+/**
+ * Find the chunk of a block.
+ *
+ * @param ptr pointer to a block.
+ *
+ * @returns chunk containing `ptr`, or `NULL` if the block is not owned by
+ *          the arena.
+ */
+static limb_arena_chunk_t *
+limb_arena_chunk_of (void *ptr)
+{
+  char  *p  = (char *) ptr;
+  size_t lo = 0;
+  size_t hi = limb_arena_chunks_size;
+
+  // Binary search for the last chunk beginning at or before `p`.
+  while (lo < hi)
+    {
+      size_t mid = (lo + hi) / 2;
+      if (limb_arena_chunks[mid].begin <= p)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+  if ((lo > 0) && (p < limb_arena_chunks[lo - 1].end))
+    return (&limb_arena_chunks[lo - 1]);
+  return (NULL);
+}
+
+
+/**
+ * Add a new chunk for a size class.
+ *
+ * @param c size class.
+ *
+ * @returns success of chunk creation.
+ */
+static int
+limb_arena_chunk_new (size_t c)
+{
+  size_t block_size = c * LIMB_ARENA_ALIGN;
+  size_t chunk_size = (LIMB_ARENA_CHUNK_SIZE / block_size) * block_size;
+
+  // Extend chunk table if necessary.
+  if (limb_arena_chunks_size == limb_arena_chunks_capacity)
+    {
+      size_t new_capacity = limb_arena_chunks_capacity + DATA_CHUNK_SIZE;
+      limb_arena_chunk_t *new_chunks = NULL;
+      if (limb_arena_chunks == NULL)
+        new_chunks = (limb_arena_chunk_t *) mxMalloc (
+          new_capacity * sizeof(limb_arena_chunk_t));
+      else
+        new_chunks = (limb_arena_chunk_t *) mxRealloc (
+          limb_arena_chunks, new_capacity * sizeof(limb_arena_chunk_t));
+      if (new_chunks == NULL)
+        return (0);  // Memory allocation failed.
+
+      mexMakeMemoryPersistent (new_chunks);
+      limb_arena_chunks          = new_chunks;
+      limb_arena_chunks_capacity = new_capacity;
+    }
+
+  char *chunk = (char *) mxMalloc (chunk_size);
+  if (chunk == NULL)
+    return (0);  // Memory allocation failed.
+
+  mexMakeMemoryPersistent (chunk);
+  DBG_PRINTF ("New chunk of %d blocks of %d bytes.\n",
+              (int) (chunk_size / block_size), (int) block_size);
+
+  // Keep chunk table sorted by address.
+  size_t i = limb_arena_chunks_size;
+  while ((i > 0) && (limb_arena_chunks[i - 1].begin > chunk))
+    {
+      limb_arena_chunks[i] = limb_arena_chunks[i - 1];
+      i--;
+    }
+  limb_arena_chunks[i].begin = chunk;
+  limb_arena_chunks[i].end   = chunk + chunk_size;
+  limb_arena_chunks[i].live  = 0;
+  limb_arena_chunks_size++;
+
+  limb_arena_classes[c].top = chunk;
+  limb_arena_classes[c].end = chunk + chunk_size;
+  limb_arena_stats.chunks++;
+  limb_arena_stats.reserved_bytes += chunk_size;
+  return (1);
+}
+
+
+/**
+ * Allocate a block from the arena.
+ *
+ * @param size block size in bytes, `0 < size <= LIMB_ARENA_BLOCK_MAX`.
+ *
+ * @returns pointer to the block or `NULL` if memory allocation failed.
+ */
+static void *
+limb_arena_get (size_t size)
+{
+  size_t              c   = limb_arena_class_of (size);
+  limb_arena_class_t *cls = &limb_arena_classes[c];
+  void               *ptr = NULL;
+
+  if (cls->free_list != NULL)
+    {
+      ptr            = cls->free_list;
+      cls->free_list = *((void **) ptr);
+    }
+  else
+    {
+      if ((cls->top == cls->end) && ! limb_arena_chunk_new (c))
+        return (NULL);
+      ptr       = cls->top;
+      cls->top += c * LIMB_ARENA_ALIGN;
+    }
+  limb_arena_chunk_of (ptr)->live++;
+  limb_arena_stats.used_bytes += c * LIMB_ARENA_ALIGN;
+  return (ptr);
+}
+
+
+/**
+ * Return a block owned by the arena.
+ *
+ * The block might be returned from within an OpenMP parallel region, for
+ * example by `mpfr_set_prec`.
+ *
+ * @param ptr pointer to the block.
+ * @param size block size in bytes.
+ */
+static void
+limb_arena_put (void *ptr, size_t size)
+{
+  size_t c = limb_arena_class_of (size);
+
+  #pragma omp critical (limb_arena)
+  {
+    *((void **) ptr)               = limb_arena_classes[c].free_list;
+    limb_arena_classes[c].free_list = ptr;
+    limb_arena_chunk_of (ptr)->live--;
+    limb_arena_stats.frees++;
+    limb_arena_stats.used_bytes -= c * LIMB_ARENA_ALIGN;
+  }
+}
+
+
+/**
+ * GMP allocation function.
+ *
+ * Inside an arena scope the block is taken from the arena, if possible.
+ */
+static void *
+limb_arena_alloc (size_t size)
+{
+  if (limb_arena_scope)
+    {
+      void *ptr = NULL;
+      if (limb_arena_enabled && (size <= LIMB_ARENA_BLOCK_MAX))
+        ptr = limb_arena_get (size);
+      if (ptr != NULL)
+        {
+          limb_arena_stats.hits++;
+          return (ptr);
+        }
+      limb_arena_stats.misses++;
+    }
+  return (limb_arena_default_alloc (size));
+}
+
+
+/**
+ * GMP deallocation function.
+ */
+static void
+limb_arena_free (void *ptr, size_t size)
+{
+  if (limb_arena_chunk_of (ptr) != NULL)
+    limb_arena_put (ptr, size);
+  else
+    limb_arena_default_free (ptr, size);
+}
+
+
+/**
+ * GMP reallocation function.
+ *
+ * Inside an arena scope, or for a block owned by the arena, the block is
+ * moved.  Otherwise the default function is used.
+ */
+static void *
+limb_arena_realloc (void *ptr, size_t old_size, size_t new_size)
+{
+  int owned = (limb_arena_chunk_of (ptr) != NULL);
+
+  if (! owned && ! limb_arena_scope)
+    return (limb_arena_default_realloc (ptr, old_size, new_size));
+
+  if (owned && (new_size <= LIMB_ARENA_BLOCK_MAX)
+      && (limb_arena_class_of (new_size) == limb_arena_class_of (old_size)))
+    return (ptr);
+
+  void *new_ptr = limb_arena_alloc (new_size);
+  memcpy (new_ptr, ptr, (old_size < new_size) ? old_size : new_size);
+  if (owned)
+    limb_arena_put (ptr, old_size);
+  else
+    limb_arena_default_free (ptr, old_size);
+  return (new_ptr);
+}
+
+
+/**
+ * Replace the GMP memory functions by the limb arena.
+ *
+ * Must be called before the first use of GMP or MPFR.  Subsequent calls have
+ * no effect.
+ */
+void
+mex_gmp_limb_arena_install (void)
+{
+  if (limb_arena_installed)
+    return;
+
+  mp_get_memory_functions (&limb_arena_default_alloc,
+                           &limb_arena_default_realloc,
+                           &limb_arena_default_free);
+  mp_set_memory_functions (limb_arena_alloc, limb_arena_realloc,
+                           limb_arena_free);
+  limb_arena_installed = 1;
+}
+
+
+/**
+ * Restore the default GMP memory functions replaced by
+ * `mex_gmp_limb_arena_install`.
+ *
+ * All blocks owned by the arena must have been freed before, e.g. by
+ * `mex_gmp_limb_arena_release`.  MPFR forgets the cached memory functions of
+ * all threads of the OpenMP team.  No effect if not installed.
+ */
+void
+mex_gmp_limb_arena_uninstall (void)
+{
+  if (! limb_arena_installed)
+    return;
+
+  #pragma omp parallel
+  {
+    mpfr_mp_memory_cleanup ();
+  }
+  mp_set_memory_functions (limb_arena_default_alloc,
+                           limb_arena_default_realloc,
+                           limb_arena_default_free);
+  limb_arena_installed = 0;
+  limb_arena_scope     = 0;
+}
+
+
+/**
+ * Open a scope, in which GMP allocations are served by the limb arena.
+ *
+ * Must not be called from within an OpenMP parallel region.
+ */
+void
+mex_gmp_limb_arena_begin (void)
+{
+  limb_arena_scope = limb_arena_installed;
+}
+
+
+/**
+ * Close a scope opened by `mex_gmp_limb_arena_begin`.
+ */
+void
+mex_gmp_limb_arena_end (void)
+{
+  limb_arena_scope = 0;
+}
+
+
+/**
+ * Free all chunks of the limb arena.
+ *
+ * All blocks owned by the arena must have been freed before.  The GMP memory
+ * functions remain installed until `mex_gmp_limb_arena_uninstall`.
+ */
+void
+mex_gmp_limb_arena_release (void)
+{
+  DBG_PRINTF ("Release %d chunks.\n", (int) limb_arena_chunks_size);
+  for (size_t i = 0; i < limb_arena_chunks_size; i++)
+    mxFree (limb_arena_chunks[i].begin);
+  mxFree (limb_arena_chunks);
+  limb_arena_chunks          = NULL;
+  limb_arena_chunks_capacity = 0;
+  limb_arena_chunks_size     = 0;
+  memset (limb_arena_classes, 0, sizeof(limb_arena_classes));
+  limb_arena_stats.chunks         = 0;
+  limb_arena_stats.reserved_bytes = 0;
+  limb_arena_stats.used_bytes     = 0;
+}
+
+
+/**
+ * Return empty chunks of the limb arena to the system.
+ *
+ * Must not be called from within an OpenMP parallel region.
+ *
+ * @returns number of bytes returned.
+ */
+size_t
+mex_gmp_limb_arena_trim (void)
+{
+  // Remove the blocks of empty chunks from the free lists.
+  for (size_t c = 0; c < LIMB_ARENA_CLASSES; c++)
+    {
+      void **link = &limb_arena_classes[c].free_list;
+      while (*link != NULL)
+        if (limb_arena_chunk_of (*link)->live == 0)
+          *link = *((void **) *link);
+        else
+          link = (void **) *link;
+    }
+
+  // Free empty chunks, the chunk table remains sorted.
+  size_t bytes = 0;
+  size_t j     = 0;
+  for (size_t i = 0; i < limb_arena_chunks_size; i++)
+    {
+      limb_arena_chunk_t *chunk = &limb_arena_chunks[i];
+      if (chunk->live > 0)
+        {
+          limb_arena_chunks[j++] = *chunk;
+          continue;
+        }
+      for (size_t c = 0; c < LIMB_ARENA_CLASSES; c++)
+        if (limb_arena_classes[c].end == chunk->end)
+          {
+            limb_arena_classes[c].top = NULL;
+            limb_arena_classes[c].end = NULL;
+          }
+      bytes += (size_t) (chunk->end - chunk->begin);
+      mxFree (chunk->begin);
+    }
+  DBG_PRINTF ("Trim %d of %d chunks.\n", (int) (limb_arena_chunks_size - j),
+              (int) limb_arena_chunks_size);
+  limb_arena_stats.chunks         -= limb_arena_chunks_size - j;
+  limb_arena_stats.reserved_bytes -= bytes;
+  limb_arena_chunks_size           = j;
+  return (bytes);
+}
+
+
+/**
+ * Enable or disable the limb arena for future allocations.
+ *
+ * @param enabled `0` to use the default GMP memory functions.
+ */
+void
+mex_gmp_limb_arena_set_enabled (int enabled)
+{
+  limb_arena_enabled = (enabled != 0);
+}
+
+
+/**
+ * Check if the limb arena is enabled.
+ *
+ * @returns `1` if the limb arena is enabled, otherwise `0`.
+ */
+int
+mex_gmp_limb_arena_get_enabled (void)
+{
+  return (limb_arena_enabled);
+}
+
+
+/**
+ * Get the limb arena statistics.
+ *
+ * @param reset if non-zero, reset the counters `hits`, `misses`, and `frees`
+ *              after reading.
+ *
+ * @returns current limb arena statistics.
+ */
+gmp_limb_arena_stats_t
+mex_gmp_limb_arena_get_stats (int reset)
+{
+  gmp_limb_arena_stats_t stats = limb_arena_stats;
+
+  if (reset)
+    {
+      limb_arena_stats.hits   = 0;
+      limb_arena_stats.misses = 0;
+      limb_arena_stats.frees  = 0;
+    }
+  return (stats);
+}
@@ -58,8 +58,8 @@ mex_mpfr_algorithms (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (nlhs ? length (&rop) : 1, 1,
                                          mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr rop_ptr    = &mpfr_data[rop.start - 1];
-        mpfr_ptr op_ptr     = &mpfr_data[op.start - 1];
+        mpfr_ptr rop_ptr    = mex_mpfr_ptr (&rop);
+        mpfr_ptr op_ptr     = mex_mpfr_ptr (&op);
         size_t   ret_stride = (nlhs) ? 1 : 0;
 
         for (uint64_t i = 0; i < ropM; i++)
@@ -70,9 +70,10 @@ mex_mpfr_algorithms (int nlhs, mxArray *plhs[],
         return;
       }
 
-      case 2001: // int mpfr_t.mtimes (mpfr_t C, mpfr_t A, mpfr_t B, mpfr_prec_t prec, mpfr_rnd_t rnd, uint64_t M, int strategy)
+      case 2001: // int mpfr_t.mtimes (mpfr_t C, mpfr_t A, mpfr_t B, mpfr_prec_t prec, mpfr_rnd_t rnd, uint64_t M, int strategy, uint64_t cutoff = 0)
       {
-        MEX_NARGINCHK (8);
+        if ((nrhs < 8) || (nrhs > 9))
+          MEX_FCN_ERR ("cmd[%d]: Invalid number of arguments.\n", cmd_code);
         MEX_MPFR_T (1, C);
         MEX_MPFR_T (2, A);
         MEX_MPFR_T (3, B);
@@ -86,6 +87,10 @@ mex_mpfr_algorithms (int nlhs, mxArray *plhs[],
         if (! extract_ui (7, nrhs, prhs, &strategy))
           MEX_FCN_ERR ("%s\n", "cmd[mpfr_t.mtimes]:strategy must be a "
                        "positive numeric scalar.");
+        uint64_t cutoff = 0;
+        if ((nrhs == 9) && ! extract_ui (8, nrhs, prhs, &cutoff))
+          MEX_FCN_ERR ("%s\n", "cmd[mpfr_t.mtimes]:cutoff must be a "
+                       "non-negative numeric scalar.");
         DBG_PRINTF ("cmd[mpfr_t.mtimes]: C = [%d:%d], A = [%d:%d], "
                     "B = [%d:%d], prec = %d, rnd = %d, M = %d, strategy = %d\n",
                     C.start, C.end, A.start, A.end, B.start, B.end,
@@ -110,13 +115,17 @@ mex_mpfr_algorithms (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (nlhs ? length (&C) : 1, 1,
                                          mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr C_ptr      = &mpfr_data[C.start - 1];
-        mpfr_ptr A_ptr      = &mpfr_data[A.start - 1];
-        mpfr_ptr B_ptr      = &mpfr_data[B.start - 1];
+        mpfr_ptr C_ptr      = mex_mpfr_ptr (&C);
+        mpfr_ptr A_ptr      = mex_mpfr_ptr (&A);
+        mpfr_ptr B_ptr      = mex_mpfr_ptr (&B);
         size_t   ret_stride = (nlhs) ? 1 : 0;
 
-        mpfr_apa_mmm (C_ptr, A_ptr, B_ptr, prec, rnd, M, N, K, ret_ptr,
-                      ret_stride, strategy);
+        if (strategy == 11)
+          mpfr_apa_mmm_strassen (C_ptr, A_ptr, B_ptr, prec, rnd, M, N, K,
+                                 ret_ptr, ret_stride, cutoff);
+        else
+          mpfr_apa_mmm (C_ptr, A_ptr, B_ptr, prec, rnd, M, N, K, ret_ptr,
+                        ret_stride, strategy);
 
         return;
       }
@@ -156,9 +165,9 @@ mex_mpfr_algorithms (int nlhs, mxArray *plhs[],
 
         plhs[0] = mxCreateNumericMatrix ((nlhs ? M : 1), (nlhs ? N : 1),
                                          mxDOUBLE_CLASS, mxREAL);
-        mpfr_ptr L_ptr      = &mpfr_data[L.start - 1];
-        mpfr_ptr U_ptr      = &mpfr_data[U.start - 1];
-        mpfr_ptr A_ptr      = &mpfr_data[A.start - 1];
+        mpfr_ptr L_ptr      = mex_mpfr_ptr (&L);
+        mpfr_ptr U_ptr      = mex_mpfr_ptr (&U);
+        mpfr_ptr A_ptr      = mex_mpfr_ptr (&A);
         double * ret_ptr    = mxGetPr (plhs[0]);
         size_t   ret_stride = (nlhs) ? 1 : 0;
 
@@ -173,19 +182,29 @@ mex_mpfr_algorithms (int nlhs, mxArray *plhs[],
         uint64_t K_save = ((INFO == 0) ? K : (uint64_t) INFO);
 
         // Copy A to U.
-        #pragma omp parallel for
-        for (size_t j = 0; j < N; j++)
-          for (size_t i = 0; (i < (j + 1)) && (i < K_save); i++)
-            mpfr_set (&U_ptr[i + j * K], &A_ptr[i + j * M], rnd);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel reduction (|:flags)
+        {
+          #pragma omp for
+          for (size_t j = 0; j < N; j++)
+            for (size_t i = 0; (i < (j + 1)) && (i < K_save); i++)
+              mpfr_set (&U_ptr[i + j * K], &A_ptr[i + j * M], rnd);
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
 
         // Copy A to L.
         #pragma omp parallel for
         for (size_t j = 0; j < K; j++)
           mpfr_set_ui (&L_ptr[j + j * M], 1, rnd);  // Set diagonal 1.
-        #pragma omp parallel for
-        for (size_t j = 0; j < K_save; j++)
-          for (size_t i = j + 1; i < M; i++)
-            mpfr_set (&L_ptr[i + j * M], &A_ptr[i + j * M], rnd);
+        #pragma omp parallel reduction (|:flags)
+        {
+          #pragma omp for
+          for (size_t j = 0; j < K_save; j++)
+            for (size_t i = j + 1; i < M; i++)
+              mpfr_set (&L_ptr[i + j * M], &A_ptr[i + j * M], rnd);
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
 
         // Apply IPIV to L, if not returned `[L,U] = lu(A)`.
         if (nlhs <= 2)
@@ -244,8 +263,8 @@ mex_mpfr_algorithms (int nlhs, mxArray *plhs[],
 
         plhs[0] = mxCreateNumericMatrix ((nlhs ? N : 1), (nlhs ? N : 1),
                                          mxDOUBLE_CLASS, mxREAL);
-        mpfr_ptr A_ptr      = &mpfr_data[A.start - 1];
-        mpfr_ptr B_ptr      = &mpfr_data[B.start - 1];
+        mpfr_ptr A_ptr      = mex_mpfr_ptr (&A);
+        mpfr_ptr B_ptr      = mex_mpfr_ptr (&B);
         double * ret_ptr    = mxGetPr (plhs[0]);
         size_t   ret_stride = (nlhs) ? 1 : 0;
 
@@ -284,18 +303,130 @@ mex_mpfr_algorithms (int nlhs, mxArray *plhs[],
 
         plhs[0] = mxCreateNumericMatrix (N, 1, mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr = mxGetPr (plhs[0]);
-        mpfr_ptr rop_ptr = &mpfr_data[rop.start - 1];
-        mpfr_ptr op_ptr  = &mpfr_data[op.start - 1];
-        #pragma omp parallel for
-        for (size_t j = 0; j < N; j++)
+        mpfr_ptr rop_ptr = mex_mpfr_ptr (&rop);
+        mpfr_ptr op_ptr  = mex_mpfr_ptr (&op);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel reduction (|:flags)
+        {
+          #pragma omp for
+          for (size_t j = 0; j < N; j++)
+            {
+              int ret = mpfr_set (rop_ptr + j, op_ptr + M * j, rnd);
+              for (size_t i = 1; i < M; i++)
+                ret |= mpfr_min (rop_ptr + j, rop_ptr + j,
+                                 op_ptr + M * j + i, rnd);
+              ret_ptr[j] = (double) ret;
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
+
+        return;
+      }
+
+
+      case 2005: // int mpfr_t.eval_expr (mpfr_t rop, double[] prog, mpfr_prec_t prec, mpfr_rnd_t rnd, mpfr_t op1, ...)
+      {
+        if (nrhs < 6)
+          MEX_FCN_ERR ("cmd[mpfr_t.eval_expr]: Invalid number of arguments "
+                       "%d, expected at least 6.\n", nrhs);
+        MEX_MPFR_T (1, rop);
+        if (! mxIsDouble (prhs[2]) || (mxGetM (prhs[2]) != 2))
+          MEX_FCN_ERR ("%s\n", "cmd[mpfr_t.eval_expr]:prog must be a "
+                       "[2 x L] double matrix.");
+        MEX_MPFR_PREC_T (3, prec);
+        MEX_MPFR_RND_T (4, rnd);
+        DBG_PRINTF ("cmd[mpfr_t.eval_expr]: rop = [%d:%d], prec = %d, "
+                    "rnd = %d, num_ops = %d\n", rop.start, rop.end,
+                    (int) prec, (int) rnd, nrhs - 5);
+
+        const double *prog    = mxGetPr (prhs[2]);
+        size_t        L       = mxGetN (prhs[2]);
+        size_t        num_ops = (size_t) nrhs - 5;
+        size_t        depth   = 0;
+        size_t        bad     = mpfr_apa_expr_check (prog, L, num_ops, &depth);
+        if (bad > L)
+          MEX_FCN_ERR ("%s\n", "cmd[mpfr_t.eval_expr]:prog must leave "
+                       "exactly one value on the stack.");
+        if (bad > 0)
+          MEX_FCN_ERR ("cmd[mpfr_t.eval_expr]:prog Invalid instruction %d.\n",
+                       (int) bad);
+
+        // Operands are either of the same length as `rop` or scalars.
+        uint64_t  N       = length (&rop);
+        mpfr_ptr *ops     = (mpfr_ptr *) mxMalloc (num_ops * sizeof(mpfr_ptr));
+        uint64_t *ops_len = (uint64_t *) mxMalloc (num_ops * sizeof(uint64_t));
+        for (size_t k = 0; k < num_ops; k++)
           {
-            int ret = mpfr_set (rop_ptr + j, op_ptr + M * j, rnd);
-            for (size_t i = 1; i < M; i++)
-              ret |= mpfr_min (rop_ptr + j, rop_ptr + j,
-                               op_ptr + M * j + i, rnd);
-            ret_ptr[j] = (double) ret;
+            idx_t op;
+            if (! extract_idx ((int) k + 5, nrhs, prhs, &op)
+                || ((length (&op) != N) && (length (&op) != 1)))
+              {
+                mxFree (ops);
+                mxFree (ops_len);
+                MEX_FCN_ERR ("cmd[mpfr_t.eval_expr]:op%d Invalid MPFR "
+                             "variable indices.\n", (int) k + 1);
+              }
+            ops[k]     = mex_mpfr_ptr (&op);
+            ops_len[k] = length (&op);
           }
 
+        plhs[0] = mxCreateNumericMatrix (nlhs ? N : 1, 1, mxDOUBLE_CLASS,
+                                         mxREAL);
+        double *ret_ptr    = mxGetPr (plhs[0]);
+        size_t  ret_stride = (nlhs) ? 1 : 0;
+        mpfr_apa_expr (mex_mpfr_ptr (&rop), N, prog, L, depth, ops, ops_len,
+                       prec, rnd, ret_ptr, ret_stride);
+        mxFree (ops);
+        mxFree (ops_len);
+        return;
+      }
+
+      case 2006: // int mpfr_t.mtimes_d (mpfr_t C, mpfr_t A, double[] B, mpfr_rnd_t rnd, uint64_t M)
+      case 2007: // int mpfr_t.d_mtimes (mpfr_t C, double[] A, mpfr_t B, mpfr_rnd_t rnd, uint64_t M)
+      {
+        MEX_NARGINCHK (6);
+        MEX_MPFR_T (1, C);
+        int d_left = (cmd_code == 2007);
+        MEX_MPFR_T ((d_left ? 3 : 2), X);
+        const mxArray *D = prhs[d_left ? 2 : 3];
+        if (! mxIsDouble (D))
+          MEX_FCN_ERR ("cmd[%d]:%s must be a double matrix.\n",
+                       cmd_code, d_left ? "A" : "B");
+        MEX_MPFR_RND_T (4, rnd);
+        uint64_t M = 0;
+        if (! extract_ui (5, nrhs, prhs, &M) || (M == 0))
+          MEX_FCN_ERR ("%s\n", "cmd[mpfr_t.mtimes]:M must be a positive "
+                       "numeric scalar denoting the rows of input rop.");
+        DBG_PRINTF ("cmd[mpfr_t.mtimes]: C = [%d:%d], X = [%d:%d], "
+                    "D = [%d x %d], rnd = %d, M = %d\n", C.start, C.end,
+                    X.start, X.end, (int) mxGetM (D), (int) mxGetN (D),
+                    (int) rnd, (int) M);
+
+        // Check matrix dimensions to be sane.
+        //   C [M x N]
+        //   A [M x K]
+        //   B [K x N]
+        uint64_t N = length (&C) / M;
+        if (length (&C) != (M * N))
+          MEX_FCN_ERR ("%s\n", "cmd[mpfr_t.mtimes]:M does not denote the "
+                       "number of rows of input matrix C.");
+        uint64_t lenA = d_left ? mxGetNumberOfElements (D) : length (&X);
+        uint64_t lenB = d_left ? length (&X) : mxGetNumberOfElements (D);
+        uint64_t K    = lenA / M;
+        if (lenA != (M * K))
+          MEX_FCN_ERR ("cmd[mpfr_t.mtimes]:Incompatible matrix A.  Expected "
+                       "a [%d x %d] matrix\n", M, K);
+        if (lenB != (K * N))
+          MEX_FCN_ERR ("cmd[mpfr_t.mtimes]:Incompatible matrix B.  Expected "
+                       "a [%d x %d] matrix\n", K, N);
+
+        plhs[0] = mxCreateNumericMatrix (nlhs ? length (&C) : 1, 1,
+                                         mxDOUBLE_CLASS, mxREAL);
+        double *ret_ptr    = mxGetPr (plhs[0]);
+        size_t  ret_stride = (nlhs) ? 1 : 0;
+        mpfr_apa_mmm_d (mex_mpfr_ptr (&C), mex_mpfr_ptr (&X), mxGetPr (D),
+                        d_left, rnd, M, N, K, ret_ptr, ret_stride);
         return;
       }
 
@@ -35,20 +35,27 @@ mex_mpfr_algorithms (int nlhs, mxArray *plhs[],
 
 
 /**
- * MPFR Dot product `rop = a' * b`.
+ * MPFR Dot product `rop = rop + a' * b`, correctly rounded.
+ *
+ * The vectors are split into blocks of fixed size.  For each block the
+ * products are either summed up exactly in a variable of sufficient
+ * precision, or, if the exponents of the products are too far apart, kept
+ * exactly in variables of precision `pa + pb`.  Finally, `rop` and all these
+ * exact terms are summed up with a single `mpfr_sum`.  As no intermediate
+ * result is rounded, the result is independent of the number of threads and
+ * there is no critical section.
  *
  * @param rop scalar @c mpfr_ptr.
  * @param a vector @c mpfr_ptr of length @c N.
  * @param b vector @c mpfr_ptr of length @c N.
  * @param N vector length of @c a and @c b.
- * @param prec MPFR precision for intermediate operations.
- * @param rnd  MPFR rounding mode for all operations.
+ * @param rnd  MPFR rounding mode for the final sum.
  *
- * @returns MPFR ternary return value (logical OR of all return values).
+ * @returns MPFR ternary return value of the correctly rounded result.
  */
 int
 mpfr_apa_dot (mpfr_ptr rop, mpfr_ptr a, mpfr_ptr b, uint64_t N,
-              mpfr_prec_t prec, mpfr_rnd_t rnd);
+              mpfr_rnd_t rnd);
 
 
 /**
@@ -75,6 +82,102 @@ mpfr_apa_mmm (mpfr_ptr C, mpfr_ptr A, mpfr_ptr B,
               double *ret_ptr, size_t ret_stride, uint64_t strategy);
 
 
+/**
+ * Strassen-Winograd MPFR Matrix-Matrix-Multiplication `C = C + A * B`.
+ *
+ * The recursion saves one of eight multiplications per level for 19
+ * additions of quadrants, see `mmm_strassen`.  The errors grow faster than
+ * for the plain products.  The seven subproducts of the top level run as
+ * parallel tasks, each with its own temporaries for the levels below.  All
+ * temporaries of precision @c prec are allocated at once.
+ *
+ * @param C [M x N] @c mpfr_ptr indexed by (i,j).
+ * @param A [M x K] @c mpfr_ptr indexed by (i,k).
+ * @param B [K x N] @c mpfr_ptr indexed by (k,j).
+ * @param prec MPFR precision for intermediate operations.
+ * @param rnd MPFR rounding mode for all operations.
+ * @param M Matrix dimension (see above).
+ * @param N Matrix dimension (see above).
+ * @param K Matrix dimension (see above).
+ * @param ret_ptr pointer to array of MPFR return values.  All elements are
+ *                the logical OR of all return values.
+ * @param ret_stride equals 1, if the array of MPFR return values should be
+ *                   filled and has the same size as C.  Otherwise 0 for
+ *                   scalar (ignored) return value.
+ * @param cutoff recursion stops, if a dimension does not exceed it.
+ *               0 selects the default.
+ */
+void
+mpfr_apa_mmm_strassen (mpfr_ptr C, mpfr_ptr A, mpfr_ptr B,
+                       mpfr_prec_t prec, mpfr_rnd_t rnd,
+                       uint64_t M, uint64_t N, uint64_t K,
+                       double *ret_ptr, size_t ret_stride, uint64_t cutoff);
+
+
+/**
+ * MPFR Matrix-Matrix-Multiplication with a double matrix D, either
+ * `C = X * D` or `C = D * X`, correctly rounded.
+ *
+ * The double operand is not converted to the precision of X.  Each double
+ * is copied exactly once to a variable of precision 53 (`DBL_MANT_DIG`) with
+ * all limbs in a single block, which saves the conversion of `mpfr_mul_d` in
+ * each product.  Each product `x * d` is exact in a variable of precision
+ * `px + 53`, where `px` is the maximum precision of X, and each element of
+ * C is rounded once by `mpfr_sum`.  Each thread reuses its own K product
+ * variables for all elements of C.
+ *
+ * @param C [M x N] @c mpfr_ptr indexed by (i,j).
+ * @param X [M x K] (if @c d_left is 0) or [K x N] (otherwise) @c mpfr_ptr.
+ * @param D [K x N] (if @c d_left is 0) or [M x K] (otherwise) double matrix.
+ * @param d_left 0 for `C = X * D`, otherwise `C = D * X`.
+ * @param rnd MPFR rounding mode of the elements of C.
+ * @param M Matrix dimension (see above).
+ * @param N Matrix dimension (see above).
+ * @param K Matrix dimension (see above).
+ * @param ret_ptr pointer to array of MPFR return values.
+ * @param ret_stride equals 1, if the array of MPFR return values should be
+ *                   filled and has the same size as C.  Otherwise 0 for
+ *                   scalar (ignored) return value.
+ */
+void
+mpfr_apa_mmm_d (mpfr_ptr C, mpfr_ptr X, const double *D, int d_left,
+                mpfr_rnd_t rnd, uint64_t M, uint64_t N, uint64_t K,
+                double *ret_ptr, size_t ret_stride);
+
+
+/**
+ * Serial cache-blocked MPFR Matrix-Matrix-Multiplication update
+ * `C = C - A * B` of submatrices in place, for example in a task.
+ *
+ * C is processed in tiles and K in blocks like in strategy 8.  Each
+ * element of C is updated by `c = -(a * b - c)` for `k = 0, ..., K-1` in
+ * this order and rounded to its own precision, thus the result equals the
+ * updates of an unblocked Gaussian elimination.
+ *
+ * @param C [M x N] @c mpfr_ptr with leading dimension @c LDC.
+ * @param LDC leading dimension of @c C.
+ * @param A [M x K] @c mpfr_ptr with leading dimension @c LDA.
+ * @param LDA leading dimension of @c A.
+ * @param B [K x N] @c mpfr_ptr with leading dimension @c LDB.
+ * @param LDB leading dimension of @c B.
+ * @param M Matrix dimension (see above).
+ * @param N Matrix dimension (see above).
+ * @param K Matrix dimension (see above).
+ * @param rnd MPFR rounding mode for all operations.
+ * @param ret_ptr pointer to array of MPFR return values with leading
+ *                dimension @c LDC.  The return values of the updates are
+ *                ORed to them.
+ * @param ret_stride equals 1, if the array of MPFR return values should be
+ *                   filled and has the same size as C.  Otherwise 0 for
+ *                   scalar (ignored) return value.
+ */
+void
+mpfr_apa_mmm_sub (mpfr_ptr C, uint64_t LDC, mpfr_ptr A, uint64_t LDA,
+                  mpfr_ptr B, uint64_t LDB, uint64_t M, uint64_t N,
+                  uint64_t K, mpfr_rnd_t rnd, double *ret_ptr,
+                  size_t ret_stride);
+
+
 /**
  * MPFR LU factorization of a general M-by-N matrix A using partial pivoting
  * with row interchanges.
@@ -174,5 +277,48 @@ mpfr_apa_GESV (uint64_t N, uint64_t NRHS, mpfr_ptr A, uint64_t LDA,
                double *ret_ptr, size_t ret_stride);
 
 
+/**
+ * Check an expression program for `mpfr_apa_expr`.
+ *
+ * @param prog [2 x L] expression program, see `mpfr_apa_expr`.
+ * @param L number of instructions.
+ * @param num_ops number of operand ranges.
+ * @param[out] depth maximal stack depth of the program.
+ *
+ * @returns `0` if the program is valid, otherwise the (1-based) index of the
+ *          first invalid instruction.
+ */
+size_t
+mpfr_apa_expr_check (const double *prog, size_t L, size_t num_ops,
+                     size_t *depth);
+
+
+/**
+ * Evaluate an expression program elementwise `rop(i) = prog(ops(i))` in a
+ * single OpenMP parallel loop with thread-private scratch registers.
+ *
+ * @param rop vector @c mpfr_ptr of length @c N, must not overlap with
+ *            operands of length 1.
+ * @param N vector length of @c rop.
+ * @param prog [2 x L] postfix expression program of instructions
+ *             `[kind; arg]`, see "mex_mpfr_algorithms_expr.c".
+ * @param L number of instructions.
+ * @param depth maximal stack depth of the program.
+ * @param ops array of @c mpfr_ptr operands.
+ * @param ops_len array of operand lengths, either @c N or 1.
+ * @param prec MPFR precision for intermediate operations.
+ * @param rnd  MPFR rounding mode for all operations.
+ * @param ret_ptr pointer to array of MPFR return values.
+ * @param ret_stride equals 1, if the array of MPFR return values should be
+ *                   filled and has the same size as @c rop.  Otherwise 0
+ *                   for the logical OR of all return values.
+ */
+void
+mpfr_apa_expr (mpfr_ptr rop, uint64_t N, const double *prog, size_t L,
+               size_t depth, mpfr_ptr *ops, const uint64_t *ops_len,
+               mpfr_prec_t prec, mpfr_rnd_t rnd,
+               double *ret_ptr, size_t ret_stride);
+
+
 #endif // MEX_MPFR_ALGORITHMS_H_
 
@@ -17,43 +17,172 @@
 
 #include "mex_mpfr_interface.h"
 
+// The products are summed up in blocks of `DOT_BLOCK` elements.  The block
+// partition does not depend on the number of threads.
+#define DOT_BLOCK 256
+
+
 /**
- * MPFR Dot product `rop = a' * b`.
+ * Precision to represent the sum of the products `a[i] * b[i]` of a block
+ * exactly.
+ *
+ * Each product `a[i] * b[i]` is a multiple of `2^(ea + eb - pa - pb)` below
+ * `2^(ea + eb)`, where `ea` and `eb` denote the exponents and `pa` and `pb`
+ * the precisions of `a[i]` and `b[i]`.  The sum of `n` products needs
+ * `ceil(log2(n))` more bits.  Zero and singular products do not count.
+ *
+ * @param a vector @c mpfr_ptr of length @c n.
+ * @param b vector @c mpfr_ptr of length @c n.
+ * @param n vector length of @c a and @c b.
+ *
+ * @returns exact precision (as double to avoid an integer overflow).
+ */
+static double
+dot_block_prec (mpfr_ptr a, mpfr_ptr b, uint64_t n)
+{
+  double hi = 0.0;
+  double lo = 0.0;
+  int    regular = 0;
+
+  for (uint64_t i = 0; i < n; i++)
+    {
+      if (! mpfr_regular_p (a + i) || ! mpfr_regular_p (b + i))
+        continue;
+      double e  = (double) mpfr_get_exp (a + i) + (double) mpfr_get_exp (b + i);
+      double el = e - (double) mpfr_get_prec (a + i)
+                  - (double) mpfr_get_prec (b + i);
+      hi      = (! regular || (e > hi)) ? e : hi;
+      lo      = (! regular || (el < lo)) ? el : lo;
+      regular = 1;
+    }
+  if (! regular)
+    return ((double) MPFR_PREC_MIN);
+
+  uint64_t carry = 0;
+  while (((uint64_t) 1 << carry) < n)
+    carry++;
+  return (hi - lo + (double) carry);
+}
+
+
+/**
+ * MPFR Dot product `rop = rop + a' * b`, correctly rounded.
+ *
+ * The vectors are split into blocks of fixed size.  For each block the
+ * products are either summed up exactly in a variable of sufficient
+ * precision, or, if the exponents of the products are too far apart, kept
+ * exactly in variables of precision `pa + pb`.  Finally, `rop` and all these
+ * exact terms are summed up with a single `mpfr_sum`.  As no intermediate
+ * result is rounded, the result is independent of the number of threads and
+ * there is no critical section.
  *
  * @param rop scalar @c mpfr_ptr.
  * @param a vector @c mpfr_ptr of length @c N.
  * @param b vector @c mpfr_ptr of length @c N.
  * @param N vector length of @c a and @c b.
- * @param prec MPFR precision for intermediate operations.
- * @param rnd  MPFR rounding mode for all operations.
+ * @param rnd  MPFR rounding mode for the final sum.
  *
- * @returns MPFR ternary return value (logical OR of all return values).
+ * @returns MPFR ternary return value of the correctly rounded result.
  */
 int
 mpfr_apa_dot (mpfr_ptr rop, mpfr_ptr a, mpfr_ptr b, uint64_t N,
-              mpfr_prec_t prec, mpfr_rnd_t rnd)
+              mpfr_rnd_t rnd)
 {
-  int ret = 0;
+  uint64_t     nb    = (N + DOT_BLOCK - 1) / DOT_BLOCK;
+  mpfr_flags_t flags = 0;
+
+  // Exact terms of each block: either one sum or `DOT_BLOCK` products.
+  // This function may be called from a parallel region, thus `malloc`
+  // instead of `mxMalloc`.
+  mpfr_ptr *terms  = (mpfr_ptr *) malloc (nb * sizeof(mpfr_ptr));
+  uint64_t *nterms = (uint64_t *) malloc (nb * sizeof(uint64_t));
 
-  #pragma omp parallel shared(ret)
-  {
-    int    r = 0;
-    mpfr_t c;
-    mpfr_init_set_d (c, 0.0, prec);
+  #pragma omp parallel for if (nb > 1) schedule (static) reduction (|:flags)
+  for (uint64_t k = 0; k < nb; k++)
+    {
+      uint64_t first = k * DOT_BLOCK;
+      uint64_t n     = ((N - first) < DOT_BLOCK) ? (N - first) : DOT_BLOCK;
+      mpfr_ptr ak    = a + first;
+      mpfr_ptr bk    = b + first;
 
-    #pragma omp for
-    for (uint64_t i = 0; i < N; i++)
-      r |= mpfr_fma (c, a + i, b + i, c, rnd);
+      // Limit the exact sum to the memory of the exact products.
+      double prec     = dot_block_prec (ak, bk, n);
+      double prec_max = 0.0;
+      for (uint64_t i = 0; i < n; i++)
+        prec_max += (double) mpfr_get_prec (ak + i)
+                    + (double) mpfr_get_prec (bk + i);
 
-    // Sum `c` to `rop`, one thread at a time.
-    #pragma omp critical
+      if (prec <= prec_max)
+        {
+          terms[k]  = (mpfr_ptr) malloc (sizeof(mpfr_t));
+          nterms[k] = 1;
+          mpfr_init2 (terms[k], (mpfr_prec_t) prec);
+          #if (MPFR_VERSION < MPFR_VERSION_NUM (4, 1, 0))
+          mpfr_t   p[DOT_BLOCK];
+          mpfr_ptr p_ptr[DOT_BLOCK];
+          for (uint64_t i = 0; i < n; i++)
+            {
+              mpfr_init2 (p[i],
+                          mpfr_get_prec (ak + i) + mpfr_get_prec (bk + i));
+              mpfr_mul (p[i], ak + i, bk + i, MPFR_RNDN);
+              p_ptr[i] = p[i];
+            }
+          mpfr_sum (terms[k], p_ptr, n, MPFR_RNDN);
+          for (uint64_t i = 0; i < n; i++)
+            mpfr_clear (p[i]);
+          #else
+          mpfr_ptr a_ptr[DOT_BLOCK];
+          mpfr_ptr b_ptr[DOT_BLOCK];
+          for (uint64_t i = 0; i < n; i++)
+            {
+              a_ptr[i] = ak + i;
+              b_ptr[i] = bk + i;
+            }
+          mpfr_dot (terms[k], a_ptr, b_ptr, n, MPFR_RNDN);
+          #endif
+        }
+      else
+        {
+          terms[k]  = (mpfr_ptr) malloc (n * sizeof(mpfr_t));
+          nterms[k] = n;
+          for (uint64_t i = 0; i < n; i++)
+            {
+              mpfr_init2 (terms[k] + i,
+                          mpfr_get_prec (ak + i) + mpfr_get_prec (bk + i));
+              mpfr_mul (terms[k] + i, ak + i, bk + i, MPFR_RNDN);
+            }
+        }
+      flags |= mex_mpfr_omp_flags_collect ();
+    }
+  mpfr_flags_set (flags);
+
+  // Sum up `rop` and the exact terms in block order.  A copy of `rop`,
+  // because `mpfr_sum` does not document overlapping input and output.
+  uint64_t n = 1;
+  for (uint64_t k = 0; k < nb; k++)
+    n += nterms[k];
+  mpfr_ptr *tab = (mpfr_ptr *) malloc (n * sizeof(mpfr_ptr));
+  mpfr_t    r;
+  mpfr_init2 (r, mpfr_get_prec (rop));
+  mpfr_set (r, rop, MPFR_RNDN);
+  tab[0] = r;
+  n      = 1;
+  for (uint64_t k = 0; k < nb; k++)
+    for (uint64_t i = 0; i < nterms[k]; i++)
+      tab[n++] = terms[k] + i;
+
+  int ret = mpfr_sum (rop, tab, (unsigned long) n, rnd);
+
+  mpfr_clear (r);
+  free (tab);
+  for (uint64_t k = 0; k < nb; k++)
     {
-      ret |= (r | mpfr_add (rop, rop, c, rnd));
+      for (uint64_t i = 0; i < nterms[k]; i++)
+        mpfr_clear (terms[k] + i);
+      free (terms[k]);
     }
-    mpfr_clear (c);
-    mpfr_free_cache ();
-  }
+  free (nterms);
+  free (terms);
 
   return (ret);
 }
-
@@ -0,0 +1,268 @@
+/*
+ * This file is part of APA.
+ *
+ *  APA is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  APA is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with APA.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mex_mpfr_interface.h"
+
+// Instruction kinds of an expression program, see `mpfr_apa_expr`.
+#define EXPR_PUSH_OP     1
+#define EXPR_PUSH_D      2
+#define EXPR_BINARY      3
+#define EXPR_UNARY       4
+
+// Binary operations.
+#define EXPR_ADD         1
+#define EXPR_SUB         2
+#define EXPR_MUL         3
+#define EXPR_DIV         4
+#define EXPR_POW         5
+#define EXPR_MIN         6
+#define EXPR_MAX         7
+#define EXPR_BINARY_LAST 7
+
+// Unary operations.
+#define EXPR_NEG         1
+#define EXPR_ABS         2
+#define EXPR_SQRT        3
+#define EXPR_SQR         4
+#define EXPR_EXP         5
+#define EXPR_LOG         6
+#define EXPR_SIN         7
+#define EXPR_COS         8
+#define EXPR_TAN         9
+#define EXPR_UNARY_LAST  9
+
+
+/**
+ * Check an expression program for `mpfr_apa_expr`.
+ *
+ * @param prog [2 x L] expression program, see `mpfr_apa_expr`.
+ * @param L number of instructions.
+ * @param num_ops number of operand ranges.
+ * @param[out] depth maximal stack depth of the program.
+ *
+ * @returns `0` if the program is valid, otherwise the (1-based) index of the
+ *          first invalid instruction.
+ */
+size_t
+mpfr_apa_expr_check (const double *prog, size_t L, size_t num_ops,
+                     size_t *depth)
+{
+  size_t sp = 0;
+  *depth = 0;
+  for (size_t l = 0; l < L; l++)
+    {
+      double kind = prog[2 * l];
+      double arg  = prog[2 * l + 1];
+      if ((kind < EXPR_PUSH_OP) || (kind > EXPR_UNARY)
+          || (floor (kind) != kind))
+        return (l + 1);
+      switch ((int) kind)
+        {
+          case EXPR_PUSH_OP:
+            if ((arg < 1.0) || (arg > (double) num_ops) || (floor (arg) != arg))
+              return (l + 1);
+          // fall through
+          case EXPR_PUSH_D:
+            sp++;
+            break;
+
+          case EXPR_BINARY:
+            if ((sp < 2) || (arg < 1.0) || (arg > EXPR_BINARY_LAST)
+                || (floor (arg) != arg))
+              return (l + 1);
+            sp--;
+            break;
+
+          case EXPR_UNARY:
+            if ((sp < 1) || (arg < 1.0) || (arg > EXPR_UNARY_LAST)
+                || (floor (arg) != arg))
+              return (l + 1);
+            break;
+
+          default:
+            return (l + 1);
+        }
+      if (sp > *depth)
+        *depth = sp;
+    }
+  return ((sp == 1) ? 0 : L + 1);
+}
+
+
+/**
+ * Evaluate an expression program elementwise `rop(i) = prog(ops(i))`.
+ *
+ * All elements are evaluated in a single OpenMP parallel loop.  Each thread
+ * owns a stack of scratch registers of precision @c prec, thus no
+ * intermediate MPFR variables of length @c N are created.  Scalar double
+ * constants are converted once before the loop.
+ *
+ * @param rop vector @c mpfr_ptr of length @c N, must not overlap with
+ *            operands of length 1.
+ * @param N vector length of @c rop.
+ * @param prog [2 x L] postfix expression program.  Each column is one
+ *             instruction `[kind; arg]`:
+ *               - `[1; k]` push element `i` of operand `k` (1-based), or
+ *                 element 0 if the operand has length 1.
+ *               - `[2; d]` push the double constant `d`.
+ *               - `[3; op]` pop `y`, pop `x`, push `x op y` with
+ *                 op = 1: add, 2: sub, 3: mul, 4: div, 5: pow, 6: min,
+ *                 7: max.
+ *               - `[4; op]` pop `x`, push `op(x)` with
+ *                 op = 1: neg, 2: abs, 3: sqrt, 4: sqr, 5: exp, 6: log,
+ *                 7: sin, 8: cos, 9: tan.
+ *             The program must be checked by `mpfr_apa_expr_check`.
+ * @param L number of instructions.
+ * @param depth maximal stack depth of the program.
+ * @param ops array of @c mpfr_ptr operands.
+ * @param ops_len array of operand lengths, either @c N or 1.
+ * @param prec MPFR precision for intermediate operations.
+ * @param rnd  MPFR rounding mode for all operations.
+ * @param ret_ptr pointer to array of MPFR return values (logical OR of the
+ *                return values of all instructions of an element).
+ * @param ret_stride equals 1, if the array of MPFR return values should be
+ *                   filled and has the same size as @c rop.  Otherwise 0
+ *                   for the logical OR of all return values.
+ */
+void
+mpfr_apa_expr (mpfr_ptr rop, uint64_t N, const double *prog, size_t L,
+               size_t depth, mpfr_ptr *ops, const uint64_t *ops_len,
+               mpfr_prec_t prec, mpfr_rnd_t rnd,
+               double *ret_ptr, size_t ret_stride)
+{
+  // Constants are shared read-only by all threads.
+  size_t num_consts = 0;
+  for (size_t l = 0; l < L; l++)
+    if (prog[2 * l] == EXPR_PUSH_D)
+      num_consts++;
+  mpfr_ptr consts = NULL;
+  if (num_consts > 0)
+    {
+      consts = (mpfr_ptr) mxMalloc (num_consts * sizeof(mpfr_t));
+      for (size_t l = 0, c = 0; l < L; l++)
+        if (prog[2 * l] == EXPR_PUSH_D)
+          {
+            mpfr_init2 (consts + c, prec);
+            mpfr_set_d (consts + c++, prog[2 * l + 1], rnd);
+          }
+    }
+
+  int          ret_all = 0;
+  mpfr_flags_t flags   = 0;
+
+  #pragma omp parallel shared(ret_all, flags)
+  {
+    // Register `s` holds the result of an operation at stack position `s`,
+    // `stack[s]` points to a register, an operand, or a constant.
+    mpfr_ptr  regs  = (mpfr_ptr) malloc (depth * sizeof(mpfr_t));
+    mpfr_ptr *stack = (mpfr_ptr *) malloc (depth * sizeof(mpfr_ptr));
+    int       r_all = 0;
+    for (size_t s = 0; s < depth; s++)
+      mpfr_init2 (regs + s, prec);
+
+    #pragma omp for
+    for (uint64_t i = 0; i < N; i++)
+      {
+        int    r  = 0;
+        size_t sp = 0;
+        for (size_t l = 0, c = 0; l < L; l++)
+          {
+            int      arg  = (int) prog[2 * l + 1];
+            mpfr_ptr dest = NULL;
+            switch ((int) prog[2 * l])
+              {
+                case EXPR_PUSH_OP:
+                  stack[sp++] = ops[arg - 1]
+                                + ((ops_len[arg - 1] == 1) ? 0 : i);
+                  continue;
+
+                case EXPR_PUSH_D:
+                  stack[sp++] = consts + c++;
+                  continue;
+
+                case EXPR_BINARY:
+                {
+                  sp--;
+                  mpfr_ptr x = stack[sp - 1];
+                  mpfr_ptr y = stack[sp];
+                  dest = (l + 1 == L) ? rop + i : regs + sp - 1;
+                  switch (arg)
+                    {
+                      case EXPR_ADD: r |= mpfr_add (dest, x, y, rnd); break;
+                      case EXPR_SUB: r |= mpfr_sub (dest, x, y, rnd); break;
+                      case EXPR_MUL: r |= mpfr_mul (dest, x, y, rnd); break;
+                      case EXPR_DIV: r |= mpfr_div (dest, x, y, rnd); break;
+                      case EXPR_POW: r |= mpfr_pow (dest, x, y, rnd); break;
+                      case EXPR_MIN: r |= mpfr_min (dest, x, y, rnd); break;
+                      case EXPR_MAX: r |= mpfr_max (dest, x, y, rnd); break;
+                    }
+                  stack[sp - 1] = dest;
+                  break;
+                }
+
+                case EXPR_UNARY:
+                {
+                  mpfr_ptr x = stack[sp - 1];
+                  dest = (l + 1 == L) ? rop + i : regs + sp - 1;
+                  switch (arg)
+                    {
+                      case EXPR_NEG:  r |= mpfr_neg (dest, x, rnd);  break;
+                      case EXPR_ABS:  r |= mpfr_abs (dest, x, rnd);  break;
+                      case EXPR_SQRT: r |= mpfr_sqrt (dest, x, rnd); break;
+                      case EXPR_SQR:  r |= mpfr_sqr (dest, x, rnd);  break;
+                      case EXPR_EXP:  r |= mpfr_exp (dest, x, rnd);  break;
+                      case EXPR_LOG:  r |= mpfr_log (dest, x, rnd);  break;
+                      case EXPR_SIN:  r |= mpfr_sin (dest, x, rnd);  break;
+                      case EXPR_COS:  r |= mpfr_cos (dest, x, rnd);  break;
+                      case EXPR_TAN:  r |= mpfr_tan (dest, x, rnd);  break;
+                    }
+                  stack[sp - 1] = dest;
+                  break;
+                }
+              }
+          }
+
+        // A program without operations only copies an operand or constant.
+        if (stack[0] != rop + i)
+          r |= mpfr_set (rop + i, stack[0], rnd);
+
+        if (ret_stride)
+          ret_ptr[i] = (double) r;
+        else
+          r_all |= r;
+      }
+
+    #pragma omp critical
+    {
+      ret_all |= r_all;
+      flags   |= mex_mpfr_omp_flags_collect ();
+    }
+    for (size_t s = 0; s < depth; s++)
+      mpfr_clear (regs + s);
+    free (stack);
+    free (regs);
+  }
+  mpfr_flags_set (flags);
+
+  if (! ret_stride)
+    ret_ptr[0] = (double) ret_all;
+
+  for (size_t c = 0; c < num_consts; c++)
+    mpfr_clear (consts + c);
+  if (consts != NULL)
+    mxFree (consts);
+}
@@ -25,6 +25,165 @@
   ({ __typeof__(a)_a = (a); __typeof__(b)_b = (b); \
      _a < _b ? _a : _b; })
 
+// Tiles of the LU factorization have `GETRF_NB x GETRF_NB` elements.
+#define GETRF_NB 32
+
+
+/**
+ * Interchange the rows @c k and @c l of `A(:, c0:cn-1)` and of the MPFR
+ * return values, see `mpfr_apa_GETRF` for the parameters.
+ *
+ * @param k row index.
+ * @param l row index.
+ * @param c0 first column.
+ * @param cn last column plus one.
+ */
+static void
+getrf_swap (mpfr_ptr A, uint64_t LDA, uint64_t k, uint64_t l, uint64_t c0,
+            uint64_t cn, double *ret_ptr, size_t ret_stride)
+{
+  for (uint64_t j = c0; j < cn; j++)
+    {
+      mpfr_swap (&A[k + j * LDA], &A[l + j * LDA]);
+      if (ret_stride)
+        {
+          double ret = ret_ptr[k + j * LDA];
+          ret_ptr[k + j * LDA] = ret_ptr[l + j * LDA];
+          ret_ptr[l + j * LDA] = ret;
+        }
+    }
+}
+
+
+/**
+ * Unblocked LU factorization of the panel `A(j0:M-1, j0:jn-1)` with partial
+ * pivoting, see `mpfr_apa_GETRF` for the parameters.
+ *
+ * Golub, Van Loan: "Matrix Computations", 4th edition, Algorithm 3.2.1
+ * with rectangular matrix modification (3.2.8, p. 118) and with pivot
+ * search in current column k.  The row interchanges are only applied to
+ * the panel columns.
+ *
+ * @param j0 first row and column of the panel.
+ * @param jn last column of the panel plus one.
+ * @param K number of elimination steps of the whole matrix `min(M,N)`.
+ *
+ * @returns number of elimination steps.  Less than `min(K,jn) - j0`, if a
+ *          zero pivot stopped the factorization.
+ */
+static uint64_t
+getrf_panel (uint64_t M, mpfr_ptr A, uint64_t LDA, uint64_t j0, uint64_t jn,
+             uint64_t K, uint64_t *IPIV, int *INFO, mpfr_prec_t prec,
+             mpfr_rnd_t rnd, double *ret_ptr, size_t ret_stride)
+{
+  MEX_TRACE_BEGIN ("GETRF panel", "\"j0\": %d", (int) j0);
+  mpfr_t piv, tmp;
+
+  mpfr_init2 (piv, prec);
+  mpfr_init2 (tmp, prec);
+
+  uint64_t k = j0;
+  for (; k < MIN (K, jn); k++)
+    {
+      // Find pivot in column k.  The first element of maximal magnitude
+      // rounded to precision `prec`.
+      mpfr_abs (piv, &A[k + k * LDA], rnd);
+      IPIV[k] = k;
+      for (uint64_t i = k + 1; i < M; i++)
+        {
+          mpfr_abs (tmp, &A[i + k * LDA], rnd);
+          if (mpfr_less_p (piv, tmp))
+            {
+              mpfr_set (piv, tmp, rnd);
+              IPIV[k] = i;
+            }
+        }
+
+      // STOP: if pivot is zero.
+      if (mpfr_zero_p (piv))
+        {
+          *INFO = k + 1;  // 1-based index.
+          break;
+        }
+
+      // Pivoting: swap rows k and IPIV[k] in the panel.
+      if (IPIV[k] != k)
+        getrf_swap (A, LDA, k, IPIV[k], j0, jn, ret_ptr, ret_stride);
+
+      // Gaussian elimination.
+      for (uint64_t i = k + 1; i < M; i++)
+        {
+          // A[i][k] = A[i][k] / A[k][k];
+          double *ret = ret_ptr + (i + k * LDA) * ret_stride;
+          *ret = (double) ((int) *ret | mpfr_div (&A[i + k * LDA],
+                                                  &A[i + k * LDA],
+                                                  &A[k + k * LDA], rnd));
+        }
+      mpfr_apa_mmm_sub (&A[(k + 1) + (k + 1) * LDA], LDA,
+                        &A[(k + 1) + k * LDA], LDA,
+                        &A[k + (k + 1) * LDA], LDA,
+                        M - (k + 1), jn - (k + 1), 1, rnd,
+                        ret_ptr + ((k + 1) + (k + 1) * LDA) * ret_stride,
+                        ret_stride);
+    }
+
+  mpfr_clear (piv);
+  mpfr_clear (tmp);
+  MEX_TRACE_END ("GETRF panel");
+  return (k - j0);
+}
+
+
+/**
+ * Update the columns `A(:, c0:cn-1)` right of a factorized panel, see
+ * `mpfr_apa_GETRF` for the parameters.
+ *
+ * Apply the row interchanges of the panel, solve `L11 * U12 = A12` for the
+ * rows of the panel, and update the rows below by `A22 = A22 - L21 * U12`
+ * in parallel tasks for each tile of rows.
+ *
+ * @param j0 first row and column of the panel.
+ * @param w number of elimination steps of the panel.
+ * @param c0 first column to update.
+ * @param cn last column to update plus one.
+ */
+static void
+getrf_update (uint64_t M, mpfr_ptr A, uint64_t LDA, uint64_t j0, uint64_t w,
+              uint64_t c0, uint64_t cn, const uint64_t *IPIV, mpfr_rnd_t rnd,
+              double *ret_ptr, size_t ret_stride)
+{
+  MEX_TRACE_BEGIN ("GETRF update", "\"j0\": %d, \"c0\": %d", (int) j0,
+                   (int) c0);
+  for (uint64_t k = j0; k < j0 + w; k++)
+    if (IPIV[k] != k)
+      getrf_swap (A, LDA, k, IPIV[k], c0, cn, ret_ptr, ret_stride);
+
+  // Forward substitution with the unit lower triangular L11.
+  for (uint64_t k = j0; k < j0 + w; k++)
+    mpfr_apa_mmm_sub (&A[(k + 1) + c0 * LDA], LDA, &A[(k + 1) + k * LDA],
+                      LDA, &A[k + c0 * LDA], LDA, j0 + w - (k + 1), cn - c0,
+                      1, rnd, ret_ptr + ((k + 1) + c0 * LDA) * ret_stride,
+                      ret_stride);
+  MEX_TRACE_END ("GETRF update");
+
+  for (uint64_t i0 = j0 + w; i0 < M; i0 += GETRF_NB)
+    {
+      uint64_t mb = MIN (M - i0, (uint64_t) GETRF_NB);
+      #pragma omp task firstprivate (i0, mb)
+      {
+        MEX_TRACE_BEGIN ("GETRF gemm", "\"i0\": %d, \"c0\": %d", (int) i0,
+                         (int) c0);
+        mpfr_apa_mmm_sub (&A[i0 + c0 * LDA], LDA, &A[i0 + j0 * LDA], LDA,
+                          &A[j0 + c0 * LDA], LDA, mb, cn - c0, w, rnd,
+                          ret_ptr + (i0 + c0 * LDA) * ret_stride,
+                          ret_stride);
+        MEX_TRACE_END ("GETRF gemm");
+      }
+    }
+  #pragma omp taskwait
+}
+
+
 /**
  * MPFR LU factorization of a general M-by-N matrix A using partial pivoting
  * with row interchanges.
@@ -37,7 +196,16 @@
  * elements (lower trapezoidal if M > N), and U is upper triangular (upper
  * trapezoidal if m < n).
  *
- * This is the right-looking version of the algorithm.
+ * This is the right-looking version of the algorithm on tiles of
+ * `GETRF_NB` columns.  The factorization of each panel and the update of
+ * each tile of columns right of it are OpenMP tasks, which depend on each
+ * other by their columns.  Thus the next panel is factorized, as soon as its
+ * columns are updated, while the updates of other columns proceed.  The
+ * updates of the rows below a panel are serial cache-blocked Matrix-Matrix-
+ * Multiplications in parallel tasks.  The row interchanges of the columns
+ * left of a panel are applied at the end.  All elements are computed by the
+ * same operations in the same order as in the unblocked algorithm, thus the
+ * result does not depend on the tiles or the number of threads.
  *
  * @param M The number of rows    of the matrix @c A.  `M >= 0`.
  * @param N The number of columns of the matrix @c A.  `N >= 0`.
@@ -90,70 +258,60 @@ mpfr_apa_GETRF (uint64_t M, uint64_t N, mpfr_ptr A, uint64_t LDA,
     }
   *INFO = 0;
 
-  mpfr_t piv, tmp;
-
-  mpfr_init2 (piv, prec);
-  mpfr_init2 (tmp, prec);
+  // Panels p = 0, ..., TP-1 and tiles of columns J = 0, ..., TN-1 with the
+  // elimination steps `steps[p]` and dependency variables `col[J]`.
+  uint64_t  K     = MIN (M, N);
+  uint64_t  TP    = (K + GETRF_NB - 1) / GETRF_NB;
+  uint64_t  TN    = (N + GETRF_NB - 1) / GETRF_NB;
+  uint64_t *steps = (uint64_t *) mxMalloc ((TP + 1) * sizeof(uint64_t));
+  char *    col   = (char *) mxMalloc (TN + 1);
+  int       stop  = 0;
 
-  // Golub, Van Loan: "Matrix Computations", 4th edition, Algorithm 3.2.1
-  // with rectangular matrix modification (3.2.8, p. 118)
-  // and with pivot search in current column k.
+  mpfr_flags_t flags = 0;
+  #pragma omp parallel reduction (|:flags)
+  {
+    #pragma omp single
+    for (uint64_t p = 0; p < TP; p++)
+      {
+        uint64_t j0 = p * GETRF_NB;
+        uint64_t jn = MIN (N, j0 + GETRF_NB);
 
-  for (uint64_t k = 0; k < MIN (M, N); k++)
-    {
-      // Find pivot in column k.
-      mpfr_abs (piv, &A[k + k * LDA], rnd);
-      IPIV[k] = k;
-      for (uint64_t i = k + 1; i < M; i++)
+        #pragma omp task depend (inout: col[p]) firstprivate (j0, jn, p)
         {
-          mpfr_abs (tmp, &A[i + k * LDA], rnd);
-          if (mpfr_less_p (piv, tmp))
+          steps[p] = 0;
+          if (! stop)
             {
-              mpfr_set (piv, tmp, rnd);
-              IPIV[k] = i;
+              steps[p] = getrf_panel (M, A, LDA, j0, jn, K, IPIV, INFO, prec,
+                                      rnd, ret_ptr, ret_stride);
+              stop = (steps[p] < MIN (K, jn) - j0);
             }
         }
 
-      // STOP: if pivot is zero.
-      if (mpfr_zero_p (piv))
-        {
-          *INFO = k + 1;  // 1-based index.
-          break;
-        }
-
-      // Pivoting: swap rows k and IPIV[k] in A.
-      if (IPIV[k] != k)
-        {
-        #pragma omp parallel for
-          for (uint64_t j = 0; j < N; j++)
-            mpfr_swap (&A[k + j * LDA], &A[IPIV[k] + j * LDA]);
-        }
-
-      // Gaussian elimination.
-      for (uint64_t i = k + 1; i < M; i++)
-        {
-          // A[i][k] = A[i][k] / A[k][k];
-          int ret = (int) ret_ptr[(i + k * LDA) * ret_stride];
-          ret |= mpfr_div (&A[i + k * LDA], &A[i + k * LDA], &A[k + k * LDA],
-                           rnd);
-          ret_ptr[(i + k * LDA) * ret_stride] = (double) ret;
+        for (uint64_t J = p + 1; J < TN; J++)
+          #pragma omp task depend (in: col[p]) depend (inout: col[J]) \
+          firstprivate (j0, p, J)
+          if (steps[p] > 0)
+            getrf_update (M, A, LDA, j0, steps[p], J * GETRF_NB,
+                          MIN (N, (J + 1) * GETRF_NB), IPIV, rnd, ret_ptr,
+                          ret_stride);
+      }
+    flags |= mex_mpfr_omp_flags_collect ();
+  }
+  mpfr_flags_set (flags);
 
-          #pragma omp parallel for
-          for (uint64_t j = k + 1; j < N; j++)
-            {
-              // A[i][j] = A[i][j] - A[i][k] * A[k][j];
-              int ret = (int) ret_ptr[(i + j * LDA) * ret_stride];
-              ret |= mpfr_fms (&A[i + j * LDA],
-                               &A[i + k * LDA], &A[k + j * LDA],
-                               &A[i + j * LDA], rnd);
-              ret |= mpfr_neg (&A[i + j * LDA], &A[i + j * LDA], rnd);
-              ret_ptr[(i + j * LDA) * ret_stride] = (double) ret;
-            }
-        }
+  // Row interchanges of the later panels in the columns of L.
+  uint64_t K_done = (*INFO == 0) ? K : (uint64_t) (*INFO - 1);
+  #pragma omp parallel for schedule (dynamic, 1)
+  for (uint64_t j = 0; j < MIN (K_done, N); j++)
+    {
+      uint64_t jn = MIN (N, (j / GETRF_NB + 1) * GETRF_NB);
+      for (uint64_t k = jn; k < K_done; k++)
+        if (IPIV[k] != k)
+          getrf_swap (A, LDA, k, IPIV[k], j, j + 1, ret_ptr, ret_stride);
     }
 
-  mpfr_clear (piv);
-  mpfr_clear (tmp);
+  mxFree (col);
+  mxFree (steps);
 }
 
 
@@ -243,47 +401,61 @@ mpfr_apa_GESV (uint64_t N, uint64_t NRHS, mpfr_ptr A, uint64_t LDA,
   // Stop if not successful.
   if (*INFO != 0)
     {
-    #pragma omp parallel for
-      for (uint64_t j = 0; j < NRHS; j++)
-        for (uint64_t i = 0; i < N; i++)
-          mpfr_set_nan (&B[i + j * LDB]);
+      mpfr_flags_t flags = 0;
+      #pragma omp parallel reduction (|:flags)
+      {
+        #pragma omp for
+        for (uint64_t j = 0; j < NRHS; j++)
+          for (uint64_t i = 0; i < N; i++)
+            mpfr_set_nan (&B[i + j * LDB]);
+        flags |= mex_mpfr_omp_flags_collect ();
+      }
+      mpfr_flags_set (flags);
       return;
     }
 
   //FIXME: handle MPFR ternary return values.
 
-  // Apply pivot.
-  for (uint64_t i = 0; i < N; i++)
-    if (IPIV[i] != i)
-      for (uint64_t k = 0; k < NRHS; k++)
-        mpfr_swap (&B[i + k * LDB], &B[IPIV[i] + k * LDB]);
+  // Each column k of B is independent.  Apply pivot, forward and backward
+  // substitution.
+  MEX_TRACE_BEGIN ("GESV substitution", "\"NRHS\": %d", (int) NRHS);
+  mpfr_flags_t flags = 0;
+  #pragma omp parallel reduction (|:flags)
+  {
+    #pragma omp for schedule (dynamic, 1)
+    for (uint64_t k = 0; k < NRHS; k++)
+      {
+        for (uint64_t i = 0; i < N; i++)
+          if (IPIV[i] != i)
+            mpfr_swap (&B[i + k * LDB], &B[IPIV[i] + k * LDB]);
 
-  // For each column j of B.  Forward substitution.
-  for (uint64_t k = 0; k < NRHS; k++)
-    for (uint64_t i = 0; i < N; i++)
-      for (uint64_t j = 0; j < i; j++)
-        {
-          // B[i,k] = B[i,k] - A[i,j] * B[j,k]; OR
-          // B[i,k] = -(A[i,j] * B[j,k] - B[i,k]);
-          mpfr_fms (&B[i + k * LDB], &A[i + j * LDA], &B[j + k * LDB],
-                    &B[i + k * LDB], rnd);
-          mpfr_neg (&B[i + k * LDB], &B[i + k * LDB], rnd);
-        }
+        for (uint64_t i = 0; i < N; i++)
+          for (uint64_t j = 0; j < i; j++)
+            {
+              // B[i,k] = B[i,k] - A[i,j] * B[j,k]; OR
+              // B[i,k] = -(A[i,j] * B[j,k] - B[i,k]);
+              mpfr_fms (&B[i + k * LDB], &A[i + j * LDA], &B[j + k * LDB],
+                        &B[i + k * LDB], rnd);
+              mpfr_neg (&B[i + k * LDB], &B[i + k * LDB], rnd);
+            }
 
-  // For each column j of B.  Backward substitution.
-  for (uint64_t k = 0; k < NRHS; k++)
-    for (uint64_t i = N - 1; i < N; i--)  // Count unsigned to zero!
-      {
-        for (uint64_t j = i + 1; j < N; j++)
+        for (uint64_t i = N - 1; i < N; i--)  // Count unsigned to zero!
           {
-            // B[i,k] = B[i,k] - A[i,j] * B[j,k]; OR
-            // B[i,k] = -(A[i,j] * B[j,k] - B[i,k]);
-            mpfr_fms (&B[i + k * LDB], &A[i + j * LDA], &B[j + k * LDB],
-                      &B[i + k * LDB], rnd);
-            mpfr_neg (&B[i + k * LDB], &B[i + k * LDB], rnd);
+            for (uint64_t j = i + 1; j < N; j++)
+              {
+                // B[i,k] = B[i,k] - A[i,j] * B[j,k]; OR
+                // B[i,k] = -(A[i,j] * B[j,k] - B[i,k]);
+                mpfr_fms (&B[i + k * LDB], &A[i + j * LDA], &B[j + k * LDB],
+                          &B[i + k * LDB], rnd);
+                mpfr_neg (&B[i + k * LDB], &B[i + k * LDB], rnd);
+              }
+            // b[i] /= A[i][i];
+            mpfr_div (&B[i + k * LDB], &B[i + k * LDB], &A[i + i * LDA], rnd);
           }
-        // b[i] /= A[i][i];
-        mpfr_div (&B[i + k * LDB], &B[i + k * LDB], &A[i + i * LDA], rnd);
       }
+    flags |= mex_mpfr_omp_flags_collect ();
+  }
+  mpfr_flags_set (flags);
+  MEX_TRACE_END ("GESV substitution");
 }
 
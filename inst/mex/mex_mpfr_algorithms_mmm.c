@@ -15,8 +15,761 @@
  *  along with APA.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <float.h> // DBL_MANT_DIG
+
 #include "mex_mpfr_interface.h"
 
+// Tiles of C have at most `MMM_TILE_MN x MMM_TILE_MN` elements.  The K-block
+// size is chosen, such that the A and B tiles of a K-block fit into
+// `MMM_CACHE_BYTES`, about the L2 cache of one core.
+#define MMM_TILE_MN     16
+#define MMM_CACHE_BYTES (256 * 1024)
+
+// The residue number system uses primes below `2^RNS_PRIME_BITS`, such that
+// `RNS_CHUNK` products of residues can be summed up in 64 bits.  The residues
+// of C are computed in column blocks of at most `RNS_BLOCK_BYTES`.  See
+// `mmm_fixed_use_rns` for `RNS_MIN_DIM`.
+#define RNS_PRIME_BITS  28
+#define RNS_CHUNK       255
+#define RNS_BLOCK_BYTES (64 * 1024 * 1024)
+#define RNS_MIN_DIM     16
+
+// Default cutoff of the Strassen-Winograd recursion.
+#define MMM_STRASSEN_CUTOFF 32
+
+
+/**
+ * K-block size, such that the A and B tiles of a K-block fit into
+ * `MMM_CACHE_BYTES`.
+ *
+ * @param MB rows of the A tile.
+ * @param NB columns of the B tile.
+ * @param K Matrix dimension, the K-block does not exceed it.
+ * @param prec MPFR precision of the tile elements.
+ *
+ * @returns K-block size.
+ */
+static uint64_t
+mmm_k_block (uint64_t MB, uint64_t NB, uint64_t K, mpfr_prec_t prec)
+{
+  // An MPFR variable occupies its struct and limbs.
+  size_t   var_bytes = sizeof(mpfr_t) + mpfr_custom_get_size (prec);
+  uint64_t KB        = MMM_CACHE_BYTES / ((MB + NB) * var_bytes);
+  if (KB < 8)
+    KB = 8;
+  if (KB > K)
+    KB = K;
+  return (KB);
+}
+
+
+/**
+ * Cache-blocked MPFR Matrix-Matrix-Multiplication `C = C + A * B`.
+ *
+ * C is partitioned into tiles, which are distributed dynamically over the
+ * threads.  Each thread accumulates a tile in its own MPFR variables of
+ * precision `prec`, which are reused for all its tiles, and steps through K
+ * in blocks, such that the A and B tiles of a K-block stay in the cache.
+ * The products are accumulated in the same order as in strategy 1, thus
+ * the results are identical.
+ *
+ * See `mpfr_apa_mmm` for the parameters.
+ */
+static void
+mmm_tiled (mpfr_ptr C, mpfr_ptr A, mpfr_ptr B,
+           mpfr_prec_t prec, mpfr_rnd_t rnd,
+           uint64_t M, uint64_t N, uint64_t K,
+           double *ret_ptr, size_t ret_stride)
+{
+  // Halve the tiles until each thread gets at least one.
+  uint64_t threads = (uint64_t) omp_get_max_threads ();
+  uint64_t MB      = (M < MMM_TILE_MN) ? M : MMM_TILE_MN;
+  uint64_t NB      = (N < MMM_TILE_MN) ? N : MMM_TILE_MN;
+  while ((((M + MB - 1) / MB) * ((N + NB - 1) / NB) < threads)
+         && ((MB > 1) || (NB > 1)))
+    {
+      if (MB >= NB)
+        MB = (MB + 1) / 2;
+      else
+        NB = (NB + 1) / 2;
+    }
+  uint64_t TM = (M + MB - 1) / MB;
+  uint64_t TN = (N + NB - 1) / NB;
+
+  uint64_t KB = mmm_k_block (MB, NB, K, prec);
+  DBG_PRINTF ("tiles %d x %d of [%d x %d], K-blocks of %d\n", (int) TM,
+              (int) TN, (int) MB, (int) NB, (int) KB);
+
+  mpfr_flags_t flags = 0;
+  #pragma omp parallel reduction (|:flags)
+  {
+    mpfr_ptr acc = (mpfr_ptr) malloc (MB * NB * sizeof(mpfr_t));
+    int *    ret = (int *) malloc (MB * NB * sizeof(int));
+    for (uint64_t t = 0; t < MB * NB; t++)
+      mpfr_init2 (acc + t, prec);
+
+    // Consecutive tiles share a column panel of B.
+    #pragma omp for schedule (dynamic, 1)
+    for (uint64_t t = 0; t < TM * TN; t++)
+      {
+        uint64_t i0 = (t % TM) * MB;
+        uint64_t j0 = (t / TM) * NB;
+        uint64_t mb = (M - i0 < MB) ? (M - i0) : MB;
+        uint64_t nb = (N - j0 < NB) ? (N - j0) : NB;
+        MEX_TRACE_BEGIN ("mmm tile", "\"i\": %d, \"j\": %d", (int) i0,
+                         (int) j0);
+
+        for (uint64_t j = 0; j < nb; j++)
+          for (uint64_t i = 0; i < mb; i++)
+            ret[i + mb * j] = mpfr_set (acc + i + mb * j,
+                                        C + (i0 + i) + M * (j0 + j), rnd);
+
+        for (uint64_t k0 = 0; k0 < K; k0 += KB)
+          {
+            uint64_t kb = (K - k0 < KB) ? (K - k0) : KB;
+            for (uint64_t j = 0; j < nb; j++)
+              for (uint64_t i = 0; i < mb; i++)
+                {
+                  mpfr_ptr c = acc + i + mb * j;
+                  mpfr_ptr a = A + (i0 + i) + M * k0;
+                  mpfr_ptr b = B + k0 + K * (j0 + j);
+                  int      r = 0;
+                  for (uint64_t k = 0; k < kb; k++)
+                    r |= mpfr_fma (c, b + k, a + M * k, c, rnd);
+                  ret[i + mb * j] |= r;
+                }
+          }
+
+        for (uint64_t j = 0; j < nb; j++)
+          for (uint64_t i = 0; i < mb; i++)
+            {
+              uint64_t ij = (i0 + i) + M * (j0 + j);
+              int      r  = mpfr_set (C + ij, acc + i + mb * j, rnd);
+              ret_ptr[ij * ret_stride] = (double) (ret[i + mb * j] | r);
+            }
+        MEX_TRACE_END ("mmm tile");
+      }
+
+    for (uint64_t t = 0; t < MB * NB; t++)
+      mpfr_clear (acc + t);
+    free (ret);
+    free (acc);
+    flags |= mex_mpfr_omp_flags_collect ();
+  }
+  mpfr_flags_set (flags);
+}
+
+
+/**
+ * Integer matrices of the exact fixed-point multiplication, see
+ * `mmm_fixed_init`.
+ */
+typedef struct
+{
+  mpz_ptr    a;    // [K x M] integers of A, transposed for contiguous rows.
+  mpz_ptr    b;    // [K x N] integers of B.
+  int *      has;  // Zero, if column k of A or row k of B is zero.
+  mpfr_exp_t E;    // Common scale `2^E` of all products.
+  mpfr_exp_t W;    // All products are less than `2^W` in magnitude.
+} mmm_fixed_t;
+
+
+/**
+ * Scale MPFR matrices A and B to integer matrices for an exact
+ * Matrix-Matrix-Multiplication.
+ *
+ * Each column k of A and row k of B is scaled to a common exponent, such that
+ * `A(i,k) = a(i,k) * 2^eA(k)` and `B(k,j) = b(k,j) * 2^eB(k)` with integers
+ * @c a and @c b.  The integers of A are shifted further, such that all
+ * products `a(i,k) * b(k,j)` have the scale `2^E`.  Thus
+ * `(A * B)(i,j) = (a' * b)(i,j) * 2^E` exactly.
+ *
+ * The integers grow with the exponent range of the matrices.  If the shifted
+ * products are more than twice as wide as the product of the most precise
+ * elements of A and B, or A or B contain NaN or infinity, nothing is
+ * allocated.
+ *
+ * See `mpfr_apa_mmm` for the parameters.
+ *
+ * @param fx integer matrices, free with `mmm_fixed_clear`.
+ *
+ * @returns 1 if @c fx was initialized, 0 otherwise.
+ */
+static int
+mmm_fixed_init (mmm_fixed_t *fx, mpfr_ptr A, mpfr_ptr B,
+                uint64_t M, uint64_t N, uint64_t K)
+{
+  // Lowest (lo) and highest (hi) bit of column k of A and row k of B.
+  mpfr_exp_t *loA = (mpfr_exp_t *) mxMalloc (4 * K * sizeof(mpfr_exp_t));
+  mpfr_exp_t *hiA = loA + K;
+  mpfr_exp_t *loB = loA + 2 * K;
+  mpfr_exp_t *hiB = loA + 3 * K;
+  int *       has = (int *) mxCalloc (2 * K, sizeof(int));
+  int         singular = 0;
+  mpfr_prec_t pA = MPFR_PREC_MIN;
+  mpfr_prec_t pB = MPFR_PREC_MIN;
+
+  #pragma omp parallel for reduction (|:singular) reduction (max:pA, pB)
+  for (uint64_t k = 0; k < K; k++)
+    {
+      for (uint64_t i = 0; i < M; i++)
+        {
+          mpfr_ptr x = A + i + M * k;
+          pA = (mpfr_get_prec (x) > pA) ? mpfr_get_prec (x) : pA;
+          if (mpfr_nan_p (x) || mpfr_inf_p (x))
+            singular = 1;
+          if (! mpfr_regular_p (x))
+            continue;
+          mpfr_exp_t hi = mpfr_get_exp (x);
+          mpfr_exp_t lo = hi - mpfr_get_prec (x);
+          loA[k] = (! has[k] || (lo < loA[k])) ? lo : loA[k];
+          hiA[k] = (! has[k] || (hi > hiA[k])) ? hi : hiA[k];
+          has[k] = 1;
+        }
+      for (uint64_t j = 0; j < N; j++)
+        {
+          mpfr_ptr x = B + k + K * j;
+          pB = (mpfr_get_prec (x) > pB) ? mpfr_get_prec (x) : pB;
+          if (mpfr_nan_p (x) || mpfr_inf_p (x))
+            singular = 1;
+          if (! mpfr_regular_p (x))
+            continue;
+          mpfr_exp_t hi = mpfr_get_exp (x);
+          mpfr_exp_t lo = hi - mpfr_get_prec (x);
+          loB[k]     = (! has[K + k] || (lo < loB[k])) ? lo : loB[k];
+          hiB[k]     = (! has[K + k] || (hi > hiB[k])) ? hi : hiB[k];
+          has[K + k] = 1;
+        }
+      has[k] = has[k] && has[K + k];
+    }
+
+  // Common scale E of all products and the width W of the widest shifted
+  // product.
+  mpfr_exp_t E     = 0;
+  mpfr_exp_t W     = 0;
+  int        first = 1;
+  for (uint64_t k = 0; k < K; k++)
+    if (has[k])
+      {
+        E     = (first || (loA[k] + loB[k] < E)) ? (loA[k] + loB[k]) : E;
+        first = 0;
+      }
+  for (uint64_t k = 0; k < K; k++)
+    if (has[k])
+      {
+        mpfr_exp_t w = hiA[k] + hiB[k] - E;
+        W = (w > W) ? w : W;
+      }
+  DBG_PRINTF ("fixed-point: E = %ld, W = %ld\n", (long) E, (long) W);
+  if (singular || (W > 2 * (pA + pB)))
+    {
+      mxFree (has);
+      mxFree (loA);
+      return (0);
+    }
+
+  mpz_ptr a = (mpz_ptr) mxMalloc (M * K * sizeof(mpz_t));
+  mpz_ptr b = (mpz_ptr) mxMalloc (K * N * sizeof(mpz_t));
+
+  #pragma omp parallel for
+  for (uint64_t k = 0; k < K; k++)
+    {
+      mpfr_exp_t e;
+      for (uint64_t i = 0; i < M; i++)
+        {
+          mpz_ptr z = a + k + K * i;
+          mpz_init (z);
+          if (! has[k] || ! mpfr_regular_p (A + i + M * k))
+            continue;
+          e = mpfr_get_z_2exp (z, A + i + M * k);
+          mpz_mul_2exp (z, z, (mp_bitcnt_t) (e - E + loB[k]));
+        }
+      for (uint64_t j = 0; j < N; j++)
+        {
+          mpz_ptr z = b + k + K * j;
+          mpz_init (z);
+          if (! has[k] || ! mpfr_regular_p (B + k + K * j))
+            continue;
+          e = mpfr_get_z_2exp (z, B + k + K * j);
+          mpz_mul_2exp (z, z, (mp_bitcnt_t) (e - loB[k]));
+        }
+    }
+  mxFree (loA);
+
+  fx->a   = a;
+  fx->b   = b;
+  fx->has = has;
+  fx->E   = E;
+  fx->W   = W;
+  return (1);
+}
+
+
+/**
+ * Free the integer matrices of `mmm_fixed_init`.
+ */
+static void
+mmm_fixed_clear (mmm_fixed_t *fx, uint64_t M, uint64_t N, uint64_t K)
+{
+  #pragma omp parallel for
+  for (uint64_t k = 0; k < M * K; k++)
+    mpz_clear (fx->a + k);
+  #pragma omp parallel for
+  for (uint64_t k = 0; k < K * N; k++)
+    mpz_clear (fx->b + k);
+  mxFree (fx->b);
+  mxFree (fx->a);
+  mxFree (fx->has);
+}
+
+
+/**
+ * Add an exact integer dot product `acc * 2^E` to `c`, rounding only once.
+ *
+ * @param c MPFR variable to add to.
+ * @param t MPFR variable for the exact conversion.
+ * @param acc integer dot product.
+ * @param E scale of @c acc.
+ * @param rnd MPFR rounding mode.
+ *
+ * @returns MPFR ternary return value.
+ */
+static int
+mmm_fixed_add (mpfr_ptr c, mpfr_ptr t, mpz_srcptr acc, mpfr_exp_t E,
+               mpfr_rnd_t rnd)
+{
+  size_t bits = mpz_sizeinbase (acc, 2);
+  mpfr_set_prec (t, (bits < MPFR_PREC_MIN) ? MPFR_PREC_MIN
+                                           : (mpfr_prec_t) bits);
+  mpfr_set_z_2exp (t, acc, E, MPFR_RNDN);
+  return (mpfr_add (c, c, t, rnd));
+}
+
+
+/**
+ * Exact fixed-point MPFR Matrix-Matrix-Multiplication `C = C + A * B`.
+ *
+ * The dot products of the integer matrices of `mmm_fixed_init` are computed
+ * exactly with GMP and each element of C is rounded only once.  The result
+ * is correctly rounded, like strategy 7.
+ *
+ * See `mpfr_apa_mmm` for the parameters.
+ */
+static void
+mmm_fixed_mpz (mpfr_ptr C, mmm_fixed_t *fx, mpfr_rnd_t rnd,
+               uint64_t M, uint64_t N, uint64_t K,
+               double *ret_ptr, size_t ret_stride)
+{
+  mpfr_flags_t flags = 0;
+  #pragma omp parallel reduction (|:flags)
+  {
+    mpz_t  acc;
+    mpfr_t t;
+    mpz_init (acc);
+    mpfr_init2 (t, MPFR_PREC_MIN);
+
+    #pragma omp for collapse (2)
+    for (uint64_t j = 0; j < N; j++)
+      for (uint64_t i = 0; i < M; i++)
+        {
+          mpz_ptr ai = fx->a + K * i;
+          mpz_ptr bj = fx->b + K * j;
+          mpz_set_ui (acc, 0);
+          for (uint64_t k = 0; k < K; k++)
+            if (fx->has[k])
+              mpz_addmul (acc, ai + k, bj + k);
+          ret_ptr[(i + M * j) * ret_stride] =
+            (double) mmm_fixed_add (C + i + M * j, t, acc, fx->E, rnd);
+        }
+
+    mpfr_clear (t);
+    mpz_clear (acc);
+    flags |= mex_mpfr_omp_flags_collect ();
+  }
+  mpfr_flags_set (flags);
+}
+
+
+/**
+ * Decide whether `mmm_fixed_rns` is faster than `mmm_fixed_mpz`.
+ *
+ * For integers of L limbs and n ~ L primes, a GMP multiply-add costs
+ * O(L^2), a multiply-add in the residue number system O(n).  The conversion
+ * of each element of A and B to residues and the reconstruction of each
+ * element of C cost O(n L).  Thus the residue number system pays off, if all
+ * dimensions are large enough: `1/M + 1/N + 1/K < 1/RNS_MIN_DIM`.
+ *
+ * See `mpfr_apa_mmm` for the parameters.
+ */
+static int
+mmm_fixed_use_rns (uint64_t M, uint64_t N, uint64_t K)
+{
+  return (RNS_MIN_DIM * (M * N + N * K + M * K) < M * N * K);
+}
+
+
+/**
+ * Inverse of `a` modulo a prime `p` (extended Euclidean algorithm).
+ */
+static uint64_t
+rns_inverse (uint64_t a, uint64_t p)
+{
+  int64_t t = 0, new_t = 1;
+  int64_t r = (int64_t) p, new_r = (int64_t) (a % p);
+  while (new_r != 0)
+    {
+      int64_t q   = r / new_r;
+      int64_t tmp = t - q * new_t;
+      t     = new_t;
+      new_t = tmp;
+      tmp   = r - q * new_r;
+      r     = new_r;
+      new_r = tmp;
+    }
+  return ((uint64_t) ((t < 0) ? t + (int64_t) p : t));
+}
+
+
+/**
+ * Exact fixed-point MPFR Matrix-Matrix-Multiplication `C = C + A * B` in a
+ * residue number system (RNS).
+ *
+ * The integer matrices of `mmm_fixed_init` are reduced modulo `n` primes
+ * below `2^RNS_PRIME_BITS`, whose product exceeds twice the largest possible
+ * integer dot product.  For each prime, the residue matrices are multiplied
+ * with 64-bit integer arithmetic, the primes and columns of C in parallel.
+ * The integer dot products are reconstructed by the Chinese Remainder
+ * Theorem and rounded once to C.  The result is identical to
+ * `mmm_fixed_mpz`.
+ *
+ * See `mpfr_apa_mmm` for the parameters.
+ */
+static void
+mmm_fixed_rns (mpfr_ptr C, mmm_fixed_t *fx, mpfr_rnd_t rnd,
+               uint64_t M, uint64_t N, uint64_t K,
+               double *ret_ptr, size_t ret_stride)
+{
+  // |a' * b| < K * 2^W, one more bit for the sign.
+  uint64_t bits = (uint64_t) fx->W + 2;
+  for (uint64_t k = 1; k < K; k *= 2)
+    bits++;
+  uint64_t n = (bits + RNS_PRIME_BITS - 2) / (RNS_PRIME_BITS - 1);
+
+  // Largest primes below 2^RNS_PRIME_BITS, each greater than
+  // 2^(RNS_PRIME_BITS - 1).
+  uint64_t *p = (uint64_t *) mxMalloc (n * sizeof(uint64_t));
+  uint64_t  c = ((uint64_t) 1 << RNS_PRIME_BITS) - 1;
+  for (uint64_t q = 0; q < n; c -= 2)
+    {
+      int prime = 1;
+      for (uint64_t d = 3; prime && (d * d <= c); d += 2)
+        prime = (c % d) != 0;
+      if (prime)
+        p[q++] = c;
+    }
+
+  // Product P of all primes, P / 2, and the CRT weights `Pq[q] = P / p[q]`
+  // and `inv[q] = Pq[q]^-1 mod p[q]`.
+  mpz_t P, P_half;
+  mpz_init_set_ui (P, 1);
+  mpz_init (P_half);
+  for (uint64_t q = 0; q < n; q++)
+    mpz_mul_ui (P, P, p[q]);
+  mpz_fdiv_q_2exp (P_half, P, 1);
+  mpz_ptr   Pq  = (mpz_ptr) mxMalloc (n * sizeof(mpz_t));
+  uint64_t *inv = (uint64_t *) mxMalloc (n * sizeof(uint64_t));
+  for (uint64_t q = 0; q < n; q++)
+    {
+      mpz_init (Pq + q);
+      mpz_divexact_ui (Pq + q, P, p[q]);
+      inv[q] = rns_inverse (mpz_fdiv_ui (Pq + q, p[q]), p[q]);
+    }
+  DBG_PRINTF ("rns: %d primes for %d bits\n", (int) n, (int) bits);
+
+  // Residues of a and b for each prime: ra[q][k + K * i] and
+  // rb[q][k + K * j].
+  uint32_t *ra = (uint32_t *) mxMalloc (n * M * K * sizeof(uint32_t));
+  uint32_t *rb = (uint32_t *) mxMalloc (n * K * N * sizeof(uint32_t));
+
+  #pragma omp parallel for
+  for (uint64_t k = 0; k < M * K; k++)
+    for (uint64_t q = 0; q < n; q++)
+      ra[q * M * K + k] = (uint32_t) mpz_fdiv_ui (fx->a + k, p[q]);
+  #pragma omp parallel for
+  for (uint64_t k = 0; k < K * N; k++)
+    for (uint64_t q = 0; q < n; q++)
+      rb[q * K * N + k] = (uint32_t) mpz_fdiv_ui (fx->b + k, p[q]);
+
+  // Residues of a column block of C: rc[q][i + M * (j - j0)].
+  uint64_t NB = RNS_BLOCK_BYTES / (n * M * sizeof(uint32_t));
+  NB = (NB < 1) ? 1 : ((NB > N) ? N : NB);
+  uint32_t *rc = (uint32_t *) mxMalloc (n * M * NB * sizeof(uint32_t));
+
+  mpfr_flags_t flags = 0;
+  for (uint64_t j0 = 0; j0 < N; j0 += NB)
+    {
+      uint64_t nb = (N - j0 < NB) ? (N - j0) : NB;
+
+      // Products of residues are less than 2^(2 * RNS_PRIME_BITS), thus
+      // RNS_CHUNK of them and a residue fit into 64 bits before reduction.
+      #pragma omp parallel for collapse (2) schedule (dynamic, 1)
+      for (uint64_t q = 0; q < n; q++)
+        for (uint64_t j = 0; j < nb; j++)
+          {
+            const uint32_t *bj = rb + q * K * N + K * (j0 + j);
+            for (uint64_t i = 0; i < M; i++)
+              {
+                const uint32_t *ai  = ra + q * M * K + K * i;
+                uint64_t        acc = 0;
+                for (uint64_t k0 = 0; k0 < K; k0 += RNS_CHUNK)
+                  {
+                    uint64_t kb = (K - k0 < RNS_CHUNK) ? (K - k0) : RNS_CHUNK;
+                    uint64_t s  = acc;
+                    #pragma omp simd reduction (+:s)
+                    for (uint64_t k = k0; k < k0 + kb; k++)
+                      s += (uint64_t) ai[k] * bj[k];
+                    acc = s % p[q];
+                  }
+                rc[q * M * nb + i + M * j] = (uint32_t) acc;
+              }
+          }
+
+      #pragma omp parallel reduction (|:flags)
+      {
+        mpz_t  acc;
+        mpfr_t t;
+        mpz_init (acc);
+        mpfr_init2 (t, MPFR_PREC_MIN);
+
+        #pragma omp for
+        for (uint64_t ij = 0; ij < M * nb; ij++)
+          {
+            // acc = sum (((rc[q] * inv[q]) mod p[q]) * Pq[q]) mod P, the
+            // representative in (-P/2, P/2].
+            mpz_set_ui (acc, 0);
+            for (uint64_t q = 0; q < n; q++)
+              mpz_addmul_ui (acc, Pq + q,
+                             (rc[q * M * nb + ij] * inv[q]) % p[q]);
+            mpz_fdiv_r (acc, acc, P);
+            if (mpz_cmp (acc, P_half) > 0)
+              mpz_sub (acc, acc, P);
+            ret_ptr[(M * j0 + ij) * ret_stride] =
+              (double) mmm_fixed_add (C + M * j0 + ij, t, acc, fx->E, rnd);
+          }
+
+        mpfr_clear (t);
+        mpz_clear (acc);
+        flags |= mex_mpfr_omp_flags_collect ();
+      }
+    }
+  mpfr_flags_set (flags);
+
+  mxFree (rc);
+  mxFree (rb);
+  mxFree (ra);
+  for (uint64_t q = 0; q < n; q++)
+    mpz_clear (Pq + q);
+  mxFree (inv);
+  mxFree (Pq);
+  mpz_clear (P_half);
+  mpz_clear (P);
+  mxFree (p);
+}
+
+
+/**
+ * Pool size of MPFR temporaries for `mmm_strassen`.
+ *
+ * Each recursion level needs the sums S1..S4 and T1..T4 and the products
+ * P1..P7 of the quadrants.  The subproducts of levels `depth > 0` run as
+ * parallel tasks and need their own temporaries, the others run one after
+ * another and share them.
+ *
+ * See `mmm_strassen` for the parameters.
+ *
+ * @returns number of MPFR variables.
+ */
+static uint64_t
+mmm_strassen_pool_size (uint64_t M, uint64_t N, uint64_t K,
+                        uint64_t cutoff, int depth)
+{
+  if ((M <= cutoff) || (N <= cutoff) || (K <= cutoff))
+    return (0);
+  uint64_t m = M / 2, n = N / 2, k = K / 2;
+  uint64_t child = mmm_strassen_pool_size (m, n, k, cutoff, depth - 1);
+  return (4 * m * k + 4 * k * n + 7 * m * n + ((depth > 0) ? 7 : 1) * child);
+}
+
+
+/**
+ * `Z = X + sign * Y` for [M x N] matrices with leading dimensions.
+ *
+ * @returns MPFR ternary return value (logical OR of all return values).
+ */
+static int
+mmm_strassen_add (mpfr_ptr Z, uint64_t ldz, mpfr_ptr X, uint64_t ldx,
+                  mpfr_ptr Y, uint64_t ldy, int sign,
+                  uint64_t M, uint64_t N, mpfr_rnd_t rnd)
+{
+  int ret = 0;
+  for (uint64_t j = 0; j < N; j++)
+    for (uint64_t i = 0; i < M; i++)
+      ret |= (sign > 0)
+             ? mpfr_add (Z + i + ldz * j, X + i + ldx * j, Y + i + ldy * j,
+                         rnd)
+             : mpfr_sub (Z + i + ldz * j, X + i + ldx * j, Y + i + ldy * j,
+                         rnd);
+  return (ret);
+}
+
+
+/**
+ * `C = C + A * B` for [M x N] matrices with leading dimensions by
+ * fused multiply-adds in the order of strategy 1.
+ *
+ * @returns MPFR ternary return value (logical OR of all return values).
+ */
+static int
+mmm_strassen_fma (mpfr_ptr C, uint64_t ldc, mpfr_ptr A, uint64_t lda,
+                  mpfr_ptr B, uint64_t ldb,
+                  uint64_t M, uint64_t N, uint64_t K, mpfr_rnd_t rnd)
+{
+  int ret = 0;
+  for (uint64_t j = 0; j < N; j++)
+    for (uint64_t i = 0; i < M; i++)
+      for (uint64_t k = 0; k < K; k++)
+        ret |= mpfr_fma (C + i + ldc * j, B + k + ldb * j, A + i + lda * k,
+                         C + i + ldc * j, rnd);
+  return (ret);
+}
+
+
+/**
+ * Strassen-Winograd MPFR Matrix-Matrix-Multiplication `C = C + A * B` for
+ * matrices with leading dimensions.
+ *
+ * The even leading parts of A and B are split into quadrants, which are
+ * multiplied by 7 recursive subproducts and 15 additions (Winograd's
+ * variant), and 4 more additions accumulate the result into C.  Odd trailing rows and columns are added by fused
+ * multiply-adds.  Below the cutoff, all products are computed by fused
+ * multiply-adds.
+ *
+ * @param C [M x N] @c mpfr_ptr with leading dimension @c ldc.
+ * @param A [M x K] @c mpfr_ptr with leading dimension @c lda.
+ * @param B [K x N] @c mpfr_ptr with leading dimension @c ldb.
+ * @param rnd MPFR rounding mode for all operations.
+ * @param cutoff recursion stops, if a dimension does not exceed it.
+ * @param depth number of recursion levels, which run the subproducts as
+ *              parallel tasks.
+ * @param pool temporaries of `mmm_strassen_pool_size` MPFR variables.
+ *
+ * @returns MPFR ternary return value (logical OR of all return values).
+ */
+static int
+mmm_strassen (mpfr_ptr C, uint64_t ldc, mpfr_ptr A, uint64_t lda,
+              mpfr_ptr B, uint64_t ldb,
+              uint64_t M, uint64_t N, uint64_t K, mpfr_rnd_t rnd,
+              uint64_t cutoff, int depth, mpfr_ptr pool)
+{
+  if ((M <= cutoff) || (N <= cutoff) || (K <= cutoff))
+    return (mmm_strassen_fma (C, ldc, A, lda, B, ldb, M, N, K, rnd));
+
+  uint64_t m = M / 2, n = N / 2, k = K / 2;
+  mpfr_ptr A11 = A, A21 = A + m, A12 = A + lda * k, A22 = A + m + lda * k;
+  mpfr_ptr B11 = B, B21 = B + k, B12 = B + ldb * n, B22 = B + k + ldb * n;
+  mpfr_ptr C11 = C, C21 = C + m, C12 = C + ldc * n, C22 = C + m + ldc * n;
+
+  // Temporaries from the pool, the rest is passed to the subproducts.
+  mpfr_ptr S[4], T[4], P[7];
+  for (int i = 0; i < 4; i++)
+    {
+      S[i] = pool;
+      pool = pool + m * k;
+      T[i] = pool;
+      pool = pool + k * n;
+    }
+  for (int i = 0; i < 7; i++)
+    {
+      P[i] = pool;
+      pool = pool + m * n;
+    }
+  uint64_t child = mmm_strassen_pool_size (m, n, k, cutoff, depth - 1);
+  int      ret[14] = { 0 };
+
+  // S1 = A21 + A22, S2 = S1 - A11, S3 = A11 - A21, S4 = A12 - S2,
+  // T1 = B12 - B11, T2 = B22 - T1, T3 = B22 - B12, T4 = T2 - B21.
+  #pragma omp task shared(ret, S) if (depth > 0)
+  {
+    ret[7] |= mmm_strassen_add (S[0], m, A21, lda, A22, lda, 1, m, k, rnd);
+    ret[7] |= mmm_strassen_add (S[1], m, S[0], m, A11, lda, -1, m, k, rnd);
+    ret[7] |= mmm_strassen_add (S[2], m, A11, lda, A21, lda, -1, m, k, rnd);
+    ret[7] |= mmm_strassen_add (S[3], m, A12, lda, S[1], m, -1, m, k, rnd);
+  }
+  #pragma omp task shared(ret, T) if (depth > 0)
+  {
+    ret[8] |= mmm_strassen_add (T[0], k, B12, ldb, B11, ldb, -1, k, n, rnd);
+    ret[8] |= mmm_strassen_add (T[1], k, B22, ldb, T[0], k, -1, k, n, rnd);
+    ret[8] |= mmm_strassen_add (T[2], k, B22, ldb, B12, ldb, -1, k, n, rnd);
+    ret[8] |= mmm_strassen_add (T[3], k, T[1], k, B21, ldb, -1, k, n, rnd);
+  }
+  #pragma omp taskwait
+
+  // P1 = A11 * B11, P2 = A12 * B21, P3 = S4 * B22, P4 = A22 * T4,
+  // P5 = S1 * T1,   P6 = S2 * T2,   P7 = S3 * T3.
+  mpfr_ptr X[7]   = { A11, A12, S[3], A22, S[0], S[1], S[2] };
+  uint64_t ldx[7] = { lda, lda, m, lda, m, m, m };
+  mpfr_ptr Y[7]   = { B11, B21, B22, T[3], T[0], T[1], T[2] };
+  uint64_t ldy[7] = { ldb, ldb, ldb, k, k, k, k };
+  for (int i = 0; i < 7; i++)
+    {
+      mpfr_ptr pool_i = pool + ((depth > 0) ? i * child : 0);
+      #pragma omp task shared(ret, X, ldx, Y, ldy, P) if (depth > 0)
+      {
+        for (uint64_t ij = 0; ij < m * n; ij++)
+          mpfr_set_zero (P[i] + ij, 1);
+        ret[i] = mmm_strassen (P[i], m, X[i], ldx[i], Y[i], ldy[i], m, n, k,
+                               rnd, cutoff, depth - 1, pool_i);
+      }
+    }
+  #pragma omp taskwait
+
+  // U2 = P1 + P6, U3 = U2 + P7, U4 = U2 + P5, and
+  // C11 += P1 + P2, C12 += U4 + P3, C21 += U3 - P4, C22 += U3 + P5.
+  ret[9] |= mmm_strassen_add (P[5], m, P[0], m, P[5], m, 1, m, n, rnd);
+  ret[9] |= mmm_strassen_add (P[6], m, P[5], m, P[6], m, 1, m, n, rnd);
+  ret[9] |= mmm_strassen_add (P[5], m, P[5], m, P[4], m, 1, m, n, rnd);
+  mpfr_ptr Cq[4]  = { C11, C12, C21, C22 };
+  mpfr_ptr U[4]   = { P[0], P[5], P[6], P[6] };
+  mpfr_ptr V[4]   = { P[1], P[2], P[3], P[4] };
+  int      sgn[4] = { 1, 1, -1, 1 };
+  for (int q = 0; q < 4; q++)
+    #pragma omp task shared(ret, Cq, U, V, sgn) if (depth > 0)
+    {
+      ret[10 + q] |= mmm_strassen_add (Cq[q], ldc, Cq[q], ldc, U[q], m, 1,
+                                       m, n, rnd);
+      ret[10 + q] |= mmm_strassen_add (Cq[q], ldc, Cq[q], ldc, V[q], m,
+                                       sgn[q], m, n, rnd);
+    }
+  #pragma omp taskwait
+
+  // Odd K: C(1:2m,1:2n) += A(1:2m,K) * B(K,1:2n).  Odd M: last row of C.
+  // Odd N: last column of C.
+  int r = 0;
+  if (K % 2)
+    r |= mmm_strassen_fma (C, ldc, A + lda * (K - 1), lda, B + (K - 1), ldb,
+                           2 * m, 2 * n, 1, rnd);
+  if (M % 2)
+    r |= mmm_strassen_fma (C + (M - 1), ldc, A + (M - 1), lda, B, ldb,
+                           1, N, K, rnd);
+  if (N % 2)
+    r |= mmm_strassen_fma (C + ldc * (N - 1), ldc, A, lda, B + ldb * (N - 1),
+                           ldb, 2 * m, 1, K, rnd);
+  for (int i = 0; i < 14; i++)
+    r |= ret[i];
+  return (r);
+}
+
+
 /**
  * MPFR Matrix-Matrix-Multiplication `C = A * B`.
  *
@@ -40,6 +793,7 @@ mpfr_apa_mmm (mpfr_ptr C, mpfr_ptr A, mpfr_ptr B,
               uint64_t M, uint64_t N, uint64_t K,
               double *ret_ptr, size_t ret_stride, uint64_t strategy)
 {
+  mpfr_flags_t flags = 0;
   switch (strategy)
     {
       case 1:  // plain for-loop ijk
@@ -73,42 +827,10 @@ mpfr_apa_mmm (mpfr_ptr C, mpfr_ptr A, mpfr_ptr B,
 
 
       case 3: // 1 omp for-loop ijk
-        #pragma omp parallel for
-        for (uint64_t i = 0; i < M; i++)
-          for (uint64_t j = 0; j < N; j++)
-            {
-              int ret = 0;
-              for (uint64_t k = 0; k < K; k++)
-                ret |= mpfr_fma (C + (M * j) + i,
-                                 B + k + (K * j),
-                                 A + i + (M * k),
-                                 C + (M * j) + i, rnd);
-              ret_ptr[((M * j) + i) * ret_stride] = (double) ret;
-            }
-        break;
-
-
-      case 4:  // 1 omp for-loop jik
-        #pragma omp parallel for
-        for (uint64_t j = 0; j < N; j++)
+        #pragma omp parallel reduction (|:flags)
+        {
+          #pragma omp for
           for (uint64_t i = 0; i < M; i++)
-            {
-              int ret = 0;
-              for (uint64_t k = 0; k < K; k++)
-                ret |= mpfr_fma (C + (M * j) + i,
-                                 B + k + (K * j),
-                                 A + i + (M * k),
-                                 C + (M * j) + i, rnd);
-              ret_ptr[((M * j) + i) * ret_stride] = (double) ret;
-            }
-        break;
-
-
-      case 5:  // 2 omp for-loops ijk
-        #pragma omp parallel for
-        for (uint64_t i = 0; i < M; i++)
-          {
-            #pragma omp parallel for
             for (uint64_t j = 0; j < N; j++)
               {
                 int ret = 0;
@@ -119,14 +841,16 @@ mpfr_apa_mmm (mpfr_ptr C, mpfr_ptr A, mpfr_ptr B,
                                    C + (M * j) + i, rnd);
                 ret_ptr[((M * j) + i) * ret_stride] = (double) ret;
               }
-          }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
         break;
 
-      case 6:  // 2 omp for-loops jik
-        #pragma omp parallel for
-        for (uint64_t j = 0; j < N; j++)
-          {
-            #pragma omp parallel for
+
+      case 4:  // 1 omp for-loop jik
+        #pragma omp parallel reduction (|:flags)
+        {
+          #pragma omp for
+          for (uint64_t j = 0; j < N; j++)
             for (uint64_t i = 0; i < M; i++)
               {
                 int ret = 0;
@@ -137,41 +861,112 @@ mpfr_apa_mmm (mpfr_ptr C, mpfr_ptr A, mpfr_ptr B,
                                    C + (M * j) + i, rnd);
                 ret_ptr[((M * j) + i) * ret_stride] = (double) ret;
               }
-          }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        break;
+
+
+      case 5:  // 2 omp for-loops ijk
+        #pragma omp parallel reduction (|:flags)
+        {
+          #pragma omp for
+          for (uint64_t i = 0; i < M; i++)
+            {
+              #pragma omp parallel reduction (|:flags)
+              {
+                #pragma omp for
+                for (uint64_t j = 0; j < N; j++)
+                  {
+                    int ret = 0;
+                    for (uint64_t k = 0; k < K; k++)
+                      ret |= mpfr_fma (C + (M * j) + i,
+                                       B + k + (K * j),
+                                       A + i + (M * k),
+                                       C + (M * j) + i, rnd);
+                    ret_ptr[((M * j) + i) * ret_stride] = (double) ret;
+                  }
+                flags |= mex_mpfr_omp_flags_collect ();
+              }
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        break;
+
+      case 6:  // 2 omp for-loops jik
+        #pragma omp parallel reduction (|:flags)
+        {
+          #pragma omp for
+          for (uint64_t j = 0; j < N; j++)
+            {
+              #pragma omp parallel reduction (|:flags)
+              {
+                #pragma omp for
+                for (uint64_t i = 0; i < M; i++)
+                  {
+                    int ret = 0;
+                    for (uint64_t k = 0; k < K; k++)
+                      ret |= mpfr_fma (C + (M * j) + i,
+                                       B + k + (K * j),
+                                       A + i + (M * k),
+                                       C + (M * j) + i, rnd);
+                    ret_ptr[((M * j) + i) * ret_stride] = (double) ret;
+                  }
+                flags |= mex_mpfr_omp_flags_collect ();
+              }
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
         break;
 
 
-      case 7:  // 2 omp for-loops ijk, copy transpose A
+      case 7:  // 2 omp for-loops ijk, copy transpose A, exact dot products
       {
-        // If A is a M=1 x K vector, no copy and i-loop necessary.
+        // If A is a M=1 x K vector, no copy and i-loop necessary.  A single
+        // dot product is parallelized by itself.
         if (M == 1)
           {
-            #pragma omp parallel for
-            for (uint64_t j = 0; j < N; j++)
-              ret_ptr[j * ret_stride] = (double) mpfr_apa_dot (C + j,
-                                                               A, B + (K * j),
-                                                               K, prec, rnd);
+            #pragma omp parallel if (N > 1) reduction (|:flags)
+            {
+              #pragma omp for
+              for (uint64_t j = 0; j < N; j++)
+                ret_ptr[j * ret_stride] = (double) mpfr_apa_dot (
+                  C + j, A, B + (K * j), K, rnd);
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
             break;  // Finished
           }
 
-        // Memory for row i of matrix A.
+        // Memory for row i of matrix A.  The copy must not round, thus the
+        // maximum precision of A.
+        mpfr_prec_t precA = MPFR_PREC_MIN;
+        for (uint64_t k = 0; k < M * K; k++)
+          precA = (mpfr_get_prec (A + k) > precA) ? mpfr_get_prec (A + k)
+                                                  : precA;
         mpfr_ptr Ai = (mpfr_ptr) mxMalloc (K * sizeof(mpfr_t));
         #pragma omp parallel for
         for (uint64_t k = 0; k < K; k++)
-          mpfr_init2 (Ai + k, prec);
+          mpfr_init2 (Ai + k, precA);
 
-        // For each row of A and C.
+        // For each row of A and C.  The phases of each thread are traced
+        // before the barriers to show idle threads.
         for (uint64_t i = 0; i < M; i++)
+          #pragma omp parallel reduction (|:flags)
           {
             // Copy row Ai.
-            #pragma omp parallel for
+            MEX_TRACE_BEGIN ("mmm copy row", "\"i\": %d", (int) i);
+            #pragma omp for nowait
             for (uint64_t k = 0; k < K; k++)
-              mpfr_set (Ai + k, A + i + (M * k), rnd);
+              mpfr_set (Ai + k, A + i + (M * k), MPFR_RNDN);
+            MEX_TRACE_END ("mmm copy row");
+            #pragma omp barrier
 
-            #pragma omp parallel for
+            MEX_TRACE_BEGIN ("mmm dot", "\"i\": %d", (int) i);
+            #pragma omp for nowait
             for (uint64_t j = 0; j < N; j++)
               ret_ptr[((M * j) + i) * ret_stride] = (double) mpfr_apa_dot (
-                C + (M * j) + i, Ai, B + (K * j), K, prec, rnd);
+                C + (M * j) + i, Ai, B + (K * j), K, rnd);
+            MEX_TRACE_END ("mmm dot");
+            flags |= mex_mpfr_omp_flags_collect ();
           }
 
         // Return memory of Ai
@@ -182,8 +977,294 @@ mpfr_apa_mmm (mpfr_ptr C, mpfr_ptr A, mpfr_ptr B,
       break;
 
 
+      case 8:  // cache-blocked tiles of C
+        mmm_tiled (C, A, B, prec, rnd, M, N, K, ret_ptr, ret_stride);
+        break;
+
+
+      case 9:   // exact fixed-point integer products, fallback to strategy 7
+      case 10:  // like 9, always in a residue number system (RNS)
+      {
+        mmm_fixed_t fx;
+        if (! mmm_fixed_init (&fx, A, B, M, N, K))
+          {
+            mpfr_apa_mmm (C, A, B, prec, rnd, M, N, K, ret_ptr, ret_stride, 7);
+            break;
+          }
+        if ((strategy == 10) || mmm_fixed_use_rns (M, N, K))
+          mmm_fixed_rns (C, &fx, rnd, M, N, K, ret_ptr, ret_stride);
+        else
+          mmm_fixed_mpz (C, &fx, rnd, M, N, K, ret_ptr, ret_stride);
+        mmm_fixed_clear (&fx, M, N, K);
+      }
+      break;
+
+
+      case 11:  // Strassen-Winograd recursion
+        mpfr_apa_mmm_strassen (C, A, B, prec, rnd, M, N, K, ret_ptr,
+                               ret_stride, 0);
+        break;
+
+
       default:
         MEX_FCN_ERR ("mpfr_mmm: invalid strategy '%d'\n", (int) strategy);
     }
+  mpfr_flags_set (flags);
+}
+
+
+/**
+ * Strassen-Winograd MPFR Matrix-Matrix-Multiplication `C = C + A * B`.
+ *
+ * The recursion saves one of eight multiplications per level for 19
+ * additions of quadrants, see `mmm_strassen`.  The errors grow faster than
+ * for the plain products.  The seven subproducts of the top level run as
+ * parallel tasks, each with its own temporaries for the levels below.  All
+ * temporaries of precision @c prec are allocated at once.
+ *
+ * @param C [M x N] @c mpfr_ptr indexed by (i,j).
+ * @param A [M x K] @c mpfr_ptr indexed by (i,k).
+ * @param B [K x N] @c mpfr_ptr indexed by (k,j).
+ * @param prec MPFR precision for intermediate operations.
+ * @param rnd MPFR rounding mode for all operations.
+ * @param M Matrix dimension (see above).
+ * @param N Matrix dimension (see above).
+ * @param K Matrix dimension (see above).
+ * @param ret_ptr pointer to array of MPFR return values.  All elements are
+ *                the logical OR of all return values.
+ * @param ret_stride equals 1, if the array of MPFR return values should be
+ *                   filled and has the same size as C.  Otherwise 0 for
+ *                   scalar (ignored) return value.
+ * @param cutoff recursion stops, if a dimension does not exceed it.
+ *               0 selects the default.
+ */
+void
+mpfr_apa_mmm_strassen (mpfr_ptr C, mpfr_ptr A, mpfr_ptr B,
+                       mpfr_prec_t prec, mpfr_rnd_t rnd,
+                       uint64_t M, uint64_t N, uint64_t K,
+                       double *ret_ptr, size_t ret_stride, uint64_t cutoff)
+{
+  if (cutoff == 0)
+    cutoff = MMM_STRASSEN_CUTOFF;
+
+  // Only the top level runs parallel tasks.  Each further level would need
+  // seven more copies of the temporaries below it.
+  int depth = (omp_get_max_threads () > 1) ? 1 : 0;
+
+  uint64_t size = mmm_strassen_pool_size (M, N, K, cutoff, depth);
+  mpfr_ptr pool = (mpfr_ptr) mxMalloc ((size + 1) * sizeof(mpfr_t));
+  DBG_PRINTF ("strassen: cutoff = %d, depth = %d, pool = %d\n",
+              (int) cutoff, depth, (int) size);
+  for (uint64_t i = 0; i < size; i++)
+    mpfr_init2 (pool + i, prec);
+
+  int          ret   = 0;
+  mpfr_flags_t flags = 0;
+  #pragma omp parallel reduction (|:flags)
+  {
+    #pragma omp single
+    ret = mmm_strassen (C, M, A, M, B, K, M, N, K, rnd, cutoff, depth, pool);
+    flags |= mex_mpfr_omp_flags_collect ();
+  }
+  mpfr_flags_set (flags);
+
+  for (uint64_t i = 0; i < M * N; i++)
+    ret_ptr[i * ret_stride] = (double) ret;
+  for (uint64_t i = 0; i < size; i++)
+    mpfr_clear (pool + i);
+  mxFree (pool);
+}
+
+
+
+
+/**
+ * MPFR Matrix-Matrix-Multiplication with a double matrix D, either
+ * `C = X * D` or `C = D * X`, correctly rounded.
+ *
+ * The double operand is not converted to the precision of X.  Each double
+ * is copied exactly once to a variable of precision 53 (`DBL_MANT_DIG`) with
+ * all limbs in a single block, which saves the conversion of `mpfr_mul_d` in
+ * each product.  Each product `x * d` is exact in a variable of precision
+ * `px + 53`, where `px` is the maximum precision of X, and each element of
+ * C is rounded once by `mpfr_sum`.  Each thread reuses its own K product
+ * variables for all elements of C.
+ *
+ * @param C [M x N] @c mpfr_ptr indexed by (i,j).
+ * @param X [M x K] (if @c d_left is 0) or [K x N] (otherwise) @c mpfr_ptr.
+ * @param D [K x N] (if @c d_left is 0) or [M x K] (otherwise) double matrix.
+ * @param d_left 0 for `C = X * D`, otherwise `C = D * X`.
+ * @param rnd MPFR rounding mode of the elements of C.
+ * @param M Matrix dimension (see above).
+ * @param N Matrix dimension (see above).
+ * @param K Matrix dimension (see above).
+ * @param ret_ptr pointer to array of MPFR return values.
+ * @param ret_stride equals 1, if the array of MPFR return values should be
+ *                   filled and has the same size as C.  Otherwise 0 for
+ *                   scalar (ignored) return value.
+ */
+void
+mpfr_apa_mmm_d (mpfr_ptr C, mpfr_ptr X, const double *D, int d_left,
+                mpfr_rnd_t rnd, uint64_t M, uint64_t N, uint64_t K,
+                double *ret_ptr, size_t ret_stride)
+{
+  uint64_t MN = M * N;
+  if (MN == 0)
+    return;
+
+  // The products are exact with `DBL_MANT_DIG` more bits.
+  uint64_t    nx = (d_left ? N : M) * K;
+  uint64_t    nd = (d_left ? M : N) * K;
+  mpfr_prec_t px = MPFR_PREC_MIN;
+  for (uint64_t k = 0; k < nx; k++)
+    px = (mpfr_get_prec (X + k) > px) ? mpfr_get_prec (X + k) : px;
+  mpfr_prec_t prec = px + DBL_MANT_DIG;
+
+  size_t   dsize = mpfr_custom_get_size (DBL_MANT_DIG);
+  mpfr_ptr Dm    = (mpfr_ptr) mxMalloc (nd * sizeof(mpfr_t));
+  char *   limbs = (char *) mxMalloc (nd * dsize);
+
+  // Row (i) and column (j) offsets and the k-stride of both operands.
+  uint64_t xi = d_left ? 0 : 1;
+  uint64_t xj = d_left ? K : 0;
+  uint64_t xk = d_left ? 1 : M;
+  uint64_t di = d_left ? 1 : 0;
+  uint64_t dj = d_left ? 0 : K;
+  uint64_t dk = d_left ? M : 1;
+
+  // A single element of C (inner product) parallelizes the products.
+  int          outer = (MN > 1);
+  mpfr_ptr     p     = (mpfr_ptr) mxMalloc (K * sizeof(mpfr_t));
+  mpfr_ptr *   tab   = (mpfr_ptr *) mxMalloc (K * sizeof(mpfr_ptr));
+  mpfr_flags_t flags = 0;
+  #pragma omp parallel reduction (|:flags)
+  {
+    #pragma omp for schedule (static)
+    for (uint64_t k = 0; k < nd; k++)
+      {
+        mpfr_custom_init (limbs + k * dsize, DBL_MANT_DIG);
+        mpfr_custom_init_set (Dm + k, MPFR_ZERO_KIND, 0, DBL_MANT_DIG,
+                              limbs + k * dsize);
+        mpfr_set_d (Dm + k, D[k], MPFR_RNDN);
+      }
+
+    if (outer)
+      {
+        mpfr_ptr  pt   = (mpfr_ptr) malloc (K * sizeof(mpfr_t));
+        mpfr_ptr *tabt = (mpfr_ptr *) malloc (K * sizeof(mpfr_ptr));
+        for (uint64_t k = 0; k < K; k++)
+          {
+            mpfr_init2 (pt + k, prec);
+            tabt[k] = pt + k;
+          }
+
+        #pragma omp for schedule (static)
+        for (uint64_t ij = 0; ij < MN; ij++)
+          {
+            uint64_t i = ij % M;
+            uint64_t j = ij / M;
+            mpfr_ptr x = X + (xi * i) + (xj * j);
+            mpfr_ptr d = Dm + (di * i) + (dj * j);
+            for (uint64_t k = 0; k < K; k++)
+              mpfr_mul (pt + k, x + (xk * k), d + (dk * k), MPFR_RNDN);
+            ret_ptr[ij * ret_stride] = (double) mpfr_sum (C + ij, tabt, K,
+                                                          rnd);
+          }
+
+        for (uint64_t k = 0; k < K; k++)
+          mpfr_clear (pt + k);
+        free (tabt);
+        free (pt);
+      }
+    else
+      {
+        #pragma omp for schedule (static)
+        for (uint64_t k = 0; k < K; k++)
+          {
+            mpfr_init2 (p + k, prec);
+            mpfr_mul (p + k, X + (xk * k), Dm + (dk * k), MPFR_RNDN);
+            tab[k] = p + k;
+          }
+      }
+    flags |= mex_mpfr_omp_flags_collect ();
+  }
+  mpfr_flags_set (flags);
+
+  if (! outer)
+    {
+      ret_ptr[0] = (double) mpfr_sum (C, tab, K, rnd);
+      for (uint64_t k = 0; k < K; k++)
+        mpfr_clear (p + k);
+    }
+  mxFree (tab);
+  mxFree (p);
+  mxFree (limbs);
+  mxFree (Dm);
 }
 
+
+/**
+ * Serial cache-blocked MPFR Matrix-Matrix-Multiplication update
+ * `C = C - A * B` of submatrices in place, for example in a task.
+ *
+ * C is processed in tiles and K in blocks like in strategy 8.  Each
+ * element of C is updated by `c = -(a * b - c)` for `k = 0, ..., K-1` in
+ * this order and rounded to its own precision, thus the result equals the
+ * updates of an unblocked Gaussian elimination.
+ *
+ * @param C [M x N] @c mpfr_ptr with leading dimension @c LDC.
+ * @param LDC leading dimension of @c C.
+ * @param A [M x K] @c mpfr_ptr with leading dimension @c LDA.
+ * @param LDA leading dimension of @c A.
+ * @param B [K x N] @c mpfr_ptr with leading dimension @c LDB.
+ * @param LDB leading dimension of @c B.
+ * @param M Matrix dimension (see above).
+ * @param N Matrix dimension (see above).
+ * @param K Matrix dimension (see above).
+ * @param rnd MPFR rounding mode for all operations.
+ * @param ret_ptr pointer to array of MPFR return values with leading
+ *                dimension @c LDC.  The return values of the updates are
+ *                ORed to them.
+ * @param ret_stride equals 1, if the array of MPFR return values should be
+ *                   filled and has the same size as C.  Otherwise 0 for
+ *                   scalar (ignored) return value.
+ */
+void
+mpfr_apa_mmm_sub (mpfr_ptr C, uint64_t LDC, mpfr_ptr A, uint64_t LDA,
+                  mpfr_ptr B, uint64_t LDB, uint64_t M, uint64_t N,
+                  uint64_t K, mpfr_rnd_t rnd, double *ret_ptr,
+                  size_t ret_stride)
+{
+  if ((M == 0) || (N == 0) || (K == 0))
+    return;
+
+  uint64_t MB = (M < MMM_TILE_MN) ? M : MMM_TILE_MN;
+  uint64_t NB = (N < MMM_TILE_MN) ? N : MMM_TILE_MN;
+  uint64_t KB = mmm_k_block (MB, NB, K, mpfr_get_prec (C));
+
+  for (uint64_t j0 = 0; j0 < N; j0 += NB)
+    for (uint64_t i0 = 0; i0 < M; i0 += MB)
+      {
+        uint64_t mb = (M - i0 < MB) ? (M - i0) : MB;
+        uint64_t nb = (N - j0 < NB) ? (N - j0) : NB;
+        for (uint64_t k0 = 0; k0 < K; k0 += KB)
+          {
+            uint64_t kb = (K - k0 < KB) ? (K - k0) : KB;
+            for (uint64_t j = j0; j < j0 + nb; j++)
+              for (uint64_t i = i0; i < i0 + mb; i++)
+                {
+                  mpfr_ptr c = C + i + LDC * j;
+                  mpfr_ptr a = A + i + LDA * k0;
+                  mpfr_ptr b = B + k0 + LDB * j;
+                  int      r = 0;
+                  for (uint64_t k = 0; k < kb; k++)
+                    {
+                      r |= mpfr_fms (c, a + LDA * k, b + k, c, rnd);
+                      r |= mpfr_neg (c, c, rnd);
+                    }
+                  double *ret = ret_ptr + (i + LDC * j) * ret_stride;
+                  *ret = (double) ((int) *ret | r);
+                }
+          }
+      }
+}
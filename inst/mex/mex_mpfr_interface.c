@@ -21,6 +21,12 @@
   ({ __typeof__(a)_a = (a); __typeof__(b)_b = (b); \
      _a > _b ? _a : _b; })
 
+// Maximal number of arguments of a command buffer record.
+#define CMDBUF_MAX_ARGS 8
+
+// Number of values of a command buffer argument of kind `kind`.
+#define CMDBUF_ARG_LEN(kind) (((kind) == 2.0) ? (size_t) 2 : (size_t) 1)
+
 
 /**
  * Octave/Matlab MEX interface for MPFR.
@@ -40,6 +46,11 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
   # error "Oldest supported MPFR version is 4.0.0."
   #endif
 
+  // Commands run their loops in parallel, unless planned by the first MPFR
+  // variable argument `rop` in `MEX_MPFR_T`.
+  mex_omp_par = 1;
+  omp_set_schedule (omp_sched_static, 0);
+
   switch (cmd_code)
     {
       /**
@@ -60,17 +71,23 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         return;
       }
 
-      case 1902: // idx_t mpfr_t.allocate (size_t count)
+      case 1902: // idx_t mpfr_t.allocate (size_t count, mpfr_prec_t prec)
       {
-        MEX_NARGINCHK (2);
+        if ((nrhs < 2) || (nrhs > 3))
+          MEX_FCN_ERR ("cmd[%d]: Invalid number of arguments.\n", cmd_code);
         uint64_t count = 0;
         if (! extract_ui (1, nrhs, prhs, &count) || (count == 0))
           MEX_FCN_ERR ("cmd[%s]: Count must be a positive numeric scalar.\n",
                        "mpfr_t.allocate");
+        mpfr_prec_t prec = mpfr_get_default_prec ();
+        if ((nrhs == 3) && ! extract_prec (2, nrhs, prhs, &prec))
+          MEX_FCN_ERR ("cmd[%s]: Precision must be a numeric scalar between "
+                       "%ld and %ld.\n", "mpfr_t.allocate", MPFR_PREC_MIN,
+                       MPFR_PREC_MAX);
 
         DBG_PRINTF ("allocate '%d' new MPFR variables\n", (int) count);
         idx_t idx;
-        if (! mex_mpfr_allocate ((size_t) count, &idx))
+        if (! mex_mpfr_allocate ((size_t) count, prec, &idx))
           MEX_FCN_ERR ("%s\n", "Memory allocation failed.");
         // Return start and end indices (1-based).
         plhs[0] = mxCreateNumericMatrix (2, 1, mxDOUBLE_CLASS, mxREAL);
@@ -94,6 +111,397 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         return;
       }
 
+      case 1904: // size_t mpfr_t.allocate_handle (size_t count, mpfr_prec_t prec)
+      {
+        MEX_NARGINCHK (3);
+        uint64_t count = 0;
+        if (! extract_ui (1, nrhs, prhs, &count) || (count == 0))
+          MEX_FCN_ERR ("cmd[%s]: Count must be a positive numeric scalar.\n",
+                       "mpfr_t.allocate_handle");
+        MEX_MPFR_PREC_T (2, prec);
+
+        size_t handle = 0;
+        if (! mex_mpfr_handle_new ((size_t) count, prec, &handle))
+          MEX_FCN_ERR ("%s\n", "Memory allocation failed.");
+        // Handles are uint64 scalars, such that `extract_idx` can tell them
+        // apart from numeric scalars.
+        plhs[0] = mxCreateNumericMatrix (1, 1, mxUINT64_CLASS, mxREAL);
+        ((uint64_t *) mxGetData (plhs[0]))[0] = (uint64_t) handle;
+        return;
+      }
+
+      case 1905: // idx_t mpfr_t.get_idx (size_t handle)
+      {
+        MEX_NARGINCHK (2);
+        uint64_t handle = 0;
+        idx_t    idx;
+        if (! extract_ui (1, nrhs, prhs, &handle)
+            || ! mex_mpfr_handle_get ((size_t) handle, &idx))
+          MEX_FCN_ERR ("cmd[%s]: Invalid handle.\n", "mpfr_t.get_idx");
+        // Return start and end indices (1-based).
+        plhs[0] = mxCreateNumericMatrix (2, 1, mxDOUBLE_CLASS, mxREAL);
+        double *ptr = mxGetPr (plhs[0]);
+        ptr[0] = (double) idx.start;
+        ptr[1] = (double) idx.end;
+        return;
+      }
+
+      case 1906: // void mpfr_t.free_handle (size_t handle)
+      {
+        // Check if MPFR memory is (already) cleared.
+        if ((mpfr_data_capacity <= 0) && (mpfr_data_size <= 0))
+          return;
+
+        MEX_NARGINCHK (2);
+        uint64_t handle = 0;
+        idx_t    idx;
+        if (! extract_ui (1, nrhs, prhs, &handle)
+            || ! mex_mpfr_handle_get ((size_t) handle, &idx))
+          MEX_FCN_ERR ("cmd[%s]: Invalid handle.\n", "mpfr_t.free_handle");
+        DBG_PRINTF ("cmd[mpfr_t.free_handle]: [%d:%d] will be marked as free\n",
+                    idx.start, idx.end);
+        mex_mpfr_handle_free ((size_t) handle);
+        return;
+      }
+
+      case 1907: // size_t mpfr_t.compact (void)
+      {
+        MEX_NARGINCHK (1);
+        plhs[0] = mxCreateDoubleScalar ((double) mex_mpfr_compact ());
+        return;
+      }
+
+      case 1908: // struct mpfr_t.get_pool_stats (int reset)
+      {
+        if ((nrhs < 1) || (nrhs > 2))
+          MEX_FCN_ERR ("cmd[%d]: Invalid number of arguments.\n", cmd_code);
+        int64_t reset = 0;
+        if ((nrhs == 2) && ! extract_si (1, nrhs, prhs, &reset))
+          MEX_FCN_ERR ("cmd[%s]: RESET must be a numeric scalar.\n",
+                       "mpfr_t.get_pool_stats");
+
+        // Precision histogram as matrix `[prec, variables, bytes]`.
+        mpfr_prec_t *prec      = NULL;
+        size_t      *count     = NULL;
+        size_t       num_precs = mex_mpfr_get_prec_histogram (&prec, &count);
+        if (num_precs == SIZE_MAX)
+          MEX_FCN_ERR ("cmd[%s]: Memory allocation failed.\n",
+                       "mpfr_t.get_pool_stats");
+        mxArray *hist = mxCreateNumericMatrix (num_precs, 3, mxDOUBLE_CLASS,
+                                               mxREAL);
+        double *ptr = mxGetPr (hist);
+        for (size_t i = 0; i < num_precs; i++)
+          {
+            ptr[i]                 = (double) prec[i];
+            ptr[i + num_precs]     = (double) count[i];
+            ptr[i + 2 * num_precs] = (double) count[i]
+                                     * (double) mpfr_custom_get_size (prec[i]);
+          }
+        mxFree (prec);
+        mxFree (count);
+
+        mpfr_pool_stats_t stats = mex_mpfr_get_pool_stats (reset != 0);
+        const char *fnames[] = {"live_variables", "live_high_water",
+                                "data_size", "data_size_high_water",
+                                "data_capacity", "segments", "handles",
+                                "free_ranges", "free_variables",
+                                "largest_free_range", "allocations", "frees",
+                                "limb_bytes", "limb_bytes_by_prec"};
+        double      fvals[]  = {(double) stats.live_variables,
+                                (double) stats.live_high_water,
+                                (double) stats.data_size,
+                                (double) stats.data_size_high_water,
+                                (double) stats.data_capacity,
+                                (double) stats.segments,
+                                (double) stats.handles,
+                                (double) stats.free_ranges,
+                                (double) stats.free_variables,
+                                (double) stats.largest_free_range,
+                                (double) stats.allocations,
+                                (double) stats.frees,
+                                (double) stats.limb_bytes};
+        plhs[0] = mxCreateStructMatrix (1, 1, 14, fnames);
+        for (int i = 0; i < 13; i++)
+          mxSetFieldByNumber (plhs[0], 0, i, mxCreateDoubleScalar (fvals[i]));
+        mxSetFieldByNumber (plhs[0], 0, 13, hist);
+        return;
+      }
+
+      case 1909: // size_t[] mpfr_t.allocate_handles (size_t[] count, mpfr_prec_t[] prec)
+      {
+        MEX_NARGINCHK (3);
+        size_t    num      = mxGetM (prhs[1]) * mxGetN (prhs[1]);
+        size_t    num_prec = mxGetM (prhs[2]) * mxGetN (prhs[2]);
+        uint64_t *count_ui = NULL;
+        uint64_t *prec_ui  = NULL;
+        if ((num == 0) || ! extract_ui_vector (1, nrhs, prhs, &count_ui, num))
+          MEX_FCN_ERR ("cmd[%s]: Count must be a vector of positive "
+                       "integers.\n", "mpfr_t.allocate_handles");
+        if (((num_prec != 1) && (num_prec != num))
+            || ! extract_ui_vector (2, nrhs, prhs, &prec_ui, num_prec))
+          MEX_FCN_ERR ("cmd[%s]: Precision must be a scalar or a vector "
+                       "like count.\n", "mpfr_t.allocate_handles");
+
+        size_t      *count  = (size_t *) mxMalloc (num * sizeof(size_t));
+        mpfr_prec_t *prec   = (mpfr_prec_t *) mxMalloc (num
+                                                        * sizeof(mpfr_prec_t));
+        size_t      *handle = (size_t *) mxMalloc (num * sizeof(size_t));
+        for (size_t i = 0; i < num; i++)
+          {
+            uint64_t p = prec_ui[(num_prec == 1) ? 0 : i];
+            if ((count_ui[i] == 0) || (p <= MPFR_PREC_MIN)
+                || (p >= MPFR_PREC_MAX))
+              MEX_FCN_ERR ("cmd[%s]: Invalid count or precision at "
+                           "position %d.\n", "mpfr_t.allocate_handles",
+                           (int) i + 1);
+            count[i] = (size_t) count_ui[i];
+            prec[i]  = (mpfr_prec_t) p;
+          }
+
+        if (! mex_mpfr_handle_new_batch (num, count, prec, handle))
+          MEX_FCN_ERR ("%s\n", "Memory allocation failed.");
+
+        // Set all MPFR variables to +0 of the desired precision, this saves
+        // the calls of mpfr_set_prec and mpfr_set_d for each mpfr_t object.
+        plhs[0] = mxCreateNumericMatrix (num, 1, mxUINT64_CLASS, mxREAL);
+        uint64_t *ptr = (uint64_t *) mxGetData (plhs[0]);
+        for (size_t i = 0; i < num; i++)
+          {
+            idx_t idx;
+            mex_mpfr_handle_get (handle[i], &idx);
+            mpfr_ptr idx_ptr = mex_mpfr_ptr (&idx);
+            #pragma omp parallel for if (mex_omp_par) schedule (runtime)
+            for (size_t j = 0; j < length (&idx); j++)
+              {
+                mpfr_set_prec (idx_ptr + j, prec[i]);
+                mpfr_set_zero (idx_ptr + j, 1);
+              }
+            ptr[i] = (uint64_t) handle[i];
+          }
+        mxFree (count_ui);
+        mxFree (prec_ui);
+        mxFree (count);
+        mxFree (prec);
+        mxFree (handle);
+        return;
+      }
+
+      case 1910: // void mpfr_t.free_handles (size_t[] handle)
+      {
+        // Check if MPFR memory is (already) cleared.
+        if ((mpfr_data_capacity <= 0) && (mpfr_data_size <= 0))
+          return;
+
+        MEX_NARGINCHK (2);
+        size_t    num       = mxGetM (prhs[1]) * mxGetN (prhs[1]);
+        uint64_t *handle_ui = NULL;
+        if (num == 0)
+          return;
+        if (! extract_ui_vector (1, nrhs, prhs, &handle_ui, num))
+          MEX_FCN_ERR ("cmd[%s]: Invalid handle.\n", "mpfr_t.free_handles");
+        size_t *handle = (size_t *) mxMalloc ((num + 1) * sizeof(size_t));
+        for (size_t i = 0; i < num; i++)
+          {
+            idx_t idx;
+            handle[i] = (size_t) handle_ui[i];
+            if (! mex_mpfr_handle_get (handle[i], &idx))
+              MEX_FCN_ERR ("cmd[%s]: Invalid handle.\n",
+                           "mpfr_t.free_handles");
+            DBG_PRINTF ("cmd[mpfr_t.free_handles]: [%d:%d] will be marked "
+                        "as free\n", idx.start, idx.end);
+          }
+        mex_mpfr_handle_free_batch (num, handle);
+        mxFree (handle_ui);
+        mxFree (handle);
+        return;
+      }
+
+
+      case 1911: // double[] mpfr_t.run_command_buffer (double[] buf)
+      {
+        // The command buffer `buf` is a sequence of records
+        //
+        //   [cmd_code, nargs, kind_1, arg_1, ..., kind_nargs, arg_nargs]
+        //
+        // with `1000 <= cmd_code < 1900` and `nargs` arguments.  Each argument
+        // is a scalar (`kind = 1`), an index range of two values
+        // (`kind = 2`), or the handle of an mpfr_t variable (`kind = 3`).
+        // Handles are resolved when their record is executed, thus they
+        // remain valid after `mpfr_t.compact`.  The records are executed in
+        // order, for each record the number of non-zero ternary values is
+        // returned.
+        MEX_NARGINCHK (2);
+        if (! mxIsDouble (prhs[1]))
+          MEX_FCN_ERR ("cmd[%s]: BUF must be a double vector.\n",
+                       "mpfr_t.run_command_buffer");
+        const double *buf     = mxGetPr (prhs[1]);
+        size_t        buf_len = mxGetM (prhs[1]) * mxGetN (prhs[1]);
+
+        // Validate all records before executing the first one.
+        size_t num_records = 0;
+        for (size_t pos = 0; pos < buf_len; num_records++)
+          {
+            double code  = buf[pos];
+            double nargs = (pos + 1 < buf_len) ? buf[pos + 1] : -1.0;
+            if (! ((1000.0 <= code) && (code < 1900.0) && (floor (code) == code)
+                   && (0.0 <= nargs) && (nargs <= CMDBUF_MAX_ARGS)
+                   && (floor (nargs) == nargs)))
+              MEX_FCN_ERR ("cmd[%s]: Invalid record %d.\n",
+                           "mpfr_t.run_command_buffer", (int) num_records + 1);
+            pos += 2;
+            for (int i = 0; i < (int) nargs; i++)
+              {
+                idx_t idx;
+                if ((pos >= buf_len)
+                    || ((buf[pos] != 1.0) && (buf[pos] != 2.0)
+                        && (buf[pos] != 3.0))
+                    || (pos + 1 + CMDBUF_ARG_LEN (buf[pos]) > buf_len)
+                    || ((buf[pos] == 3.0)
+                        && ! ((buf[pos + 1] >= 0.0)
+                              && mex_mpfr_handle_get ((size_t) buf[pos + 1],
+                                                      &idx))))
+                  MEX_FCN_ERR ("cmd[%s]: Invalid argument %d of record %d.\n",
+                               "mpfr_t.run_command_buffer", i + 1,
+                               (int) num_records + 1);
+                pos += 1 + CMDBUF_ARG_LEN (buf[pos]);
+              }
+          }
+
+        // MEX input arrays are created once and reused by all records.
+        mxArray *code_array = mxCreateDoubleScalar (0.0);
+        mxArray *scalars[CMDBUF_MAX_ARGS];
+        mxArray *ranges[CMDBUF_MAX_ARGS];
+        for (int i = 0; i < CMDBUF_MAX_ARGS; i++)
+          {
+            scalars[i] = mxCreateDoubleScalar (0.0);
+            ranges[i]  = mxCreateNumericMatrix (2, 1, mxDOUBLE_CLASS, mxREAL);
+          }
+
+        plhs[0] = mxCreateNumericMatrix (num_records, 1, mxDOUBLE_CLASS,
+                                         mxREAL);
+        double *ret_ptr = mxGetPr (plhs[0]);
+        for (size_t r = 0, pos = 0; r < num_records; r++)
+          {
+            const mxArray *rec_prhs[1 + CMDBUF_MAX_ARGS];
+            mxArray       *rec_plhs[4] = {NULL, NULL, NULL, NULL};
+            uint64_t       rec_code    = (uint64_t) buf[pos];
+            int            rec_nrhs    = 1 + (int) buf[pos + 1];
+
+            mxGetPr (code_array)[0] = buf[pos];
+            rec_prhs[0] = code_array;
+            pos += 2;
+            for (int i = 1; i < rec_nrhs; i++)
+              {
+                mxArray *arg = (buf[pos] == 1.0) ? scalars[i - 1]
+                               : ranges[i - 1];
+                if (buf[pos] == 3.0)
+                  {
+                    idx_t idx;
+                    mex_mpfr_handle_get ((size_t) buf[pos + 1], &idx);
+                    mxGetPr (arg)[0] = (double) idx.start;
+                    mxGetPr (arg)[1] = (double) idx.end;
+                  }
+                else
+                  for (size_t j = 0; j < CMDBUF_ARG_LEN (buf[pos]); j++)
+                    mxGetPr (arg)[j] = buf[pos + 1 + j];
+                rec_prhs[i] = arg;
+                pos        += 1 + CMDBUF_ARG_LEN (buf[pos]);
+              }
+
+            mex_mpfr_interface (1, rec_plhs, rec_nrhs, rec_prhs, rec_code);
+
+            ret_ptr[r] = 0.0;
+            if ((rec_plhs[0] != NULL) && mxIsDouble (rec_plhs[0]))
+              {
+                double *ptr = mxGetPr (rec_plhs[0]);
+                size_t  len = mxGetM (rec_plhs[0]) * mxGetN (rec_plhs[0]);
+                for (size_t i = 0; i < len; i++)
+                  ret_ptr[r] += (ptr[i] != 0.0);
+              }
+            for (int i = 0; i < 4; i++)
+              if (rec_plhs[i] != NULL)
+                mxDestroyArray (rec_plhs[i]);
+          }
+
+        mxDestroyArray (code_array);
+        for (int i = 0; i < CMDBUF_MAX_ARGS; i++)
+          {
+            mxDestroyArray (scalars[i]);
+            mxDestroyArray (ranges[i]);
+          }
+        return;
+      }
+
+      case 1912: // void mpfr_t.warm_up_cache (mpfr_prec_t prec)
+      {
+        MEX_NARGINCHK (2);
+        MEX_MPFR_PREC_T (1, prec);
+        DBG_PRINTF ("cmd[mpfr_t.warm_up_cache]: prec = %d\n", (int) prec);
+        mex_mpfr_cache_warm_up (prec);
+        return;
+      }
+
+      case 1913: // void mpfr_t.free_cache (void)
+      {
+        MEX_NARGINCHK (1);
+        mex_mpfr_cache_free ();
+        return;
+      }
+
+      case 1914: // double[] mpfr_t.elementwise_flags (uint64_t cmd_code, mpfr_t rop, ...)
+      {
+        // Execute the MPFR command `cmd_code` with the arguments `rop, ...`
+        // and return the exception flags raised by the computation of each
+        // element of `rop` as bitmask of `MPFR_FLAGS_*`.  The second output
+        // are the ternary values of the command.
+        if (nrhs < 3)
+          MEX_FCN_ERR ("cmd[%d]: Invalid number of arguments.\n", cmd_code);
+        uint64_t fcn_code = 0;
+        if (! extract_ui (1, nrhs, prhs, &fcn_code) || (fcn_code < 1000)
+            || (fcn_code >= 1900))
+          MEX_FCN_ERR ("cmd[%s]: Invalid command code.\n",
+                       "mpfr_t.elementwise_flags");
+        MEX_MPFR_T (2, rop);
+
+        plhs[0] = mxCreateNumericMatrix (length (&rop), 1, mxDOUBLE_CLASS,
+                                         mxREAL);
+        double *flags_ptr = mxGetPr (plhs[0]);
+        for (size_t i = 0; i < length (&rop); i++)
+          flags_ptr[i] = mxGetNaN ();
+
+        // The elementwise loops clear the flags of each thread before and
+        // after each element, restore the flags of this thread afterwards.
+        mpfr_flags_t flags       = mpfr_flags_save ();
+        mxArray *    fcn_plhs[4] = {NULL, NULL, NULL, NULL};
+        mex_mpfr_flags_out = flags_ptr;
+        mex_mpfr_interface (1, fcn_plhs, nrhs - 1, prhs + 1, fcn_code);
+        mex_mpfr_flags_out = NULL;
+        for (int i = 1; i < 4; i++)
+          if (fcn_plhs[i] != NULL)
+            mxDestroyArray (fcn_plhs[i]);
+
+        // Commands without recording loops leave the flags `NaN`.
+        for (size_t i = 0; i < length (&rop); i++)
+          {
+            if (mxIsNaN (flags_ptr[i]))
+              {
+                mpfr_flags_set (flags);
+                if (fcn_plhs[0] != NULL)
+                  mxDestroyArray (fcn_plhs[0]);
+                MEX_FCN_ERR ("cmd[%s]: Command %d does not record elementwise "
+                             "flags.\n", "mpfr_t.elementwise_flags",
+                             (int) fcn_code);
+              }
+            flags |= (mpfr_flags_t) flags_ptr[i];
+          }
+        mpfr_flags_set (flags);
+
+        if (nlhs > 1)
+          plhs[1] = fcn_plhs[0];
+        else if (fcn_plhs[0] != NULL)
+          mxDestroyArray (fcn_plhs[0]);
+        return;
+      }
 
       /**
        * Genuine MPFR interface functions.
@@ -106,11 +514,12 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         MEX_MPFR_PREC_T (2, prec);
         DBG_PRINTF ("cmd[mpfr_init2]: [%d:%d] (prec = %d)\n",
                     idx.start, idx.end, (int) prec);
-        #pragma omp parallel for
+        mpfr_ptr idx_ptr = mex_mpfr_ptr (&idx);
+        #pragma omp parallel for if (mex_omp_par) schedule (runtime)
         for (size_t i = 0; i < length (&idx); i++)
           {
-            mpfr_clear (&mpfr_data[(idx.start - 1) + i]);
-            mpfr_init2 (&mpfr_data[(idx.start - 1) + i], prec);
+            mpfr_clear (&idx_ptr[i]);
+            mpfr_init2 (&idx_ptr[i], prec);
           }
         return;
       }
@@ -120,11 +529,12 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         MEX_NARGINCHK (2);
         MEX_MPFR_T (1, idx);
         DBG_PRINTF ("cmd[mpfr_init]: [%d:%d]\n", idx.start, idx.end);
-        #pragma omp parallel for
+        mpfr_ptr idx_ptr = mex_mpfr_ptr (&idx);
+        #pragma omp parallel for if (mex_omp_par) schedule (runtime)
         for (size_t i = 0; i < length (&idx); i++)
           {
-            mpfr_clear (&mpfr_data[(idx.start - 1) + i]);
-            mpfr_init (&mpfr_data[(idx.start - 1) + i]);
+            mpfr_clear (&idx_ptr[i]);
+            mpfr_init (&idx_ptr[i]);
           }
         return;
       }
@@ -151,9 +561,10 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         MEX_MPFR_PREC_T (2, prec);
         DBG_PRINTF ("cmd[mpfr_set_prec]: [%d:%d] (prec = %d)\n",
                     idx.start, idx.end, (int) prec);
-        #pragma omp parallel for
+        mpfr_ptr idx_ptr = mex_mpfr_ptr (&idx);
+        #pragma omp parallel for if (mex_omp_par) schedule (runtime)
         for (size_t i = 0; i < length (&idx); i++)
-          mpfr_set_prec (&mpfr_data[(idx.start - 1) + i], prec);
+          mpfr_set_prec (&idx_ptr[i], prec);
         return;
       }
 
@@ -418,9 +829,10 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         mpfr_prec_t (*fcn)(const mpfr_t) = ((cmd_code == 1004) ? mpfr_get_prec
                                             : mpfr_min_prec);
 
-        #pragma omp parallel for
+        mpfr_ptr idx_ptr = mex_mpfr_ptr (&idx);
+        #pragma omp parallel for if (mex_omp_par) schedule (runtime)
         for (size_t i = 0; i < length (&idx); i++)
-          plhs_0_pr[i] = (double) fcn (&mpfr_data[(idx.start - 1) + i]);
+          plhs_0_pr[i] = (double) fcn (&idx_ptr[i]);
         return;
       }
 
@@ -460,9 +872,16 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         else
           MEX_FCN_ERR ("cmd[%d]: Bad operator.\n", cmd_code);
 
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&idx); i++)
-          plhs_0_pr[i] = (double) fcn (&mpfr_data[(idx.start - 1) + i]);
+        mpfr_ptr idx_ptr = mex_mpfr_ptr (&idx);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&idx); i++)
+            plhs_0_pr[i] = (double) fcn (&idx_ptr[i]);
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -484,9 +903,16 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         else
           MEX_FCN_ERR ("cmd[%d]: Bad operator.\n", cmd_code);
 
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&idx); i++)
-          fcn (&mpfr_data[(idx.start - 1) + i]);
+        mpfr_ptr idx_ptr = mex_mpfr_ptr (&idx);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&idx); i++)
+            fcn (&idx_ptr[i]);
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -516,7 +942,7 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (nlhs ? length (&rop) : 1, 1,
                                          mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr rop_ptr    = &mpfr_data[rop.start - 1];
+        mpfr_ptr rop_ptr    = mex_mpfr_ptr (&rop);
         double * op_ptr     = mxGetPr (prhs[2]);
         double * exp_ptr    = mxGetPr (prhs[3]);
         size_t   ret_stride = (nlhs) ? 1 : 0;
@@ -524,35 +950,59 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         size_t   exp_stride = ((expM * expN) == 1) ? 0 : 1;
         if (cmd_code == 1007)
           {
-            #pragma omp parallel for
-            for (size_t i = 0; i < length (&rop); i++)
-              ret_ptr[i * ret_stride] = (double) mpfr_set_ui_2exp (
-                rop_ptr + i, (unsigned long) op_ptr[i * op_stride],
-                (mpfr_exp_t) exp_ptr[i * exp_stride], rnd);
+            mpfr_flags_t flags = 0;
+            #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+            {
+              #pragma omp for schedule (runtime)
+              for (size_t i = 0; i < length (&rop); i++)
+                ret_ptr[i * ret_stride] = (double) mpfr_set_ui_2exp (
+                  rop_ptr + i, (unsigned long) op_ptr[i * op_stride],
+                  (mpfr_exp_t) exp_ptr[i * exp_stride], rnd);
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
+            mpfr_flags_set (flags);
           }
         else if (cmd_code == 1008)
           {
-            #pragma omp parallel for
-            for (size_t i = 0; i < length (&rop); i++)
-              ret_ptr[i * ret_stride] = (double) mpfr_set_si_2exp (
-                rop_ptr + i, (long) op_ptr[i * op_stride],
-                (mpfr_exp_t) exp_ptr[i * exp_stride], rnd);
+            mpfr_flags_t flags = 0;
+            #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+            {
+              #pragma omp for schedule (runtime)
+              for (size_t i = 0; i < length (&rop); i++)
+                ret_ptr[i * ret_stride] = (double) mpfr_set_si_2exp (
+                  rop_ptr + i, (long) op_ptr[i * op_stride],
+                  (mpfr_exp_t) exp_ptr[i * exp_stride], rnd);
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
+            mpfr_flags_set (flags);
           }
         else if (cmd_code == 1320)
           {
-            #pragma omp parallel for
-            for (size_t i = 0; i < length (&rop); i++)
-              ret_ptr[i * ret_stride] = (double) mpfr_set_uj_2exp (
-                rop_ptr + i, (uintmax_t) op_ptr[i * op_stride],
-                (intmax_t) exp_ptr[i * exp_stride], rnd);
+            mpfr_flags_t flags = 0;
+            #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+            {
+              #pragma omp for schedule (runtime)
+              for (size_t i = 0; i < length (&rop); i++)
+                ret_ptr[i * ret_stride] = (double) mpfr_set_uj_2exp (
+                  rop_ptr + i, (uintmax_t) op_ptr[i * op_stride],
+                  (intmax_t) exp_ptr[i * exp_stride], rnd);
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
+            mpfr_flags_set (flags);
           }
         else
           {
-            #pragma omp parallel for
-            for (size_t i = 0; i < length (&rop); i++)
-              ret_ptr[i * ret_stride] = (double) mpfr_set_sj_2exp (
-                rop_ptr + i, (intmax_t) op_ptr[i * op_stride],
-                (intmax_t) exp_ptr[i * exp_stride], rnd);
+            mpfr_flags_t flags = 0;
+            #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+            {
+              #pragma omp for schedule (runtime)
+              for (size_t i = 0; i < length (&rop); i++)
+                ret_ptr[i * ret_stride] = (double) mpfr_set_sj_2exp (
+                  rop_ptr + i, (intmax_t) op_ptr[i * op_stride],
+                  (intmax_t) exp_ptr[i * exp_stride], rnd);
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
+            mpfr_flags_set (flags);
           }
 
         return;
@@ -585,55 +1035,94 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
 
         plhs[0] = mxCreateNumericMatrix (nlhs ? length (&idx) : 1, 1,
                                          mxDOUBLE_CLASS, mxREAL);
-        double *ret_ptr     = mxGetPr (plhs[0]);
-        double *base_ptr    = mxGetPr (prhs[3]);
-        size_t  ret_stride  = (nlhs) ? 1 : 0;
-        size_t  str_stride  = ((strM * strN) == 1) ? 0 : 1;
-        size_t  base_stride = ((baseM * baseN) == 1) ? 0 : 1;
+        double * ret_ptr     = mxGetPr (plhs[0]);
+        mpfr_ptr idx_ptr     = mex_mpfr_ptr (&idx);
+        double * base_ptr    = mxGetPr (prhs[3]);
+        size_t   ret_stride  = (nlhs) ? 1 : 0;
+        size_t   str_stride  = ((strM * strN) == 1) ? 0 : 1;
+        size_t   base_stride = ((baseM * baseN) == 1) ? 0 : 1;
+
+        MEX_TRACE_BEGIN ("string to mpfr_t", "\"n\": %d",
+                         (int) length (&idx));
+
+        // The MEX API is not thread-safe, copy all strings into a single
+        // buffer first.  Empty cells and non-strings become empty strings,
+        // which are invalid numbers.
+        size_t  num_str  = str_stride ? length (&idx) : 1;
+        size_t *str_offs = (size_t *) mxMalloc ((num_str + 1)
+                                                * sizeof(size_t));
+        str_offs[0] = 0;
+        for (size_t i = 0; i < num_str; i++)
+          {
+            const mxArray *s = mxGetCell (prhs[2], i);
+            str_offs[i + 1] = str_offs[i] + 1;
+            if ((s != NULL) && mxIsChar (s))
+              str_offs[i + 1] += mxGetNumberOfElements (s);
+          }
+        char *str_buf = (char *) mxMalloc (str_offs[num_str]);
+        for (size_t i = 0; i < num_str; i++)
+          {
+            const mxArray *s = mxGetCell (prhs[2], i);
+            if ((s == NULL)
+                || mxGetString (s, str_buf + str_offs[i],
+                                str_offs[i + 1] - str_offs[i]))
+              str_buf[str_offs[i]] = '\0';
+          }
 
-        char *str = mxArrayToString (mxGetCell (prhs[2], 0));
+        // The conversion time depends on the string length, parse the
+        // strings in parallel with the schedule for irregular functions.
         if (cmd_code == 1217)  // mpfr_strtofr
           {
             plhs[1] = mxCreateNumericMatrix ((nlhs == 2) ? length (&idx) : 1, 1,
                                              mxDOUBLE_CLASS, mxREAL);
             double *end_ptr        = mxGetPr (plhs[1]);
             size_t  end_ptr_stride = (nlhs == 2) ? 1 : 0;
-            for (size_t i = 0; i < length (&idx); i++)
-              {
-                if (str_stride && (i > 0))
-                  {
-                    mxFree (str);
-                    str = mxArrayToString (mxGetCell (prhs[2], i * str_stride));
-                  }
-                char *endptr = NULL;
-                ret_ptr[i * ret_stride] = (double) mpfr_strtofr (
-                  &mpfr_data[(idx.start - 1) + i], str, &endptr,
-                  (int) base_ptr[i * base_stride], rnd);
-                end_ptr[i * end_ptr_stride] = (endptr == NULL)
-                                              ? -1.0
-                                              : (double) (endptr - str + 1);
-              }
+            mpfr_flags_t flags = 0;
+            #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+            {
+              #pragma omp for schedule (runtime)
+              for (size_t i = 0; i < length (&idx); i++)
+                {
+                  char *s      = str_buf + str_offs[i * str_stride];
+                  char *endptr = NULL;
+                  ret_ptr[i * ret_stride] = (double) mpfr_strtofr (
+                    &idx_ptr[i], s, &endptr, (int) base_ptr[i * base_stride],
+                    rnd);
+                  end_ptr[i * end_ptr_stride] = (endptr == NULL)
+                                                ? -1.0
+                                                : (double) (endptr - s + 1);
+                }
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
+            mpfr_flags_set (flags);
           }
         else  // mpfr_set_str OR mpfr_init_set_str
           {
-            int (*fcn)(mpfr_t, const char *, int, mpfr_rnd_t) =
-              (cmd_code == 1009) ? mpfr_set_str : mpfr_init_set_str;
-
-            for (size_t i = 0; i < length (&idx); i++)
-              {
-                if (str_stride && (i > 0))
-                  {
-                    mxFree (str);
-                    str = mxArrayToString (mxGetCell (prhs[2], i * str_stride));
-                  }
-                if (cmd_code == 1009)
-                  mpfr_clear (&mpfr_data[(idx.start - 1) + i]);
-                ret_ptr[i * ret_stride] = (double) fcn (
-                  &mpfr_data[(idx.start - 1) + i], str,
-                  (int) base_ptr[i * base_stride], rnd);
-              }
+            // `mpfr_init_set_str` would use the default precision of the
+            // worker thread, which is thread-local in MPFR.
+            mpfr_prec_t prec = mpfr_get_default_prec ();
+            mpfr_flags_t flags = 0;
+            #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+            {
+              #pragma omp for schedule (runtime)
+              for (size_t i = 0; i < length (&idx); i++)
+                {
+                  if (cmd_code == 1016)
+                    {
+                      mpfr_clear (&idx_ptr[i]);
+                      mpfr_init2 (&idx_ptr[i], prec);
+                    }
+                  ret_ptr[i * ret_stride] = (double) mpfr_set_str (
+                    &idx_ptr[i], str_buf + str_offs[i * str_stride],
+                    (int) base_ptr[i * base_stride], rnd);
+                }
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
+            mpfr_flags_set (flags);
           }
-        mxFree (str);
+        mxFree (str_buf);
+        mxFree (str_offs);
+        MEX_TRACE_END ("string to mpfr_t");
         return;
       }
 
@@ -656,10 +1145,16 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         double *sign_ptr    = mxGetPr (prhs[2]);
         size_t  sign_stride = ((signM * signN) == 1) ? 0 : 1;
 
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&idx); i++)
-          fcn (&mpfr_data[(idx.start - 1) + i],
-               (int) sign_ptr[i * sign_stride]);
+        mpfr_ptr idx_ptr = mex_mpfr_ptr (&idx);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&idx); i++)
+            fcn (&idx_ptr[i], (int) sign_ptr[i * sign_stride]);
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -674,19 +1169,31 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         DBG_PRINTF ("cmd[%d]: x = [%d:%d], y = [%d:%d]\n",
                     cmd_code, x.start, x.end, y.start, y.end);
 
+        mpfr_ptr x_ptr = mex_mpfr_ptr (&x);
+        mpfr_ptr y_ptr = mex_mpfr_ptr (&y);
         if (cmd_code == 1013)
           {
-            #pragma omp parallel for
-            for (size_t i = 0; i < length (&x); i++)
-              mpfr_swap (&mpfr_data[x.start - 1 + i],
-                         &mpfr_data[y.start - 1 + i]);
+            mpfr_flags_t flags = 0;
+            #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+            {
+              #pragma omp for schedule (runtime)
+              for (size_t i = 0; i < length (&x); i++)
+                mpfr_swap (&x_ptr[i], &y_ptr[i]);
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
+            mpfr_flags_set (flags);
           }
         else
           {
-            #pragma omp parallel for
-            for (size_t i = 0; i < length (&x); i++)
-              mpfr_nexttoward (&mpfr_data[x.start - 1 + i],
-                               &mpfr_data[y.start - 1 + i]);
+            mpfr_flags_t flags = 0;
+            #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+            {
+              #pragma omp for schedule (runtime)
+              for (size_t i = 0; i < length (&x); i++)
+                mpfr_nexttoward (&x_ptr[i], &y_ptr[i]);
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
+            mpfr_flags_set (flags);
           }
         return;
       }
@@ -707,14 +1214,21 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         double *ret_ptr    = mxGetPr (plhs[0]);
         size_t  ret_stride = (nlhs) ? 1 : 0;
 
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&rop); i++)
-          {
-            mpfr_clear (&mpfr_data[(rop.start - 1) + i]);
-            ret_ptr[i * ret_stride] = (double) mpfr_init_set (
-              &mpfr_data[(rop.start - 1) + i], &mpfr_data[(op.start - 1) + i],
-              rnd);
-          }
+        mpfr_ptr rop_ptr = mex_mpfr_ptr (&rop);
+        mpfr_ptr op_ptr  = mex_mpfr_ptr (&op);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&rop); i++)
+            {
+              mpfr_clear (&rop_ptr[i]);
+              ret_ptr[i * ret_stride] = (double) mpfr_init_set (
+                &rop_ptr[i], &op_ptr[i], rnd);
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -740,10 +1254,16 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (length (&op), 1, mxDOUBLE_CLASS,
                                          mxREAL);
         double *ret_ptr = mxGetPr (plhs[0]);
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&op); i++)
-          ret_ptr[i] =
-            (double) mpfr_get_d (&mpfr_data[(op.start - 1) + i], rnd);
+        mpfr_ptr op_ptr = mex_mpfr_ptr (&op);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&op); i++)
+            ret_ptr[i] = (double) mpfr_get_d (&op_ptr[i], rnd);
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -762,15 +1282,20 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
                                          mxREAL);
         double *ret_ptr = mxGetPr (plhs[0]);
         double *exp_ptr = mxGetPr (plhs[1]);
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&op); i++)
-          {
-            long exp = 0;
-            ret_ptr[i] = (double) mpfr_get_d_2exp (&exp,
-                                                   &mpfr_data[(op.start - 1) + i],
-                                                   rnd);
-            exp_ptr[i] = (double) exp;
-          }
+        mpfr_ptr op_ptr = mex_mpfr_ptr (&op);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&op); i++)
+            {
+              long exp = 0;
+              ret_ptr[i] = (double) mpfr_get_d_2exp (&exp, &op_ptr[i], rnd);
+              exp_ptr[i] = (double) exp;
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -793,16 +1318,22 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
                                          mxREAL);
         double *ret_ptr = mxGetPr (plhs[0]);
         double *exp_ptr = mxGetPr (plhs[1]);
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&y); i++)
-          {
-            mpfr_exp_t exp = 0;
-            ret_ptr[i] = (double) mpfr_frexp (&exp,
-                                              &mpfr_data[(y.start - 1) + i],
-                                              &mpfr_data[(x.start - 1) + i],
-                                              rnd);
-            exp_ptr[i] = (double) exp;
-          }
+        mpfr_ptr y_ptr = mex_mpfr_ptr (&y);
+        mpfr_ptr x_ptr = mex_mpfr_ptr (&x);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&y); i++)
+            {
+              mpfr_exp_t exp = 0;
+              ret_ptr[i] = (double) mpfr_frexp (&exp, &y_ptr[i], &x_ptr[i],
+                                                rnd);
+              exp_ptr[i] = (double) exp;
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -832,11 +1363,17 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         size_t  op1_stride = (op1Dim == 1) ? 0 : 1;
         size_t  op2_stride = (op2Dim == 1) ? 0 : 1;
 
-        #pragma omp parallel for
-        for (size_t i = 0; i < MAX (op1Dim, op2Dim); i++)
-          ret_ptr[i] = (double) mpfr_get_str_ndigits (
-            (int) op1_ptr[i * op1_stride],
-            (mpfr_prec_t) op2_ptr[i * op2_stride]);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < MAX (op1Dim, op2Dim); i++)
+            ret_ptr[i] = (double) mpfr_get_str_ndigits (
+              (int) op1_ptr[i * op1_stride],
+              (mpfr_prec_t) op2_ptr[i * op2_stride]);
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
       #endif
         return;
       }
@@ -871,27 +1408,44 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
 
         plhs[0] = mxCreateNumericMatrix (nlhs ? length (&rop) : 1, 1,
                                          mxDOUBLE_CLASS, mxREAL);
-        double *ret_ptr    = mxGetPr (plhs[0]);
-        double *op_pr      = mxGetPr (prhs[2]);
-        size_t  ret_stride = (nlhs) ? 1 : 0;
-        size_t  op_stride  = ((opM * opN) == 1) ? 0 : 1;
+        double * ret_ptr    = mxGetPr (plhs[0]);
+        mpfr_ptr rop_ptr    = mex_mpfr_ptr (&rop);
+        double * op_pr      = mxGetPr (prhs[2]);
+        size_t   ret_stride = (nlhs) ? 1 : 0;
+        size_t   op_stride  = ((opM * opN) == 1) ? 0 : 1;
 
         if (cmd_code < 1310)
           {
-            #pragma omp parallel for
-            for (size_t i = 0; i < length (&rop); i++)
-              ret_ptr[i * ret_stride] = (double) mpfr_set_d (
-                &mpfr_data[(rop.start - 1) + i], op_pr[i * op_stride], rnd);
+            mpfr_flags_t flags = 0;
+            #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+            {
+              #pragma omp for schedule (runtime)
+              for (size_t i = 0; i < length (&rop); i++)
+                {
+                  MEX_MPFR_FLAGS_BEGIN;
+                  ret_ptr[i * ret_stride] = (double) mpfr_set_d (
+                    &rop_ptr[i], op_pr[i * op_stride], rnd);
+                  MEX_MPFR_FLAGS_END (i);
+                }
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
+            mpfr_flags_set (flags);
           }
         else
           {
-            #pragma omp parallel for
-            for (size_t i = 0; i < length (&rop); i++)
-              {
-                mpfr_clear (&mpfr_data[(rop.start - 1) + i]);
-                ret_ptr[i * ret_stride] = (double) mpfr_init_set_d (
-                  &mpfr_data[(rop.start - 1) + i], op_pr[i * op_stride], rnd);
-              }
+            mpfr_flags_t flags = 0;
+            #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+            {
+              #pragma omp for schedule (runtime)
+              for (size_t i = 0; i < length (&rop); i++)
+                {
+                  mpfr_clear (&rop_ptr[i]);
+                  ret_ptr[i * ret_stride] = (double) mpfr_init_set_d (
+                    &rop_ptr[i], op_pr[i * op_stride], rnd);
+                }
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
+            mpfr_flags_set (flags);
           }
         return;
       }
@@ -913,6 +1467,10 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
             || (((nSigM * nSigN) != length (&op)) && ((nSigM * nSigN) != 1)))
           MEX_FCN_ERR ("cmd[mpfr_get_str]:n must be a numeric vector "
                        "of length 1 or %d\n.", length (&op));
+        for (size_t i = 0; i < nSigM * nSigN; i++)
+          if (! mxIsFinite (mxGetPr (prhs[2])[i]) || (mxGetPr (prhs[2])[i] < 0))
+            MEX_FCN_ERR ("cmd[%s]:n must be non-negative and finite\n.",
+                         "mpfr_get_str");
         MEX_MPFR_RND_T (4, rnd);
         DBG_PRINTF ("cmd[mpfr_get_str]: [%d:%d]\n", op.start, op.end);
 
@@ -926,27 +1484,59 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         size_t  base_stride = ((baseM * baseN) == 1) ? 0 : 1;
         size_t  nSig_stride = ((nSigM * nSigN) == 1) ? 0 : 1;
 
+        mpfr_ptr op_ptr = mex_mpfr_ptr (&op);
+        mex_mpfr_omp_plan (cmd_code, length (&op), mpfr_get_prec (op_ptr));
+        MEX_TRACE_BEGIN ("mpfr_t to string", "\"n\": %d", (int) length (&op));
+
+        // Each string is written into its own slice of a single buffer.  The
+        // slice size `max (n + 2, 7)` with `n = mpfr_get_str_ndigits (b, p)`
+        // for `n = 0` is safe for any value according to the MPFR manual.
+        size_t *str_offs = (size_t *) mxMalloc ((length (&op) + 1)
+                                                * sizeof(size_t));
+        str_offs[0] = 0;
         for (size_t i = 0; i < length (&op); i++)
           {
-            mpfr_exp_t expptr = 0;
-            char *     str    = mpfr_get_str (NULL, &expptr,
-                                              (int) base_ptr[i * base_stride],
-                                              (size_t) nSig_ptr[i * nSig_stride],
-                                              &mpfr_data[(op.start - 1) + i],
-                                              rnd);
-            if (str != NULL)
+            int    b = (int) fabs (base_ptr[i * base_stride]);
+            size_t n = (size_t) nSig_ptr[i * nSig_stride];
+            if ((n == 0) && (b >= 2) && (b <= 62))
               {
-                char *significant = (char *) mxCalloc (strlen (str) + 1,
-                                                       sizeof(char));
-                if (significant != NULL)
-                  {
-                    strcpy (significant, str);
-                    mxSetCell (plhs[0], i, mxCreateString (significant));
-                  }
-                mpfr_free_str (str);
+              #if (MPFR_VERSION < MPFR_VERSION_NUM (4, 1, 0))
+                n = 2 + (size_t) ceil ((double) mpfr_get_prec (&op_ptr[i])
+                                       * log (2.0) / log ((double) b));
+              #else
+                n = mpfr_get_str_ndigits (b, mpfr_get_prec (&op_ptr[i]));
+              #endif
               }
-            exp_ptr[i] = (double) expptr;
+            str_offs[i + 1] = str_offs[i] + MAX (n + 2, (size_t) 7);
           }
+        char * str_buf = (char *) mxMalloc (str_offs[length (&op)]);
+        char **str     = (char **) mxMalloc (length (&op) * sizeof(char *));
+
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&op); i++)
+            {
+              mpfr_exp_t expptr = 0;
+              str[i] = mpfr_get_str (str_buf + str_offs[i], &expptr,
+                                     (int) base_ptr[i * base_stride],
+                                     (size_t) nSig_ptr[i * nSig_stride],
+                                     &op_ptr[i], rnd);
+              exp_ptr[i] = (double) expptr;
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
+
+        // Invalid bases or numbers of digits leave the cell empty.
+        for (size_t i = 0; i < length (&op); i++)
+          if (str[i] != NULL)
+            mxSetCell (plhs[0], i, mxCreateString (str[i]));
+        mxFree (str);
+        mxFree (str_buf);
+        mxFree (str_offs);
+        MEX_TRACE_END ("mpfr_t to string");
         return;
       }
 
@@ -988,9 +1578,16 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (length (&op), 1, mxDOUBLE_CLASS,
                                          mxREAL);
         double *ret_ptr = mxGetPr (plhs[0]);
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&op); i++)
-          ret_ptr[i] = (double) fcn (&mpfr_data[(op.start - 1) + i], rnd);
+        mpfr_ptr op_ptr = mex_mpfr_ptr (&op);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&op); i++)
+            ret_ptr[i] = (double) fcn (&op_ptr[i], rnd);
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -1065,17 +1662,27 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (nlhs ? length (&rop) : 1, 1,
                                          mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr rop_ptr    = &mpfr_data[rop.start - 1];
-        mpfr_ptr op1_ptr    = &mpfr_data[op1.start - 1];
-        mpfr_ptr op2_ptr    = &mpfr_data[op2.start - 1];
+        mpfr_ptr rop_ptr    = mex_mpfr_ptr (&rop);
+        mpfr_ptr op1_ptr    = mex_mpfr_ptr (&op1);
+        mpfr_ptr op2_ptr    = mex_mpfr_ptr (&op2);
         size_t   ret_stride = (nlhs) ? 1 : 0;
         size_t   op1_stride = (length (&op1) == 1) ? 0 : 1;
         size_t   op2_stride = (length (&op2) == 1) ? 0 : 1;
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&rop); i++)
-          ret_ptr[i * ret_stride] =
-            (double) fcn (rop_ptr + i, op1_ptr + (i * op1_stride),
-                          op2_ptr + (i * op2_stride), rnd);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&rop); i++)
+            {
+              MEX_MPFR_FLAGS_BEGIN;
+              ret_ptr[i * ret_stride] =
+                (double) fcn (rop_ptr + i, op1_ptr + (i * op1_stride),
+                              op2_ptr + (i * op2_stride), rnd);
+              MEX_MPFR_FLAGS_END (i);
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -1113,16 +1720,26 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (nlhs ? length (&sop) : 1, 1,
                                          mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr sop_ptr    = &mpfr_data[sop.start - 1];
-        mpfr_ptr cop_ptr    = &mpfr_data[cop.start - 1];
-        mpfr_ptr op_ptr     = &mpfr_data[op.start - 1];
+        mpfr_ptr sop_ptr    = mex_mpfr_ptr (&sop);
+        mpfr_ptr cop_ptr    = mex_mpfr_ptr (&cop);
+        mpfr_ptr op_ptr     = mex_mpfr_ptr (&op);
         size_t   ret_stride = (nlhs) ? 1 : 0;
         size_t   op_stride  = (length (&op) == 1) ? 0 : 1;
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&sop); i++)
-          ret_ptr[i * ret_stride] = (double) fcn (sop_ptr + i, cop_ptr + i,
-                                                  op_ptr + (i * op_stride),
-                                                  rnd);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&sop); i++)
+            {
+              MEX_MPFR_FLAGS_BEGIN;
+              ret_ptr[i * ret_stride] = (double) fcn (sop_ptr + i, cop_ptr + i,
+                                                      op_ptr + (i * op_stride),
+                                                      rnd);
+              MEX_MPFR_FLAGS_END (i);
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -1172,16 +1789,26 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (nlhs ? length (&rop) : 1, 1,
                                          mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr rop_ptr    = &mpfr_data[rop.start - 1];
-        mpfr_ptr op1_ptr    = &mpfr_data[op1.start - 1];
+        mpfr_ptr rop_ptr    = mex_mpfr_ptr (&rop);
+        mpfr_ptr op1_ptr    = mex_mpfr_ptr (&op1);
         double * op2_ptr    = mxGetPr (prhs[3]);
         size_t   ret_stride = (nlhs) ? 1 : 0;
         size_t   op2_stride = ((op2M * op2N) == 1) ? 0 : 1;
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&rop); i++)
-          ret_ptr[i * ret_stride] =
-            (double) fcn (rop_ptr + i, op1_ptr + i, op2_ptr[i * op2_stride],
-                          rnd);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&rop); i++)
+            {
+              MEX_MPFR_FLAGS_BEGIN;
+              ret_ptr[i * ret_stride] =
+                (double) fcn (rop_ptr + i, op1_ptr + i, op2_ptr[i * op2_stride],
+                              rnd);
+              MEX_MPFR_FLAGS_END (i);
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -1214,66 +1841,101 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (nlhs ? length (&rop) : 1, 1,
                                          mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr rop_ptr    = &mpfr_data[rop.start - 1];
+        mpfr_ptr rop_ptr    = mex_mpfr_ptr (&rop);
         double * op1_ptr    = mxGetPr (prhs[2]);
-        mpfr_ptr op2_ptr    = &mpfr_data[op2.start - 1];
+        mpfr_ptr op2_ptr    = mex_mpfr_ptr (&op2);
         size_t   ret_stride = (nlhs) ? 1 : 0;
         size_t   op1_stride = ((op1M * op1N) == 1) ? 0 : 1;
         size_t   op2_stride = (length (&op2) == 1) ? 0 : 1;
         if ((1343 <= cmd_code) && (cmd_code <= 1345))
           {
-            #pragma omp parallel for
-            for (size_t i = 0; i < length (&rop); i++)
-              ret_ptr[i * ret_stride] = (double) mpfr_d_sub (rop_ptr + i,
-                                                             op1_ptr[i *
-                                                                     op1_stride],
-                                                             op2_ptr +
-                                                             (i * op2_stride),
-                                                             rnd);
+            mpfr_flags_t flags = 0;
+            #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+            {
+              #pragma omp for schedule (runtime)
+              for (size_t i = 0; i < length (&rop); i++)
+                {
+                  MEX_MPFR_FLAGS_BEGIN;
+                  ret_ptr[i * ret_stride] = (double) mpfr_d_sub (
+                    rop_ptr + i, op1_ptr[i * op1_stride],
+                    op2_ptr + (i * op2_stride), rnd);
+                  MEX_MPFR_FLAGS_END (i);
+                }
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
+            mpfr_flags_set (flags);
           }
         else if ((1363 <= cmd_code) && (cmd_code <= 1365))
           {
-            #pragma omp parallel for
-            for (size_t i = 0; i < length (&rop); i++)
-              ret_ptr[i * ret_stride] = (double) mpfr_d_div (rop_ptr + i,
-                                                             op1_ptr[i *
-                                                                     op1_stride],
-                                                             op2_ptr +
-                                                             (i * op2_stride),
-                                                             rnd);
+            mpfr_flags_t flags = 0;
+            #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+            {
+              #pragma omp for schedule (runtime)
+              for (size_t i = 0; i < length (&rop); i++)
+                {
+                  MEX_MPFR_FLAGS_BEGIN;
+                  ret_ptr[i * ret_stride] = (double) mpfr_d_div (
+                    rop_ptr + i, op1_ptr[i * op1_stride],
+                    op2_ptr + (i * op2_stride), rnd);
+                  MEX_MPFR_FLAGS_END (i);
+                }
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
+            mpfr_flags_set (flags);
           }
         else if (cmd_code == 1097)
           {
-            #pragma omp parallel for
-            for (size_t i = 0; i < length (&rop); i++)
-              ret_ptr[i * ret_stride] = (double) mpfr_ui_pow (rop_ptr + i,
-                                                              (unsigned long int) op1_ptr[
-                                                                i * op1_stride],
-                                                              op2_ptr +
-                                                              (i * op2_stride),
-                                                              rnd);
+            mpfr_flags_t flags = 0;
+            #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+            {
+              #pragma omp for schedule (runtime)
+              for (size_t i = 0; i < length (&rop); i++)
+                {
+                  MEX_MPFR_FLAGS_BEGIN;
+                  ret_ptr[i * ret_stride] = (double) mpfr_ui_pow (
+                    rop_ptr + i, (unsigned long int) op1_ptr[i * op1_stride],
+                    op2_ptr + (i * op2_stride), rnd);
+                  MEX_MPFR_FLAGS_END (i);
+                }
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
+            mpfr_flags_set (flags);
           }
         else if (cmd_code == 1133)
           {
-            #pragma omp parallel for
-            for (size_t i = 0; i < length (&rop); i++)
-              ret_ptr[i * ret_stride] = (double) mpfr_jn (rop_ptr + i,
-                                                          (long) op1_ptr[i *
-                                                                         op1_stride],
-                                                          op2_ptr +
-                                                          (i * op2_stride),
-                                                          rnd);
+            mpfr_flags_t flags = 0;
+            #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+            {
+              #pragma omp for schedule (runtime)
+              for (size_t i = 0; i < length (&rop); i++)
+                {
+                  MEX_MPFR_FLAGS_BEGIN;
+                  ret_ptr[i * ret_stride] = (double) mpfr_jn (
+                    rop_ptr + i, (long) op1_ptr[i * op1_stride],
+                    op2_ptr + (i * op2_stride), rnd);
+                  MEX_MPFR_FLAGS_END (i);
+                }
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
+            mpfr_flags_set (flags);
           }
         else if (cmd_code == 1136)
           {
-            #pragma omp parallel for
-            for (size_t i = 0; i < length (&rop); i++)
-              ret_ptr[i * ret_stride] = (double) mpfr_yn (rop_ptr + i,
-                                                          (long) op1_ptr[i *
-                                                                         op1_stride],
-                                                          op2_ptr +
-                                                          (i * op2_stride),
-                                                          rnd);
+            mpfr_flags_t flags = 0;
+            #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+            {
+              #pragma omp for schedule (runtime)
+              for (size_t i = 0; i < length (&rop); i++)
+                {
+                  MEX_MPFR_FLAGS_BEGIN;
+                  ret_ptr[i * ret_stride] = (double) mpfr_yn (
+                    rop_ptr + i, (long) op1_ptr[i * op1_stride],
+                    op2_ptr + (i * op2_stride), rnd);
+                  MEX_MPFR_FLAGS_END (i);
+                }
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
+            mpfr_flags_set (flags);
           }
         else
           {
@@ -1305,20 +1967,27 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (nlhs ? length (&rop) : 1, 1,
                                          mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr rop_ptr    = &mpfr_data[rop.start - 1];
+        mpfr_ptr rop_ptr    = mex_mpfr_ptr (&rop);
         double * op1_ptr    = mxGetPr (prhs[2]);
         double * op2_ptr    = mxGetPr (prhs[3]);
         size_t   ret_stride = (nlhs) ? 1 : 0;
         size_t   op1_stride = ((op1M * op1N) == 1) ? 0 : 1;
         size_t   op2_stride = ((op2M * op2N) == 1) ? 0 : 1;
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&rop); i++)
-          ret_ptr[i * ret_stride] = (double) mpfr_ui_pow_ui (rop_ptr + i,
-                                                             (unsigned long int) op1_ptr[
-                                                               i * op1_stride],
-                                                             (unsigned long int) op2_ptr[
-                                                               i * op2_stride],
-                                                             rnd);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&rop); i++)
+            {
+              MEX_MPFR_FLAGS_BEGIN;
+              ret_ptr[i * ret_stride] = (double) mpfr_ui_pow_ui (
+                rop_ptr + i, (unsigned long int) op1_ptr[i * op1_stride],
+                (unsigned long int) op2_ptr[i * op2_stride], rnd);
+              MEX_MPFR_FLAGS_END (i);
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -1496,12 +2165,23 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (nlhs ? length (&rop) : 1, 1,
                                          mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr rop_ptr    = &mpfr_data[rop.start - 1];
-        mpfr_ptr op_ptr     = &mpfr_data[op.start - 1];
+        mpfr_ptr rop_ptr    = mex_mpfr_ptr (&rop);
+        mpfr_ptr op_ptr     = mex_mpfr_ptr (&op);
         size_t   ret_stride = (nlhs) ? 1 : 0;
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&rop); i++)
-          ret_ptr[i * ret_stride] = (double) fcn (rop_ptr + i, op_ptr + i, rnd);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&rop); i++)
+            {
+              MEX_MPFR_FLAGS_BEGIN;
+              ret_ptr[i * ret_stride] = (double) fcn (rop_ptr + i, op_ptr + i,
+                                                      rnd);
+              MEX_MPFR_FLAGS_END (i);
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -1536,16 +2216,24 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (nlhs ? length (&rop) : 1, 1,
                                          mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr rop_ptr    = &mpfr_data[rop.start - 1];
+        mpfr_ptr rop_ptr    = mex_mpfr_ptr (&rop);
         double * op_ptr     = mxGetPr (prhs[2]);
         size_t   ret_stride = (nlhs) ? 1 : 0;
         size_t   op_stride  = ((opM * opN) == 1) ? 0 : 1;
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&rop); i++)
-          ret_ptr[i * ret_stride] = (double) fcn (rop_ptr + i,
-                                                  (unsigned long int) op_ptr[i *
-                                                                             op_stride],
-                                                  rnd);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&rop); i++)
+            {
+              MEX_MPFR_FLAGS_BEGIN;
+              ret_ptr[i * ret_stride] = (double) fcn (
+                rop_ptr + i, (unsigned long int) op_ptr[i * op_stride], rnd);
+              MEX_MPFR_FLAGS_END (i);
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
 
         return;
       }
@@ -1585,20 +2273,27 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (nlhs ? length (&rop) : 1, 1,
                                          mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr rop_ptr    = &mpfr_data[rop.start - 1];
-        mpfr_ptr op1_ptr    = &mpfr_data[op1.start - 1];
+        mpfr_ptr rop_ptr    = mex_mpfr_ptr (&rop);
+        mpfr_ptr op1_ptr    = mex_mpfr_ptr (&op1);
         double * op2_ptr    = mxGetPr (prhs[3]);
         size_t   ret_stride = (nlhs) ? 1 : 0;
         size_t   op1_stride = (length (&op1) == 1) ? 0 : 1;
         size_t   op2_stride = ((op2M * op2N) == 1) ? 0 : 1;
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&rop); i++)
-          ret_ptr[i * ret_stride] = (double) fcn (rop_ptr + i,
-                                                  op1_ptr + (i * op1_stride),
-                                                  (unsigned long int) op2_ptr[i
-                                                                              *
-                                                                              op2_stride],
-                                                  rnd);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&rop); i++)
+            {
+              MEX_MPFR_FLAGS_BEGIN;
+              ret_ptr[i * ret_stride] = (double) fcn (
+                rop_ptr + i, op1_ptr + (i * op1_stride),
+                (unsigned long int) op2_ptr[i * op2_stride], rnd);
+              MEX_MPFR_FLAGS_END (i);
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
 
         return;
       }
@@ -1635,19 +2330,27 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (nlhs ? length (&rop) : 1, 1,
                                          mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr rop_ptr    = &mpfr_data[rop.start - 1];
-        mpfr_ptr op1_ptr    = &mpfr_data[op1.start - 1];
+        mpfr_ptr rop_ptr    = mex_mpfr_ptr (&rop);
+        mpfr_ptr op1_ptr    = mex_mpfr_ptr (&op1);
         double * op2_ptr    = mxGetPr (prhs[3]);
         size_t   ret_stride = (nlhs) ? 1 : 0;
         size_t   op1_stride = (length (&op1) == 1) ? 0 : 1;
         size_t   op2_stride = ((op2M * op2N) == 1) ? 0 : 1;
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&rop); i++)
-          ret_ptr[i * ret_stride] = (double) fcn (rop_ptr + i,
-                                                  op1_ptr + (i * op1_stride),
-                                                  (long int) op2_ptr[i *
-                                                                     op2_stride],
-                                                  rnd);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&rop); i++)
+            {
+              MEX_MPFR_FLAGS_BEGIN;
+              ret_ptr[i * ret_stride] = (double) fcn (
+                rop_ptr + i, op1_ptr + (i * op1_stride),
+                (long int) op2_ptr[i * op2_stride], rnd);
+              MEX_MPFR_FLAGS_END (i);
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
 
         return;
       }
@@ -1676,8 +2379,8 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (nlhs ? length (&rop) : 1, 1,
                                          mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr rop_ptr    = &mpfr_data[rop.start - 1];
-        mpfr_ptr op1_ptr    = &mpfr_data[op1.start - 1];
+        mpfr_ptr rop_ptr    = mex_mpfr_ptr (&rop);
+        mpfr_ptr op1_ptr    = mex_mpfr_ptr (&op1);
         double * op2_ptr    = mxGetPr (prhs[3]);
         size_t   ret_stride = (nlhs) ? 1 : 0;
         size_t   op1_stride = (length (&op1) == 1) ? 0 : 1;
@@ -1722,21 +2425,29 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (nlhs ? length (&rop) : 1, 1,
                                          mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr rop_ptr    = &mpfr_data[rop.start - 1];
-        mpfr_ptr op1_ptr    = &mpfr_data[op1.start - 1];
-        mpfr_ptr op2_ptr    = &mpfr_data[op2.start - 1];
-        mpfr_ptr op3_ptr    = &mpfr_data[op3.start - 1];
+        mpfr_ptr rop_ptr    = mex_mpfr_ptr (&rop);
+        mpfr_ptr op1_ptr    = mex_mpfr_ptr (&op1);
+        mpfr_ptr op2_ptr    = mex_mpfr_ptr (&op2);
+        mpfr_ptr op3_ptr    = mex_mpfr_ptr (&op3);
         size_t   ret_stride = (nlhs) ? 1 : 0;
         size_t   op1_stride = (length (&op1) == 1) ? 0 : 1;
         size_t   op2_stride = (length (&op2) == 1) ? 0 : 1;
         size_t   op3_stride = (length (&op3) == 1) ? 0 : 1;
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&rop); i++)
-          ret_ptr[i * ret_stride] = (double) fcn (rop_ptr + i,
-                                                  op1_ptr + (i * op1_stride),
-                                                  op2_ptr + (i * op2_stride),
-                                                  op3_ptr + (i * op3_stride),
-                                                  rnd);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&rop); i++)
+            {
+              MEX_MPFR_FLAGS_BEGIN;
+              ret_ptr[i * ret_stride] = (double) fcn (
+                rop_ptr + i, op1_ptr + (i * op1_stride),
+                op2_ptr + (i * op2_stride), op3_ptr + (i * op3_stride), rnd);
+              MEX_MPFR_FLAGS_END (i);
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -1770,24 +2481,32 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (nlhs ? length (&rop) : 1, 1,
                                          mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr rop_ptr    = &mpfr_data[rop.start - 1];
-        mpfr_ptr op1_ptr    = &mpfr_data[op1.start - 1];
-        mpfr_ptr op2_ptr    = &mpfr_data[op2.start - 1];
-        mpfr_ptr op3_ptr    = &mpfr_data[op3.start - 1];
-        mpfr_ptr op4_ptr    = &mpfr_data[op4.start - 1];
+        mpfr_ptr rop_ptr    = mex_mpfr_ptr (&rop);
+        mpfr_ptr op1_ptr    = mex_mpfr_ptr (&op1);
+        mpfr_ptr op2_ptr    = mex_mpfr_ptr (&op2);
+        mpfr_ptr op3_ptr    = mex_mpfr_ptr (&op3);
+        mpfr_ptr op4_ptr    = mex_mpfr_ptr (&op4);
         size_t   ret_stride = (nlhs) ? 1 : 0;
         size_t   op1_stride = (length (&op1) == 1) ? 0 : 1;
         size_t   op2_stride = (length (&op2) == 1) ? 0 : 1;
         size_t   op3_stride = (length (&op3) == 1) ? 0 : 1;
         size_t   op4_stride = (length (&op4) == 1) ? 0 : 1;
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&rop); i++)
-          ret_ptr[i * ret_stride] = (double) fcn (rop_ptr + i,
-                                                  op1_ptr + (i * op1_stride),
-                                                  op2_ptr + (i * op2_stride),
-                                                  op3_ptr + (i * op3_stride),
-                                                  op4_ptr + (i * op4_stride),
-                                                  rnd);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&rop); i++)
+            {
+              MEX_MPFR_FLAGS_BEGIN;
+              ret_ptr[i * ret_stride] = (double) fcn (
+                rop_ptr + i, op1_ptr + (i * op1_stride),
+                op2_ptr + (i * op2_stride), op3_ptr + (i * op3_stride),
+                op4_ptr + (i * op4_stride), rnd);
+              MEX_MPFR_FLAGS_END (i);
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -1813,12 +2532,19 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
 
         plhs[0] = mxCreateNumericMatrix (1, 1, mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr = mxGetPr (plhs[0]);
-        mpfr_ptr rop_ptr = &mpfr_data[rop.start - 1];
-
-        mpfr_ptr *tab_ptr = (mpfr_ptr *) mxMalloc (n * sizeof(mpfr_ptr *));
-        #pragma omp parallel for
-        for (size_t i = 0; i < n; i++)
-          tab_ptr[i] = mpfr_data + tab.start - 1 + i;
+        mpfr_ptr rop_ptr = mex_mpfr_ptr (&rop);
+
+        mpfr_ptr  tab_data = mex_mpfr_ptr (&tab);
+        mpfr_ptr *tab_ptr  = (mpfr_ptr *) mxMalloc (n * sizeof(mpfr_ptr *));
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < n; i++)
+            tab_ptr[i] = tab_data + i;
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
 
         *ret_ptr = (double) mpfr_sum (rop_ptr, tab_ptr, n, rnd);
         mxFree (tab_ptr);
@@ -1852,16 +2578,24 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
 
         plhs[0] = mxCreateNumericMatrix (1, 1, mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr = mxGetPr (plhs[0]);
-        mpfr_ptr rop_ptr = &mpfr_data[rop.start - 1];
-
-        mpfr_ptr *a_ptr = (mpfr_ptr *) mxMalloc (n * sizeof(mpfr_ptr *));
-        mpfr_ptr *b_ptr = (mpfr_ptr *) mxMalloc (n * sizeof(mpfr_ptr *));
-        #pragma omp parallel for
-        for (size_t i = 0; i < n; i++)
-          {
-            a_ptr[i] = mpfr_data + a.start - 1 + i;
-            b_ptr[i] = mpfr_data + b.start - 1 + i;
-          }
+        mpfr_ptr rop_ptr = mex_mpfr_ptr (&rop);
+
+        mpfr_ptr  a_data = mex_mpfr_ptr (&a);
+        mpfr_ptr  b_data = mex_mpfr_ptr (&b);
+        mpfr_ptr *a_ptr  = (mpfr_ptr *) mxMalloc (n * sizeof(mpfr_ptr *));
+        mpfr_ptr *b_ptr  = (mpfr_ptr *) mxMalloc (n * sizeof(mpfr_ptr *));
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < n; i++)
+            {
+              a_ptr[i] = a_data + i;
+              b_ptr[i] = b_data + i;
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
 
         *ret_ptr = (double) mpfr_dot (rop_ptr, a_ptr, b_ptr, n, rnd);
         mxFree (a_ptr);
@@ -1926,15 +2660,25 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
                                          : 1,
                                          1, mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr op1_ptr    = &mpfr_data[op1.start - 1];
-        mpfr_ptr op2_ptr    = &mpfr_data[op2.start - 1];
+        mpfr_ptr op1_ptr    = mex_mpfr_ptr (&op1);
+        mpfr_ptr op2_ptr    = mex_mpfr_ptr (&op2);
         size_t   ret_stride = (nlhs) ? 1 : 0;
         size_t   op1_stride = (length (&op1) == 1) ? 0 : 1;
         size_t   op2_stride = (length (&op2) == 1) ? 0 : 1;
-        #pragma omp parallel for
-        for (size_t i = 0; i < MAX (length (&op1), length (&op2)); i++)
-          ret_ptr[i * ret_stride] = (double) fcn (op1_ptr + (i * op1_stride),
-                                                  op2_ptr + (i * op2_stride));
+
+        // `MEX_MPFR_T` planned the loop for op1, which may be a scalar.
+        mex_mpfr_omp_plan (cmd_code, MAX (length (&op1), length (&op2)),
+                           mpfr_get_prec (op1_ptr));
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < MAX (length (&op1), length (&op2)); i++)
+            ret_ptr[i * ret_stride] = (double) fcn (op1_ptr + (i * op1_stride),
+                                                    op2_ptr + (i * op2_stride));
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -1949,7 +2693,8 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         size_t op2M = mxGetM (prhs[2]);
         size_t op2N = mxGetN (prhs[2]);
         if (! mxIsDouble (prhs[2])
-            || (((op2M * op2N) != length (&op1)) && ((op2M * op2N) != 1)))
+            || (((op2M * op2N) != length (&op1)) && ((op2M * op2N) != 1)
+                && (length (&op1) != 1)))
           MEX_FCN_ERR ("cmd[%d]:op2 Invalid.\n", cmd_code);
         DBG_PRINTF ("cmd[%d]: op1 = [%d:%d] , op2 = [%d x %d]\n", cmd_code,
                     op1.start, op1.end, op2M, op2N);
@@ -1958,40 +2703,68 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
           (nlhs ? MAX (length (&op1), (op2M * op2N)) : 1), 1, mxDOUBLE_CLASS,
           mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr op1_ptr    = &mpfr_data[op1.start - 1];
+        mpfr_ptr op1_ptr    = mex_mpfr_ptr (&op1);
         double * op2_ptr    = mxGetPr (prhs[2]);
         size_t   ret_stride = (nlhs) ? 1 : 0;
         size_t   op1_stride = (length (&op1) == 1) ? 0 : 1;
         size_t   op2_stride = ((op2M * op2N) == 1) ? 0 : 1;
+
+        // `MEX_MPFR_T` planned the loop for op1, which may be a scalar.
+        mex_mpfr_omp_plan (cmd_code, MAX (length (&op1), (op2M * op2N)),
+                           mpfr_get_prec (op1_ptr));
         if (cmd_code == 1064)
           {
-            #pragma omp parallel for
-            for (size_t i = 0; i < MAX (length (&op1), (op2M * op2N)); i++)
-              ret_ptr[i * ret_stride] = (double) mpfr_cmp_d (
-                op1_ptr + (i * op1_stride), op2_ptr[i * op2_stride]);
+            mpfr_flags_t flags = 0;
+            #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+            {
+              #pragma omp for schedule (runtime)
+              for (size_t i = 0; i < MAX (length (&op1), (op2M * op2N)); i++)
+                ret_ptr[i * ret_stride] = (double) mpfr_cmp_d (
+                  op1_ptr + (i * op1_stride), op2_ptr[i * op2_stride]);
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
+            mpfr_flags_set (flags);
           }
         else if (cmd_code == 1034)
           {
-            #pragma omp parallel for
-            for (size_t i = 0; i < MAX (length (&op1), (op2M * op2N)); i++)
-              ret_ptr[i * ret_stride] = (double) mpfr_cmp_ui (
-                op1_ptr + (i * op1_stride),
-                (unsigned long) op2_ptr[i * op2_stride]);
+            mpfr_flags_t flags = 0;
+            #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+            {
+              #pragma omp for schedule (runtime)
+              for (size_t i = 0; i < MAX (length (&op1), (op2M * op2N)); i++)
+                ret_ptr[i * ret_stride] = (double) mpfr_cmp_ui (
+                  op1_ptr + (i * op1_stride),
+                  (unsigned long) op2_ptr[i * op2_stride]);
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
+            mpfr_flags_set (flags);
           }
         else if (cmd_code == 1037)
           {
-            #pragma omp parallel for
-            for (size_t i = 0; i < MAX (length (&op1), (op2M * op2N)); i++)
-              ret_ptr[i * ret_stride] = (double) mpfr_cmp_si (
-                op1_ptr + (i * op1_stride), (long) op2_ptr[i * op2_stride]);
+            mpfr_flags_t flags = 0;
+            #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+            {
+              #pragma omp for schedule (runtime)
+              for (size_t i = 0; i < MAX (length (&op1), (op2M * op2N)); i++)
+                ret_ptr[i * ret_stride] = (double) mpfr_cmp_si (
+                  op1_ptr + (i * op1_stride), (long) op2_ptr[i * op2_stride]);
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
+            mpfr_flags_set (flags);
           }
         else if (cmd_code == 1035)
           {
-            #pragma omp parallel for
-            for (size_t i = 0; i < MAX (length (&op1), (op2M * op2N)); i++)
-              ret_ptr[i * ret_stride] = (double) mpfr_cmp_si (
-                op1_ptr + (i * op1_stride),
-                (long double) op2_ptr[i * op2_stride]);
+            mpfr_flags_t flags = 0;
+            #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+            {
+              #pragma omp for schedule (runtime)
+              for (size_t i = 0; i < MAX (length (&op1), (op2M * op2N)); i++)
+                ret_ptr[i * ret_stride] = (double) mpfr_cmp_si (
+                  op1_ptr + (i * op1_stride),
+                  (long double) op2_ptr[i * op2_stride]);
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
+            mpfr_flags_set (flags);
           }
         else
           {
@@ -2000,11 +2773,17 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
             MEX_FCN_ERR ("cmd[%d]: Not supported in MPFR %s.\n",
                          cmd_code, MPFR_VERSION_STRING);
           #else
-            #pragma omp parallel for
-            for (size_t i = 0; i < MAX (length (&op1), (op2M * op2N)); i++)
-              ret_ptr[i * ret_stride] = (double) mpfr_cmpabs_ui (
-                op1_ptr + (i * op1_stride),
-                (unsigned long) op2_ptr[i * op2_stride]);
+            mpfr_flags_t flags = 0;
+            #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+            {
+              #pragma omp for schedule (runtime)
+              for (size_t i = 0; i < MAX (length (&op1), (op2M * op2N)); i++)
+                ret_ptr[i * ret_stride] = (double) mpfr_cmpabs_ui (
+                  op1_ptr + (i * op1_stride),
+                  (unsigned long) op2_ptr[i * op2_stride]);
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
+            mpfr_flags_set (flags);
           #endif
           }
         return;
@@ -2028,26 +2807,38 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
           (nlhs ? MAX (length (&op1), (op2M * op2N)) : 1), 1, mxDOUBLE_CLASS,
           mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr op1_ptr    = &mpfr_data[op1.start - 1];
+        mpfr_ptr op1_ptr    = mex_mpfr_ptr (&op1);
         double * op2_ptr    = mxGetPr (prhs[2]);
         size_t   ret_stride = (nlhs) ? 1 : 0;
         size_t   op1_stride = (length (&op1) == 1) ? 0 : 1;
         size_t   op2_stride = ((op2M * op2N) == 1) ? 0 : 1;
         if (cmd_code == 1065)
           {
-            #pragma omp parallel for
-            for (size_t i = 0; i < MAX (length (&op1), (op2M * op2N)); i++)
-              ret_ptr[i * ret_stride] = (double) mpfr_cmp_ui_2exp (
-                op1_ptr + (i * op1_stride),
-                (unsigned long int) op2_ptr[i * op2_stride], e);
+            mpfr_flags_t flags = 0;
+            #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+            {
+              #pragma omp for schedule (runtime)
+              for (size_t i = 0; i < MAX (length (&op1), (op2M * op2N)); i++)
+                ret_ptr[i * ret_stride] = (double) mpfr_cmp_ui_2exp (
+                  op1_ptr + (i * op1_stride),
+                  (unsigned long int) op2_ptr[i * op2_stride], e);
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
+            mpfr_flags_set (flags);
           }
         else
           {
-            #pragma omp parallel for
-            for (size_t i = 0; i < MAX (length (&op1), (op2M * op2N)); i++)
-              ret_ptr[i * ret_stride] = (double) mpfr_cmp_si_2exp (
-                op1_ptr + (i * op1_stride), (long int) op2_ptr[i * op2_stride],
-                e);
+            mpfr_flags_t flags = 0;
+            #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+            {
+              #pragma omp for schedule (runtime)
+              for (size_t i = 0; i < MAX (length (&op1), (op2M * op2N)); i++)
+                ret_ptr[i * ret_stride] = (double) mpfr_cmp_si_2exp (
+                  op1_ptr + (i * op1_stride),
+                  (long int) op2_ptr[i * op2_stride], e);
+              flags |= mex_mpfr_omp_flags_collect ();
+            }
+            mpfr_flags_set (flags);
           }
         return;
       }
@@ -2069,17 +2860,25 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
                                          mxREAL);
         double * ret_ptr   = mxGetPr (plhs[0]);
         double * signp_ptr = mxGetPr (plhs[1]);
-        mpfr_ptr rop_ptr   = &mpfr_data[rop.start - 1];
-        mpfr_ptr op_ptr    = &mpfr_data[op.start - 1];
+        mpfr_ptr rop_ptr   = mex_mpfr_ptr (&rop);
+        mpfr_ptr op_ptr    = mex_mpfr_ptr (&op);
         size_t   op_stride = (length (&op) == 1) ? 0 : 1;
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&rop); i++)
-          {
-            int signp = 0;
-            ret_ptr[i] = (double) mpfr_lgamma (rop_ptr + i, &signp,
-                                               op_ptr + (i * op_stride), rnd);
-            signp_ptr[i] = (double) signp;
-          }
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&rop); i++)
+            {
+              int signp = 0;
+              MEX_MPFR_FLAGS_BEGIN;
+              ret_ptr[i] = (double) mpfr_lgamma (rop_ptr + i, &signp,
+                                                 op_ptr + (i * op_stride), rnd);
+              MEX_MPFR_FLAGS_END (i);
+              signp_ptr[i] = (double) signp;
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -2111,10 +2910,20 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         double *ret_ptr    = mxGetPr (plhs[0]);
         size_t  ret_stride = (nlhs) ? 1 : 0;
 
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&rop); i++)
-          ret_ptr[i * ret_stride] = (double) fcn (&mpfr_data[rop.start - 1 + i],
-                                                  rnd);
+        mpfr_ptr rop_ptr = mex_mpfr_ptr (&rop);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&rop); i++)
+            {
+              MEX_MPFR_FLAGS_BEGIN;
+              ret_ptr[i * ret_stride] = (double) fcn (&rop_ptr[i], rnd);
+              MEX_MPFR_FLAGS_END (i);
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -2151,10 +2960,21 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         double *ret_ptr    = mxGetPr (plhs[0]);
         size_t  ret_stride = (nlhs) ? 1 : 0;
 
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&rop); i++)
-          ret_ptr[i * ret_stride] = (double) fcn (&mpfr_data[rop.start - 1 + i],
-                                                  &mpfr_data[op.start - 1 + i]);
+        mpfr_ptr rop_ptr = mex_mpfr_ptr (&rop);
+        mpfr_ptr op_ptr  = mex_mpfr_ptr (&op);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&rop); i++)
+            {
+              MEX_MPFR_FLAGS_BEGIN;
+              ret_ptr[i * ret_stride] = (double) fcn (&rop_ptr[i], &op_ptr[i]);
+              MEX_MPFR_FLAGS_END (i);
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -2188,22 +3008,30 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
                                          mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
         double * q_ptr      = mxGetPr (plhs[1]);
-        mpfr_ptr r_ptr      = &mpfr_data[r.start - 1];
-        mpfr_ptr x_ptr      = &mpfr_data[x.start - 1];
-        mpfr_ptr y_ptr      = &mpfr_data[y.start - 1];
+        mpfr_ptr r_ptr      = mex_mpfr_ptr (&r);
+        mpfr_ptr x_ptr      = mex_mpfr_ptr (&x);
+        mpfr_ptr y_ptr      = mex_mpfr_ptr (&y);
         size_t   ret_stride = (nlhs) ? 1 : 0;
         size_t   x_stride   = (length (&x) == 1) ? 0 : 1;
         size_t   y_stride   = (length (&y) == 1) ? 0 : 1;
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&x); i++)
-          {
-            long q;
-            ret_ptr[i * ret_stride] = (double) fcn (r_ptr + i, &q,
-                                                    x_ptr + (i * x_stride),
-                                                    y_ptr + (i * y_stride),
-                                                    rnd);
-            q_ptr[i * ret_stride] = (double) q;
-          }
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&r); i++)
+            {
+              long q;
+              MEX_MPFR_FLAGS_BEGIN;
+              ret_ptr[i * ret_stride] = (double) fcn (r_ptr + i, &q,
+                                                      x_ptr + (i * x_stride),
+                                                      y_ptr + (i * y_stride),
+                                                      rnd);
+              MEX_MPFR_FLAGS_END (i);
+              q_ptr[i * ret_stride] = (double) q;
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -2219,13 +3047,19 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (nlhs ? length (&x) : 1, 1,
                                          mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr x_ptr      = &mpfr_data[x.start - 1];
+        mpfr_ptr x_ptr      = mex_mpfr_ptr (&x);
         size_t   ret_stride = (nlhs) ? 1 : 0;
 
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&x); i++)
-          ret_ptr[i * ret_stride] = (double) mpfr_prec_round (x_ptr + i, prec,
-                                                              rnd);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&x); i++)
+            ret_ptr[i * ret_stride] = (double) mpfr_prec_round (x_ptr + i, prec,
+                                                                rnd);
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -2244,13 +3078,19 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (nlhs ? length (&b) : 1, 1,
                                          mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr b_ptr      = &mpfr_data[b.start - 1];
+        mpfr_ptr b_ptr      = mex_mpfr_ptr (&b);
         size_t   ret_stride = (nlhs) ? 1 : 0;
 
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&b); i++)
-          ret_ptr[i * ret_stride] = (double) mpfr_can_round (b_ptr + i, err,
-                                                             rnd1, rnd2, prec);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&b); i++)
+            ret_ptr[i * ret_stride] = (double) mpfr_can_round (
+              b_ptr + i, err, rnd1, rnd2, prec);
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -2263,11 +3103,17 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (length (&x), 1, mxDOUBLE_CLASS,
                                          mxREAL);
         double * ret_ptr = mxGetPr (plhs[0]);
-        mpfr_ptr x_ptr   = &mpfr_data[x.start - 1];
+        mpfr_ptr x_ptr   = mex_mpfr_ptr (&x);
 
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&x); i++)
-          ret_ptr[i] = (double) mpfr_get_exp (x_ptr + i);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&x); i++)
+            ret_ptr[i] = (double) mpfr_get_exp (x_ptr + i);
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -2282,12 +3128,18 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (nlhs ? length (&x) : 1, 1,
                                          mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr x_ptr      = &mpfr_data[x.start - 1];
+        mpfr_ptr x_ptr      = mex_mpfr_ptr (&x);
         size_t   ret_stride = (nlhs) ? 1 : 0;
 
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&x); i++)
-          ret_ptr[i * ret_stride] = (double) mpfr_set_exp (x_ptr + i, e);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&x); i++)
+            ret_ptr[i * ret_stride] = (double) mpfr_set_exp (x_ptr + i, e);
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -2311,20 +3163,23 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (nlhs ? length (&rop) : 1, 1,
                                          mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr rop_ptr    = &mpfr_data[rop.start - 1];
-        mpfr_ptr op_ptr     = &mpfr_data[op.start - 1];
+        mpfr_ptr rop_ptr    = mex_mpfr_ptr (&rop);
+        mpfr_ptr op_ptr     = mex_mpfr_ptr (&op);
         double * s_ptr      = mxGetPr (prhs[3]);
         size_t   ret_stride = (nlhs) ? 1 : 0;
         size_t   op_stride  = (length (&op) == 1) ? 0 : 1;
         size_t   s_stride   = ((sM * sN) == 1) ? 0 : 1;
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&rop); i++)
-          ret_ptr[i * ret_stride] = (double) mpfr_setsign (rop_ptr + i,
-                                                           op_ptr +
-                                                           (i * op_stride),
-                                                           (int) s_ptr[i *
-                                                                       s_stride],
-                                                           rnd);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&rop); i++)
+            ret_ptr[i * ret_stride] = (double) mpfr_setsign (
+              rop_ptr + i, op_ptr + (i * op_stride),
+              (int) s_ptr[i * s_stride], rnd);
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -2369,15 +3224,25 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
         plhs[0] = mxCreateNumericMatrix (nlhs ? length (&x) : 1, 1,
                                          mxDOUBLE_CLASS, mxREAL);
         double * ret_ptr    = mxGetPr (plhs[0]);
-        mpfr_ptr x_ptr      = &mpfr_data[x.start - 1];
+        mpfr_ptr x_ptr      = mex_mpfr_ptr (&x);
         double * t_ptr      = mxGetPr (prhs[2]);
         size_t   ret_stride = (nlhs) ? 1 : 0;
         size_t   t_stride   = ((tM * tN) == 1) ? 0 : 1;
-        #pragma omp parallel for
-        for (size_t i = 0; i < length (&x); i++)
-          ret_ptr[i * ret_stride] = (double) fcn (x_ptr + i,
-                                                  (int) t_ptr[i * t_stride],
-                                                  rnd);
+        mpfr_flags_t flags = 0;
+        #pragma omp parallel if (mex_omp_par) reduction (|:flags)
+        {
+          #pragma omp for schedule (runtime)
+          for (size_t i = 0; i < length (&x); i++)
+            {
+              MEX_MPFR_FLAGS_BEGIN;
+              ret_ptr[i * ret_stride] = (double) fcn (x_ptr + i,
+                                                      (int) t_ptr[i * t_stride],
+                                                      rnd);
+              MEX_MPFR_FLAGS_END (i);
+            }
+          flags |= mex_mpfr_omp_flags_collect ();
+        }
+        mpfr_flags_set (flags);
         return;
       }
 
@@ -28,16 +28,20 @@
 // MPFR memory management
 // ======================
 //
-// mex_mpfr_algorithms.c
+// mex_mpfr_interface_memory_managment.c
 //
 // Similar to C++ std::vector:
 // - xxx_capacity: number of elements that `xxx` has currently allocated
 //                 space for.
 // - xxx_size:     number of elements in `xxx`.
+//
+// The MPFR variables are stored in non-moving segments, use `mex_mpfr_ptr`
+// to access the MPFR variables of an index range.  `mpfr_t` objects refer to
+// their index range by a handle, such that `mex_mpfr_compact` can relocate
+// it.
 
-extern mpfr_ptr mpfr_data;
-extern size_t   mpfr_data_capacity;
-extern size_t   mpfr_data_size;
+extern size_t mpfr_data_capacity;
+extern size_t mpfr_data_size;
 
 
 /**
@@ -58,6 +62,9 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
 /**
  * Safely declare and read MPFR_T variable(-arrays) from MEX interface.
  *
+ * The first MPFR variable argument of an MPFR command, usually `rop`, plans
+ * its elementwise loops by `mex_mpfr_omp_plan`.
+ *
  * @param mex_rhs Position (0-based) in MEX input.
  * @param name    Desired variable name.
  */
@@ -65,7 +72,10 @@ mex_mpfr_interface (int nlhs, mxArray *plhs[],
   idx_t name;                                                         \
   if (! extract_idx ((mex_rhs), nrhs, prhs, &name))                   \
     MEX_FCN_ERR ("cmd[%d]:"#name " Invalid MPFR variable indices.\n", \
-                 cmd_code);
+                 cmd_code);                                           \
+  if (((mex_rhs) == 1) && (cmd_code < 1900))                          \
+    mex_mpfr_omp_plan (cmd_code, length (&name),                      \
+                       mpfr_get_prec (mex_mpfr_ptr (&name)));
 
 
 /**
@@ -125,6 +135,18 @@ int
 is_valid (idx_t *idx);
 
 
+/**
+ * Get pointer to MPFR variables.
+ *
+ * @param[in] idx Pointer to valid index (1-based, idx_t) of MPFR variables.
+ *
+ * @returns pointer to the first MPFR variable of @c idx.  All MPFR variables
+ *          of @c idx follow contiguously.
+ */
+mpfr_ptr
+mex_mpfr_ptr (idx_t *idx);
+
+
 /**
  * Safely read MPFR index (idx_t) structure.
  *
@@ -189,7 +211,13 @@ extract_prec (int idx, int nrhs, const mxArray *prhs[], mpfr_prec_t *prec);
 /**
  * Constructor for new MPFR variables.
  *
+ * The MPFR variables have an unspecified precision and value.  Previously
+ * freed variables of at least precision @c prec are preferred, as setting
+ * their precision to @c prec does not allocate memory.  Newly initialized
+ * variables have precision @c prec.
+ *
  * @param[in] count Number of MPFR variables to create.
+ * @param[in] prec Desired precision of the MPFR variables.
  * @param[out] idx If function returns `1`, pointer to index (1-based, idx_t)
  *                 of MPFR variables, otherwise the value of `idx` remains
  *                 unchanged.
@@ -197,7 +225,7 @@ extract_prec (int idx, int nrhs, const mxArray *prhs[], mpfr_prec_t *prec);
  * @returns success of MPFR variable creation.
  */
 int
-mex_mpfr_allocate (size_t count, idx_t *idx);
+mex_mpfr_allocate (size_t count, mpfr_prec_t prec, idx_t *idx);
 
 
 /**
@@ -211,5 +239,314 @@ mex_mpfr_allocate (size_t count, idx_t *idx);
 void
 mex_mpfr_mark_free (idx_t *idx);
 
+
+/**
+ * Create MPFR variables referred to by a handle.
+ *
+ * See `mex_mpfr_allocate` for the MPFR variables.
+ *
+ * @param[in] count Number of MPFR variables to create.
+ * @param[in] prec Desired precision of the MPFR variables.
+ * @param[out] handle If function returns `1`, handle (1-based) of the index
+ *                    range of the MPFR variables, otherwise the value of
+ *                    `handle` remains unchanged.
+ *
+ * @returns success of MPFR variable creation.
+ */
+int
+mex_mpfr_handle_new (size_t count, mpfr_prec_t prec, size_t *handle);
+
+
+/**
+ * Get the index range of a handle.
+ *
+ * @param[in] handle handle (1-based) of an index range.
+ * @param[out] idx If function returns `1`, index (1-based, idx_t) of the MPFR
+ *                 variables, otherwise the value of `idx` remains unchanged.
+ *
+ * @returns `0` if `handle` is invalid, otherwise `handle` is valid.
+ */
+int
+mex_mpfr_handle_get (size_t handle, idx_t *idx);
+
+
+/**
+ * Mark the MPFR variables of a handle as no longer used and release the
+ * handle.
+ *
+ * @param[in] handle valid handle (1-based) of an index range.
+ */
+void
+mex_mpfr_handle_free (size_t handle);
+
+
+/**
+ * Create MPFR variables for several handles.
+ *
+ * The index ranges are allocated as one contiguous index range (see
+ * `mex_mpfr_allocate`) of the minimal precision, which is split afterwards.
+ * If the function fails, no MPFR variables are created.
+ *
+ * @param[in] num number of handles to create.
+ * @param[in] count number of MPFR variables for each handle.
+ * @param[in] prec desired precision of the MPFR variables for each handle.
+ * @param[out] handle If function returns `1`, handles (1-based) of the index
+ *                    ranges of the MPFR variables, otherwise the value of
+ *                    `handle` remains unchanged.
+ *
+ * @returns success of MPFR variable creation.
+ */
+int
+mex_mpfr_handle_new_batch (size_t num, const size_t *count,
+                           const mpfr_prec_t *prec, size_t *handle);
+
+
+/**
+ * Mark the MPFR variables of several handles as no longer used and release
+ * the handles.
+ *
+ * Invalid handles are ignored.
+ *
+ * @param[in] num number of handles.
+ * @param[in] handle handles (1-based) of index ranges.
+ */
+void
+mex_mpfr_handle_free_batch (size_t num, const size_t *handle);
+
+
+/**
+ * Compact the pool of MPFR variables and release unused memory.
+ *
+ * The index ranges of handles are relocated to the lowest possible position
+ * in address order, the MPFR variables are moved by `mpfr_swap` without
+ * copying their values.  Index ranges without handle (see
+ * `mex_mpfr_allocate`) remain in place.  Afterwards the limbs of all unused
+ * MPFR variables and all unused segments are released.
+ *
+ * Index ranges obtained from handles before the compaction are no longer
+ * valid.
+ *
+ * @returns number of released MPFR variables of the capacity.
+ */
+size_t
+mex_mpfr_compact (void);
+
+
+typedef struct
+{
+  uint64_t live_variables;        // MPFR variables in use.
+  uint64_t live_high_water;       // Maximum of `live_variables`.
+  uint64_t data_size;             // See `mpfr_data_size`.
+  uint64_t data_size_high_water;  // Maximum of `data_size`.
+  uint64_t data_capacity;         // See `mpfr_data_capacity`.
+  uint64_t segments;              // Number of segments.
+  uint64_t handles;               // Number of used handles.
+  uint64_t free_ranges;           // Number of free index ranges.
+  uint64_t free_variables;        // MPFR variables in free index ranges.
+  uint64_t largest_free_range;    // Length of the largest free index range.
+  uint64_t allocations;           // Allocated index ranges.
+  uint64_t frees;                 // Freed index ranges.
+  uint64_t limb_bytes;            // Significand bytes of all MPFR variables.
+} mpfr_pool_stats_t;
+
+
+/**
+ * Get the statistics of the pool of MPFR variables.
+ *
+ * @param reset if non-zero, reset the counters `allocations` and `frees` and
+ *              the high-water marks to the current values after reading.
+ *
+ * @returns current pool statistics.
+ */
+mpfr_pool_stats_t
+mex_mpfr_get_pool_stats (int reset);
+
+
+/**
+ * Count the initialized MPFR variables by precision.
+ *
+ * Free MPFR variables keep their limbs and are counted, too.
+ *
+ * @param[out] prec  ascending distinct precisions, allocated by `mxMalloc`.
+ * @param[out] count number of MPFR variables of precision `prec[i]`,
+ *                   allocated by `mxMalloc`.
+ *
+ * @returns number of distinct precisions or `SIZE_MAX`, if memory allocation
+ *          failed.
+ */
+size_t
+mex_mpfr_get_prec_histogram (mpfr_prec_t **prec, size_t **count);
+
+
+/**
+ * Precompute the MPFR constant caches (pi, log(2), Euler's constant, and
+ * Catalan's constant) on all threads of the OpenMP team.
+ *
+ * In thread-safe MPFR builds each thread has its own caches, which live as
+ * long as the thread.  The OpenMP threads are reused by all MEX calls, thus
+ * the caches are only computed again for a higher precision.
+ *
+ * @param prec precision of the constants.
+ */
+void
+mex_mpfr_cache_warm_up (mpfr_prec_t prec);
+
+
+/**
+ * Free the MPFR constant caches and memory pools of all threads of the
+ * OpenMP team and the global caches.
+ */
+void
+mex_mpfr_cache_free (void);
+
+// Cost model of the elementwise OpenMP loops
+// ==========================================
+//
+// mex_mpfr_interface_omp.c
+//
+// The cost of an elementwise command is estimated as
+//
+//   N * weight[class] * (prec / 64)^exponent[class]
+//
+// in units of one `mpfr_add` at 64 bit precision, for `N` MPFR variables of
+// precision `prec`.  Cheap commands run serially, the others in parallel with
+// a static or, for commands of argument dependent cost, a dynamic schedule.
+// Irregular commands, e.g. mpfr_gamma, are split into `irregular_chunks`
+// chunks per thread.  The loops use `if (mex_omp_par) schedule (runtime)` to
+// follow the plan.
+
+#define MEX_MPFR_OMP_NUM_CLASSES 5
+
+// Cost classes of MPFR commands.
+#define MEX_MPFR_OMP_CHEAP       0  // Assignment, comparison, e.g. mpfr_set.
+#define MEX_MPFR_OMP_ADD         1  // Linear cost, e.g. mpfr_add.
+#define MEX_MPFR_OMP_MUL         2  // Multiplicative cost, e.g. mpfr_div.
+#define MEX_MPFR_OMP_ELEMENTARY  3  // Elementary functions, e.g. mpfr_exp.
+#define MEX_MPFR_OMP_SPECIAL     4  // Special functions, e.g. mpfr_zeta.
+
+typedef struct
+{
+  double threshold;         // Minimal total cost for parallel execution.
+  double chunk_cost;        // Minimal cost of a chunk of a dynamic schedule.
+  double irregular_chunks;  // Chunks per thread of irregular commands.
+  double weight[MEX_MPFR_OMP_NUM_CLASSES];
+  double exponent[MEX_MPFR_OMP_NUM_CLASSES];
+} mex_mpfr_omp_model_t;
+
+// Number of doubles of the vector representation of the cost model.
+#define MEX_MPFR_OMP_MODEL_LENGTH (3 + 2 * MEX_MPFR_OMP_NUM_CLASSES)
+
+extern mex_mpfr_omp_model_t mex_mpfr_omp_model;
+
+// Non-zero, if the loops of the current command should run in parallel.
+extern int mex_omp_par;
+
+// If not `NULL`, the elementwise loops store the MPFR exception flags raised
+// by the computation of element `i` to `mex_mpfr_flags_out[i]`, see
+// `mpfr_t.elementwise_flags`.
+extern double *mex_mpfr_flags_out;
+
+// Macros to enclose the computation of element `i` of an elementwise loop,
+// which records its exception flags if requested.  The flags of the thread
+// are cleared before and after each element.
+#define MEX_MPFR_FLAGS_BEGIN              \
+  { if (mex_mpfr_flags_out != NULL)       \
+      mpfr_flags_clear (MPFR_FLAGS_ALL); }
+
+#define MEX_MPFR_FLAGS_END(i)                                   \
+  { if (mex_mpfr_flags_out != NULL)                             \
+      {                                                         \
+        mex_mpfr_flags_out[(i)] = (double) mpfr_flags_save ();  \
+        mpfr_flags_clear (MPFR_FLAGS_ALL);                      \
+      } }
+
+
+/**
+ * Get the cost class of an MPFR command.
+ *
+ * @param cmd_code code of an MPFR command (1000 - 1999).
+ *
+ * @returns cost class `MEX_MPFR_OMP_*`.
+ */
+int
+mex_mpfr_omp_cost_class (uint64_t cmd_code);
+
+
+/**
+ * Check if the cost of an MPFR command varies by orders of magnitude with
+ * its arguments.
+ *
+ * @param cmd_code code of an MPFR command (1000 - 1999).
+ *
+ * @returns `1` for special functions and string conversion, otherwise `0`.
+ */
+int
+mex_mpfr_omp_irregular (uint64_t cmd_code);
+
+
+/**
+ * Plan the execution of the elementwise loops of a command.
+ *
+ * Sets `mex_omp_par` and the OpenMP runtime schedule used by
+ * `schedule (runtime)`.
+ *
+ * @param cmd_code code of an MPFR command (1000 - 1999).
+ * @param N number of MPFR variables processed by the command.
+ * @param prec precision of the MPFR variables.
+ */
+void
+mex_mpfr_omp_plan (uint64_t cmd_code, size_t N, mpfr_prec_t prec);
+
+
+/**
+ * Calibrate the cost model by timing representative MPFR functions of each
+ * cost class and the OpenMP overhead on this machine.
+ *
+ * @returns calibrated cost model.
+ */
+mex_mpfr_omp_model_t
+mex_mpfr_omp_tune (void);
+
+
+/**
+ * Convert a cost model to a vector of length `MEX_MPFR_OMP_MODEL_LENGTH`
+ * `[threshold, chunk_cost, irregular_chunks, weight(1:5), exponent(1:5)]`.
+ *
+ * @param[in] model cost model.
+ * @param[out] vec vector representation.
+ */
+void
+mex_mpfr_omp_model_to_vector (const mex_mpfr_omp_model_t *model, double *vec);
+
+
+/**
+ * Convert a vector `[threshold, chunk_cost, irregular_chunks, weight(1:5),
+ * exponent(1:5)]` to a cost model.
+ *
+ * @param[in] vec vector representation.
+ * @param[out] model If function returns `1`, the cost model, otherwise
+ *                   `model` remains unchanged.
+ *
+ * @returns `0` if a value is negative or not finite, otherwise `1`.
+ */
+int
+mex_mpfr_omp_model_from_vector (const double *vec,
+                                mex_mpfr_omp_model_t *model);
+
+
+/**
+ * Take the MPFR exception flags of a worker thread at the end of a parallel
+ * region.  The flags of the worker thread are cleared.
+ *
+ * MPFR flags are thread-local.  Each parallel region running MPFR functions
+ * reduces the flags of its threads with `reduction (|:flags)` and sets them
+ * in the calling thread with `mpfr_flags_set` afterwards.
+ *
+ * @returns flags of the calling thread, or `0` for the primary thread of the
+ *          team, which keeps its flags.
+ */
+mpfr_flags_t
+mex_mpfr_omp_flags_collect (void);
+
 #endif  // MEX_MPFR_INTERFACE_H_
 
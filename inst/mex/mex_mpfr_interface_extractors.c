@@ -39,19 +39,36 @@ extract_idx (int idx, int nrhs, const mxArray *prhs[], idx_t *idx_vec)
       return (0);
     }
 
-  const mxArray *mpfr_t_idx = NULL;
+  const mxArray *mpfr_t_idx = prhs[idx];
 
+  // Fast path: the handle of an mpfr_t object is passed as uint64 scalar,
+  // e.g. `obj.handle`.  This avoids the property lookup below, which copies
+  // the property in Octave.
+  if (mxIsUint64 (mpfr_t_idx) && (mxGetNumberOfElements (mpfr_t_idx) == 1))
+    {
+      uint64_t h = ((const uint64_t *) mxGetData (mpfr_t_idx))[0];
+      if (! mex_mpfr_handle_get ((size_t) h, idx_vec))
+        {
+          DBG_PRINTF ("Invalid handle %d in prhs[%d].\n", (int) h, idx);
+          return (0);
+        }
+      return (1);
+    }
+
+  // mpfr_t objects refer to their index range by a handle.
   if (mxIsClass (prhs[idx], "mpfr_t"))
     {
-      mpfr_t_idx = mxGetProperty (prhs[idx], 0, "idx");
-      if (mpfr_t_idx == NULL)
+      const mxArray *handle = mxGetProperty (prhs[idx], 0, "handle");
+      uint64_t       h      = 0;
+      if ((handle == NULL) || ! extract_ui (0, 1, &handle, &h)
+          || ! mex_mpfr_handle_get ((size_t) h, idx_vec))
         {
-          DBG_PRINTF ("mpfr_t object in prhs[%d] has no 'idx' field.\n", idx);
+          DBG_PRINTF ("mpfr_t object in prhs[%d] has no valid handle.\n",
+                      idx);
           return (0);
         }
+      return (1);
     }
-  else
-    mpfr_t_idx = prhs[idx];
 
   if (mxIsNumeric (mpfr_t_idx)
       && ((mxGetM (mpfr_t_idx) * mxGetN (mpfr_t_idx) == 2)))
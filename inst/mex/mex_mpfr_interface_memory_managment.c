@@ -15,6 +15,9 @@
  *  along with APA.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <stdlib.h>  // qsort
+
+#include "mex_gmp_interface.h"
 #include "mex_mpfr_interface.h"
 
 // MPFR memory management
@@ -25,13 +28,131 @@
 //                 space for.
 // - xxx_size:     number of elements in `xxx`.
 
-mpfr_ptr mpfr_data          = NULL;
-size_t   mpfr_data_capacity = 0;
-size_t   mpfr_data_size     = 0;
+size_t mpfr_data_capacity = 0;
+size_t mpfr_data_size     = 0;
+
+// Storage of MPFR variables
+// -------------------------
+//
+// The MPFR variables `1:mpfr_data_capacity` are stored in segments, which are
+// never moved or resized.  Thus pointers to MPFR variables stay valid while
+// the pool grows.  A new segment is at least as large as all previous
+// segments together, thus there are only O(log n) segments.  A valid index
+// range never crosses a segment boundary and its MPFR variables are
+// contiguous in memory.
+//
+// MPFR variables are initialized on demand, when they are handed out for the
+// first time.
+
+#define MPFR_SEGMENTS_MAX 64
+
+typedef struct
+{
+  size_t   base;         // Number of MPFR variables in previous segments.
+  size_t   length;       // Number of MPFR variables in this segment.
+  size_t   initialized;  // Number of initialized MPFR variables from `data`.
+  mpfr_ptr data;
+} mpfr_segment_t;
+
+static mpfr_segment_t mpfr_segments[MPFR_SEGMENTS_MAX];
+static size_t         mpfr_segments_size = 0;
+
+// Pool of free MPFR variables
+// ----------------------------
+//
+// Free index ranges are stored in `mpfr_free_nodes` and referenced by their
+// position in that array, the position `0` is reserved as "no node".  Each
+// free range is part of two structures:
+//
+// - An AVL tree ordered by start index.  It finds the neighbors of a range
+//   in O(log n) for merging (Rule 2) and for returning the top-most range to
+//   the unused part of the segments (Rule 1).
+// - A size-segregated bin, a doubly linked list of all free ranges with
+//   `2^b <= length < 2^(b+1)`.  A bitmap of non-empty bins finds a
+//   sufficiently large range in O(1).
+//
+// Free ranges never overlap and are always merged with their neighbors in
+// the same segment.  Free ranges ending at `mpfr_data_size` are returned to
+// the unused part of the segments.
+//
+// The variables of free ranges keep their significand memory (limbs).  Each
+// free range is tagged with the minimal precision of its variables.  An
+// allocation at the same or a smaller precision preferably reuses such a
+// range, as `mpfr_set_prec` only reallocates the limbs for a larger
+// precision.
+
+#define MPFR_FREE_BINS     64
+#define MPFR_FREE_BIN_SCAN 16  // Ranges to inspect in the best fitting bin.
+
+typedef struct
+{
+  idx_t       range;
+  mpfr_prec_t prec;    // Minimal precision of the variables in `range`.
+  size_t      left;    // AVL tree children.
+  size_t      right;
+  int         height;  // AVL tree height, `0` for "no node".
+  unsigned    bin;     // Size bin of `range`.
+  size_t      prev;    // Size bin list neighbors.
+  size_t      next;    // Also used to link unused nodes.
+} mpfr_free_node_t;
+
+static mpfr_free_node_t *mpfr_free_nodes          = NULL;
+static size_t            mpfr_free_nodes_capacity = 0;
+static size_t            mpfr_free_nodes_unused   = 0;
+static size_t            mpfr_free_tree           = 0;
+static size_t            mpfr_free_bins[MPFR_FREE_BINS];
+static uint64_t          mpfr_free_bins_map = 0;
+static size_t            mpfr_free_list_size = 0;
+
+// Handle table
+// ------------
+//
+// `mpfr_t` objects refer to their index range by a handle, the position
+// (1-based) of the index range in `mpfr_handles`.  Thus an index range can be
+// relocated by `mex_mpfr_compact` without updating the objects.  Unused
+// handles have the start index `0` and are linked by their end index.
+
+static idx_t *mpfr_handles          = NULL;
+static size_t mpfr_handles_capacity = 0;
+static size_t mpfr_handles_unused   = 0;
+static size_t mpfr_handles_size     = 0;  // Number of used handles.
 
-idx_t *mpfr_free_list          = NULL;
-size_t mpfr_free_list_capacity = 0;
-size_t mpfr_free_list_size     = 0;
+// Statistics
+// ----------
+//
+// Counters for `mex_mpfr_get_pool_stats`, all other statistics are computed
+// on demand.
+
+static uint64_t mpfr_stats_live            = 0;
+static uint64_t mpfr_stats_live_high_water = 0;
+static uint64_t mpfr_stats_size_high_water = 0;
+static uint64_t mpfr_stats_allocations     = 0;
+static uint64_t mpfr_stats_frees           = 0;
+
+
+/**
+ * Find the segment of a MPFR variable.
+ *
+ * @param i index (0-based) of the MPFR variable, `i < mpfr_data_capacity`.
+ *
+ * @returns position of the segment in `mpfr_segments`.
+ */
+static inline size_t
+mpfr_segment_of (size_t i)
+{
+  size_t lo = 0;
+  size_t hi = mpfr_segments_size - 1;
+
+  while (lo < hi)
+    {
+      size_t mid = (lo + hi + 1) / 2;
+      if (mpfr_segments[mid].base <= i)
+        lo = mid;
+      else
+        hi = mid - 1;
+    }
+  return (lo);
+}
 
 
 /**
@@ -44,8 +165,29 @@ size_t mpfr_free_list_size     = 0;
 int
 is_valid (idx_t *idx)
 {
-  return ((1 <= (*idx).start) && ((*idx).start <= (*idx).end)
-          && ((*idx).end <= mpfr_data_size));
+  if (! ((1 <= (*idx).start) && ((*idx).start <= (*idx).end)
+         && ((*idx).end <= mpfr_data_size)))
+    return (0);
+
+  mpfr_segment_t *seg = &mpfr_segments[mpfr_segment_of ((*idx).start - 1)];
+  return ((*idx).end <= seg->base + seg->length);
+}
+
+
+/**
+ * Get pointer to MPFR variables.
+ *
+ * @param[in] idx Pointer to valid index (1-based, idx_t) of MPFR variables.
+ *
+ * @returns pointer to the first MPFR variable of @c idx.  All MPFR variables
+ *          of @c idx follow contiguously.
+ */
+mpfr_ptr
+mex_mpfr_ptr (idx_t *idx)
+{
+  mpfr_segment_t *seg = &mpfr_segments[mpfr_segment_of (idx->start - 1)];
+
+  return (seg->data + (idx->start - 1 - seg->base));
 }
 
 
@@ -57,104 +199,565 @@ static void
 mpfr_tidy_up (void)
 {
   DBG_PRINTF ("%s\n", "Call");
-  for (size_t i = 0; i < mpfr_data_size; i++)
-    mpfr_clear (&mpfr_data[i]);
-  mxFree (mpfr_data);
-  mpfr_data          = NULL;
+  mex_mpfr_cache_free ();
+  for (size_t s = 0; s < mpfr_segments_size; s++)
+    {
+      for (size_t i = 0; i < mpfr_segments[s].initialized; i++)
+        mpfr_clear (&mpfr_segments[s].data[i]);
+      mxFree (mpfr_segments[s].data);
+    }
+  mex_gmp_limb_arena_release ();
+  mex_gmp_limb_arena_uninstall ();
+  mex_apa_trace_close ();
+  mpfr_segments_size = 0;
   mpfr_data_capacity = 0;
   mpfr_data_size     = 0;
-  mxFree (mpfr_free_list);
-  mpfr_free_list          = NULL;
-  mpfr_free_list_capacity = 0;
-  mpfr_free_list_size     = 0;
+  mxFree (mpfr_free_nodes);
+  mpfr_free_nodes          = NULL;
+  mpfr_free_nodes_capacity = 0;
+  mpfr_free_nodes_unused   = 0;
+  mpfr_free_tree           = 0;
+  mpfr_free_bins_map       = 0;
+  mpfr_free_list_size      = 0;
+  mxFree (mpfr_handles);
+  mpfr_handles          = NULL;
+  mpfr_handles_capacity = 0;
+  mpfr_handles_unused   = 0;
+  mpfr_handles_size     = 0;
+  mpfr_stats_live            = 0;
+  mpfr_stats_live_high_water = 0;
+  mpfr_stats_size_high_water = 0;
+  mpfr_stats_allocations     = 0;
+  mpfr_stats_frees           = 0;
 }
 
 
 /**
- * Remove the i-th entry from the pool of free MPFR variables.
+ * Append a new segment to the storage of MPFR variables.
+ *
+ * @param count minimal number of MPFR variables in the new segment.
  *
- * @param i index (0-based) to entry to remove from the pool.
+ * @returns success of segment creation.
  */
-void
-mpfr_free_list_remove (size_t i)
+static int
+mpfr_segment_new (size_t count)
 {
-  for (; i < mpfr_free_list_size; i++)
+  if (mpfr_segments_size == MPFR_SEGMENTS_MAX)
+    return (0);
+
+  // Determine new segment length.
+  size_t new_length = (count > mpfr_data_capacity) ? count
+                      : mpfr_data_capacity;
+  new_length = ((new_length + DATA_CHUNK_SIZE - 1) / DATA_CHUNK_SIZE)
+               * DATA_CHUNK_SIZE;
+
+  DBG_PRINTF ("Increase capacity to '%d'.\n", mpfr_data_capacity + new_length);
+  mpfr_ptr data = (mpfr_ptr) mxMalloc (new_length * sizeof(mpfr_t));
+  if (data == NULL)
+    return (0);  // Memory allocation failed.
+
+  mexMakeMemoryPersistent (data);
+  if (mpfr_segments_size == 0)
+    mexAtExit (mpfr_tidy_up);
+
+  mpfr_segment_t *seg = &mpfr_segments[mpfr_segments_size];
+  seg->base        = mpfr_data_capacity;
+  seg->length      = new_length;
+  seg->initialized = 0;
+  seg->data        = data;
+  mpfr_segments_size++;
+  mpfr_data_capacity += new_length;
+  return (1);
+}
+
+
+/**
+ * Ensure the MPFR variables of an index range are initialized with at least
+ * precision `prec`.
+ *
+ * @param[in] idx Pointer to valid index (1-based, idx_t) of MPFR variables.
+ * @param[in] prec Minimal precision of the MPFR variables.
+ */
+static void
+mpfr_segment_init (idx_t *idx, mpfr_prec_t prec)
+{
+  mpfr_segment_t *seg   = &mpfr_segments[mpfr_segment_of (idx->start - 1)];
+  size_t          first = idx->start - 1 - seg->base;
+  size_t          last  = idx->end - seg->base;
+
+  // Allocate the limbs in the limb arena, such that they are contiguous in
+  // memory.  Reused variables of lower precision get their limbs now, too.
+  mex_gmp_limb_arena_begin ();
+  for (size_t i = first; (i < seg->initialized) && (i < last); i++)
+    if (mpfr_get_prec (seg->data + i) < prec)
+      mpfr_set_prec (seg->data + i, prec);
+  for (; seg->initialized < last; seg->initialized++)
+    mpfr_init2 (seg->data + seg->initialized, prec);
+  mex_gmp_limb_arena_end ();
+}
+
+
+/**
+ * Get a node for a new free range.
+ *
+ * @returns position of an unused node in `mpfr_free_nodes` or `0` if memory
+ *          allocation failed.
+ */
+static size_t
+mpfr_free_node_new (void)
+{
+  // Extend space if necessary.
+  if (mpfr_free_nodes_unused == 0)
     {
-      mpfr_free_list[i].start = mpfr_free_list[i + 1].start;
-      mpfr_free_list[i].end   = mpfr_free_list[i + 1].end;
+      size_t new_capacity = mpfr_free_nodes_capacity + DATA_CHUNK_SIZE;
+      DBG_PRINTF ("Increase capacity to '%d'.\n", new_capacity);
+      mpfr_free_node_t *new_nodes = NULL;
+      if (mpfr_free_nodes == NULL)
+        {
+          new_nodes = (mpfr_free_node_t *) mxMalloc (
+            new_capacity * sizeof(mpfr_free_node_t));
+          mexAtExit (mpfr_tidy_up);
+        }
+      else
+        new_nodes = (mpfr_free_node_t *) mxRealloc (
+          mpfr_free_nodes, new_capacity * sizeof(mpfr_free_node_t));
+      if (new_nodes == NULL)
+        return (0);  // Memory allocation failed.
+
+      mexMakeMemoryPersistent (new_nodes);
+      mpfr_free_nodes = new_nodes;
+
+      // Node `0` means "no node" and has height `0`.
+      size_t first = mpfr_free_nodes_capacity;
+      if (first == 0)
+        {
+          memset (&mpfr_free_nodes[0], 0, sizeof(mpfr_free_node_t));
+          first = 1;
+        }
+      for (size_t i = first; i < new_capacity; i++)
+        mpfr_free_nodes[i].next = (i + 1 < new_capacity) ? (i + 1) : 0;
+      mpfr_free_nodes_unused   = first;
+      mpfr_free_nodes_capacity = new_capacity;
     }
+
+  size_t n = mpfr_free_nodes_unused;
+  mpfr_free_nodes_unused = mpfr_free_nodes[n].next;
+  mpfr_free_nodes[n].left   = 0;
+  mpfr_free_nodes[n].right  = 0;
+  mpfr_free_nodes[n].height = 1;
+  mpfr_free_nodes[n].prev   = 0;
+  mpfr_free_nodes[n].next   = 0;
+  mpfr_free_list_size++;
+  return (n);
+}
+
+
+/**
+ * Return a node, no longer part of the tree or any bin, to the unused nodes.
+ *
+ * @param n position of the node in `mpfr_free_nodes`.
+ */
+static void
+mpfr_free_node_delete (size_t n)
+{
+  mpfr_free_nodes[n].next = mpfr_free_nodes_unused;
+  mpfr_free_nodes_unused  = n;
   mpfr_free_list_size--;
 }
 
 
 /**
- * Try to compress the pool of free MPFR variables.
+ * Size bin of an index range length.
+ *
+ * @param len positive index range length.
+ *
+ * @returns bin `b` with `2^b <= len < 2^(b+1)`.
  */
-void
-mpfr_free_list_compress ()
+static inline unsigned
+mpfr_free_bin_of (size_t len)
+{
+  return ((unsigned) (63 - __builtin_clzll ((unsigned long long) len)));
+}
+
+
+/**
+ * Insert a node into the size bin matching its range length.
+ *
+ * @param n position of the node in `mpfr_free_nodes`.
+ */
+static void
+mpfr_free_bin_insert (size_t n)
+{
+  mpfr_free_node_t *node = &mpfr_free_nodes[n];
+  unsigned          b    = mpfr_free_bin_of (length (&node->range));
+
+  node->bin  = b;
+  node->prev = 0;
+  node->next = (mpfr_free_bins_map & (UINT64_C (1) << b))
+               ? mpfr_free_bins[b] : 0;
+  if (node->next)
+    mpfr_free_nodes[node->next].prev = n;
+  mpfr_free_bins[b]   = n;
+  mpfr_free_bins_map |= UINT64_C (1) << b;
+}
+
+
+/**
+ * Remove a node from its size bin.
+ *
+ * @param n position of the node in `mpfr_free_nodes`.
+ */
+static void
+mpfr_free_bin_remove (size_t n)
 {
-  int have_merge = 0;
+  mpfr_free_node_t *node = &mpfr_free_nodes[n];
 
-  do
+  if (node->prev)
+    mpfr_free_nodes[node->prev].next = node->next;
+  else
+    mpfr_free_bins[node->bin] = node->next;
+  if (node->next)
+    mpfr_free_nodes[node->next].prev = node->prev;
+  if (mpfr_free_bins[node->bin] == 0)
+    mpfr_free_bins_map &= ~(UINT64_C (1) << node->bin);
+}
+
+
+/**
+ * Restore the height and AVL balance of a tree node after one of its
+ * subtrees changed.
+ *
+ * @param n position of the subtree root in `mpfr_free_nodes`.
+ *
+ * @returns position of the new subtree root.
+ */
+static size_t
+mpfr_free_tree_balance (size_t n)
+{
+  mpfr_free_node_t *nodes = mpfr_free_nodes;
+
+#define HEIGHT(x) (nodes[(x)].height)
+#define UPDATE(x)                                                           \
+  nodes[(x)].height = 1 + ((HEIGHT (nodes[(x)].left)                        \
+                            > HEIGHT (nodes[(x)].right))                    \
+                           ? HEIGHT (nodes[(x)].left)                       \
+                           : HEIGHT (nodes[(x)].right));
+
+  UPDATE (n);
+  int balance = HEIGHT (nodes[n].left) - HEIGHT (nodes[n].right);
+  if (balance > 1)
     {
-      have_merge = 0;
-      for (size_t i = 0; i < mpfr_free_list_size; i++)
+      size_t l = nodes[n].left;
+      if (HEIGHT (nodes[l].left) < HEIGHT (nodes[l].right))
         {
-          // Rule 1: If end index of entry matches `mpfr_data_size` decrease.
-          if (mpfr_free_list[i].end == mpfr_data_size)
+          // Left-right case: rotate left subtree to the left.
+          size_t lr = nodes[l].right;
+          nodes[l].right = nodes[lr].left;
+          nodes[lr].left = l;
+          UPDATE (l);
+          UPDATE (lr);
+          l = lr;
+        }
+      // Rotate right.
+      nodes[n].left  = nodes[l].right;
+      nodes[l].right = n;
+      UPDATE (n);
+      UPDATE (l);
+      return (l);
+    }
+  if (balance < -1)
+    {
+      size_t r = nodes[n].right;
+      if (HEIGHT (nodes[r].right) < HEIGHT (nodes[r].left))
+        {
+          // Right-left case: rotate right subtree to the right.
+          size_t rl = nodes[r].left;
+          nodes[r].left   = nodes[rl].right;
+          nodes[rl].right = r;
+          UPDATE (r);
+          UPDATE (rl);
+          r = rl;
+        }
+      // Rotate left.
+      nodes[n].right = nodes[r].left;
+      nodes[r].left  = n;
+      UPDATE (n);
+      UPDATE (r);
+      return (r);
+    }
+  return (n);
+
+#undef UPDATE
+#undef HEIGHT
+}
+
+
+/**
+ * Insert a node into the tree ordered by range start index.
+ *
+ * @param root position of the subtree root in `mpfr_free_nodes`.
+ * @param n position of the node to insert.
+ *
+ * @returns position of the new subtree root.
+ */
+static size_t
+mpfr_free_tree_insert (size_t root, size_t n)
+{
+  if (root == 0)
+    return (n);
+  if (mpfr_free_nodes[n].range.start < mpfr_free_nodes[root].range.start)
+    mpfr_free_nodes[root].left = mpfr_free_tree_insert (
+      mpfr_free_nodes[root].left, n);
+  else
+    mpfr_free_nodes[root].right = mpfr_free_tree_insert (
+      mpfr_free_nodes[root].right, n);
+  return (mpfr_free_tree_balance (root));
+}
+
+
+/**
+ * Detach the node with the smallest start index from a tree.
+ *
+ * @param root position of the subtree root in `mpfr_free_nodes`.
+ * @param min  on return position of the detached node.
+ *
+ * @returns position of the new subtree root.
+ */
+static size_t
+mpfr_free_tree_remove_min (size_t root, size_t *min)
+{
+  if (mpfr_free_nodes[root].left == 0)
+    {
+      *min = root;
+      return (mpfr_free_nodes[root].right);
+    }
+  mpfr_free_nodes[root].left = mpfr_free_tree_remove_min (
+    mpfr_free_nodes[root].left, min);
+  return (mpfr_free_tree_balance (root));
+}
+
+
+/**
+ * Remove a node from the tree ordered by range start index.
+ *
+ * @param root position of the subtree root in `mpfr_free_nodes`.
+ * @param n position of the node to remove.
+ *
+ * @returns position of the new subtree root.
+ */
+static size_t
+mpfr_free_tree_remove (size_t root, size_t n)
+{
+  if (root == 0)
+    return (0);
+  if (root != n)
+    {
+      if (mpfr_free_nodes[n].range.start < mpfr_free_nodes[root].range.start)
+        mpfr_free_nodes[root].left = mpfr_free_tree_remove (
+          mpfr_free_nodes[root].left, n);
+      else
+        mpfr_free_nodes[root].right = mpfr_free_tree_remove (
+          mpfr_free_nodes[root].right, n);
+      return (mpfr_free_tree_balance (root));
+    }
+  size_t left  = mpfr_free_nodes[n].left;
+  size_t right = mpfr_free_nodes[n].right;
+  if (right == 0)
+    return (left);
+  if (left == 0)
+    return (right);
+  size_t min = 0;
+  right = mpfr_free_tree_remove_min (right, &min);
+  mpfr_free_nodes[min].left  = left;
+  mpfr_free_nodes[min].right = right;
+  return (mpfr_free_tree_balance (min));
+}
+
+
+/**
+ * Find the free range with the largest start index.
+ *
+ * @returns position of the free range or `0` if there is none.
+ */
+static size_t
+mpfr_free_tree_last (void)
+{
+  size_t n = mpfr_free_tree;
+
+  while ((n != 0) && (mpfr_free_nodes[n].right != 0))
+    n = mpfr_free_nodes[n].right;
+  return (n);
+}
+
+
+/**
+ * Find the free ranges right before and after a start index.
+ *
+ * @param[in] start start index (1-based).
+ * @param[out] pred position of the free range with the largest start index
+ *                  less than @c start or `0`.
+ * @param[out] succ position of the free range with the smallest start index
+ *                  greater or equal than @c start or `0`.
+ */
+static void
+mpfr_free_tree_neighbors (size_t start, size_t *pred, size_t *succ)
+{
+  *pred = 0;
+  *succ = 0;
+  for (size_t n = mpfr_free_tree; n != 0;)
+    if (mpfr_free_nodes[n].range.start < start)
+      {
+        *pred = n;
+        n     = mpfr_free_nodes[n].right;
+      }
+    else
+      {
+        *succ = n;
+        n     = mpfr_free_nodes[n].left;
+      }
+}
+
+
+/**
+ * Remove a free range from the pool of free MPFR variables.
+ *
+ * @param n position of the free range in `mpfr_free_nodes`.
+ */
+static void
+mpfr_free_list_remove (size_t n)
+{
+  mpfr_free_bin_remove (n);
+  mpfr_free_tree = mpfr_free_tree_remove (mpfr_free_tree, n);
+  mpfr_free_node_delete (n);
+}
+
+
+/**
+ * Add a free range, not adjacent to another free range of the same segment,
+ * to the pool of free MPFR variables.
+ *
+ * @param range index range (1-based, idx_t) of the free MPFR variables.
+ * @param prec minimal precision of the MPFR variables or `0` if they might be
+ *             not initialized.
+ *
+ * @returns success of the insertion.
+ */
+static int
+mpfr_free_list_insert (idx_t range, mpfr_prec_t prec)
+{
+  size_t n = mpfr_free_node_new ();
+
+  if (n == 0)
+    return (0);  // Memory allocation failed.
+
+  mpfr_free_nodes[n].range = range;
+  mpfr_free_nodes[n].prec  = prec;
+  mpfr_free_tree = mpfr_free_tree_insert (mpfr_free_tree, n);
+  mpfr_free_bin_insert (n);
+  return (1);
+}
+
+
+/**
+ * Find a free range of at least @c count MPFR variables.
+ *
+ * First the bin of @c count is searched for a range of sufficient size.
+ * Then the larger non-empty bins are searched, where each range fits.  To
+ * limit the search time, only the first `MPFR_FREE_BIN_SCAN` ranges of each
+ * bin are inspected.  The first inspected range, whose variables have at least
+ * precision @c prec, is taken.  Otherwise the first inspected range of
+ * sufficient size.  Only if no range was found, the remaining ranges of the
+ * first bin are inspected.
+ *
+ * @param count number of MPFR variables.
+ * @param prec desired precision of the MPFR variables.
+ *
+ * @returns position of the free range or `0` if no free range fits.
+ */
+static size_t
+mpfr_free_list_find (size_t count, mpfr_prec_t prec)
+{
+  unsigned b     = mpfr_free_bin_of (count);
+  uint64_t bins  = (mpfr_free_bins_map >> b) << b;
+  size_t   first = 0;
+
+  while (bins)
+    {
+      unsigned bb = (unsigned) __builtin_ctzll (bins);
+      size_t   n  = mpfr_free_bins[bb];
+      for (size_t i = 0; (n != 0) && (i < MPFR_FREE_BIN_SCAN); i++)
+        {
+          if (count <= length (&mpfr_free_nodes[n].range))
             {
-              have_merge = 1;
-              DBG_PRINTF ("mmgr: Rule 1 for [%d:%d].\n",
-                          mpfr_free_list[i].start, mpfr_free_list[i].end);
-              mpfr_data_size = mpfr_free_list[i].start - 1;
-              mpfr_free_list_remove (i);
-              break;
+              if (mpfr_free_nodes[n].prec >= prec)
+                return (n);
+              if (first == 0)
+                first = n;
             }
-          // Rule 2: Merge neighboring entries.
-          int do_break = 0;
-          for (size_t j = i + 1; j < mpfr_free_list_size; j++)
-            if ((mpfr_free_list[i].end + 1 == mpfr_free_list[j].start)
-                || (mpfr_free_list[j].end + 1 == mpfr_free_list[i].start))
-              {
-                have_merge = 1;
-                do_break   = 1;
-                DBG_PRINTF ("mmgr: Rule 2 for [%d:%d] + [%d:%d].\n",
-                            mpfr_free_list[i].start, mpfr_free_list[i].end,
-                            mpfr_free_list[j].start, mpfr_free_list[j].end);
-                mpfr_free_list[i].start =
-                  (mpfr_free_list[i].start <= mpfr_free_list[j].start
-                   ? mpfr_free_list[i].start
-                   : mpfr_free_list[j].start);
-                mpfr_free_list[i].end =
-                  (mpfr_free_list[i].end >= mpfr_free_list[j].end
-                   ? mpfr_free_list[i].end
-                   : mpfr_free_list[j].end);
-                mpfr_free_list_remove (j);
-                break;
-              }
-          if (do_break)
-            break;
+          n = mpfr_free_nodes[n].next;
         }
-    } while (have_merge);
+      bins &= bins - 1;
 
-  /* Very verbose debug output.
-   * for (size_t i = 0; i < mpfr_free_list_size; i++)
-   * DBG_PRINTF ("mmgr: mpfr_free_list[%d] = [%d:%d].\n", i,
-   *            mpfr_free_list[i].start, mpfr_free_list[i].end);
-   */
+      // Exhaustive search of the first bin, if there is no larger bin.
+      if ((bins == 0) && (bb == b) && (first == 0))
+        for (; n != 0; n = mpfr_free_nodes[n].next)
+          if (count <= length (&mpfr_free_nodes[n].range))
+            return (n);
+    }
+  return (first);
 }
 
 
 /**
- * Mark MPFR variable as no longer used.
+ * Count an allocation of MPFR variables in the statistics.
+ *
+ * @param count number of allocated MPFR variables.
+ */
+static void
+mpfr_stats_allocated (size_t count)
+{
+  mpfr_stats_allocations++;
+  mpfr_stats_live += count;
+  if (mpfr_stats_live > mpfr_stats_live_high_water)
+    mpfr_stats_live_high_water = mpfr_stats_live;
+  if (mpfr_data_size > mpfr_stats_size_high_water)
+    mpfr_stats_size_high_water = mpfr_data_size;
+}
+
+
+/**
+ * Return the free ranges ending at `mpfr_data_size` to the unused part of the
+ * segments (Rule 1).
+ */
+static void
+mpfr_free_list_trim (void)
+{
+  // Rule 1: If end index of entry matches `mpfr_data_size` decrease.  Repeat
+  //         for free ranges at the end of previous segments.
+  for (size_t n = mpfr_free_tree_last ();
+       (n != 0) && (mpfr_free_nodes[n].range.end == mpfr_data_size);
+       n = mpfr_free_tree_last ())
+    {
+      DBG_PRINTF ("mmgr: Rule 1 for [%d:%d].\n",
+                  mpfr_free_nodes[n].range.start,
+                  mpfr_free_nodes[n].range.end);
+      mpfr_data_size = mpfr_free_nodes[n].range.start - 1;
+      mpfr_free_list_remove (n);
+    }
+}
+
+
+/**
+ * Add MPFR variables to the pool of free MPFR variables.
+ *
+ * The variables are merged with adjacent free ranges of the same segment
+ * (Rule 2).  The caller has to apply Rule 1 by `mpfr_free_list_trim`.
  *
  * @param[in] idx Pointer to index (1-based, idx_t) of MPFR variable to be no
  *                longer used.
- *
- * @returns success of MPFR variables creation.
  */
-void
-mex_mpfr_mark_free (idx_t *idx)
+static void
+mpfr_mark_free (idx_t *idx)
 {
   // Check for impossible start and end index.
   if (! is_valid (idx))
@@ -163,46 +766,114 @@ mex_mpfr_mark_free (idx_t *idx)
       return;
     }
 
-  // Extend space if necessary.
-  if (mpfr_free_list_size == mpfr_free_list_capacity)
+  // Check for overlap with free ranges, e.g. double free.
+  size_t pred = 0;
+  size_t succ = 0;
+  mpfr_free_tree_neighbors (idx->start, &pred, &succ);
+  if (((pred != 0) && (mpfr_free_nodes[pred].range.end >= idx->start))
+      || ((succ != 0) && (mpfr_free_nodes[succ].range.start <= idx->end)))
     {
-      size_t new_capacity = mpfr_free_list_capacity + DATA_CHUNK_SIZE;
-      DBG_PRINTF ("Increase capacity to '%d'.\n", new_capacity);
-      if (mpfr_free_list == NULL)
+      DBG_PRINTF ("mmgr: [%d:%d] is already free.\n", idx->start, idx->end);
+      return;
+    }
+  mpfr_stats_frees++;
+  mpfr_stats_live -= length (idx);
+
+  // Keep the limbs of the MPFR variables, remember the minimal precision.
+  mpfr_ptr    ptr  = mex_mpfr_ptr (idx);
+  mpfr_prec_t prec = MPFR_PREC_MAX;
+  for (size_t i = 0; i < length (idx); i++)
+    if (mpfr_get_prec (ptr + i) < prec)
+      prec = mpfr_get_prec (ptr + i);
+
+  // Do not merge across segment boundaries.
+  mpfr_segment_t *seg = &mpfr_segments[mpfr_segment_of (idx->start - 1)];
+  if (seg->base + 1 == idx->start)
+    pred = 0;
+  if (seg->base + seg->length == idx->end)
+    succ = 0;
+
+  // Rule 2: Merge neighboring entries.  The order of the tree is preserved
+  //         when extending a range into the new gap, no rebalancing needed.
+  size_t n = 0;
+  if ((pred != 0) && (mpfr_free_nodes[pred].range.end + 1 == idx->start))
+    {
+      DBG_PRINTF ("mmgr: Rule 2 for [%d:%d] + [%d:%d].\n",
+                  mpfr_free_nodes[pred].range.start,
+                  mpfr_free_nodes[pred].range.end, idx->start, idx->end);
+      n = pred;
+      mpfr_free_bin_remove (n);
+      mpfr_free_nodes[n].range.end = idx->end;
+      if (prec < mpfr_free_nodes[n].prec)
+        mpfr_free_nodes[n].prec = prec;
+      if ((succ != 0) && (mpfr_free_nodes[succ].range.start == idx->end + 1))
         {
-          mpfr_free_list = (idx_t *) mxMalloc (new_capacity * sizeof(idx_t));
-          mexAtExit (mpfr_tidy_up);
+          DBG_PRINTF ("mmgr: Rule 2 for [%d:%d] + [%d:%d].\n",
+                      mpfr_free_nodes[n].range.start,
+                      mpfr_free_nodes[n].range.end,
+                      mpfr_free_nodes[succ].range.start,
+                      mpfr_free_nodes[succ].range.end);
+          mpfr_free_nodes[n].range.end = mpfr_free_nodes[succ].range.end;
+          if (mpfr_free_nodes[succ].prec < mpfr_free_nodes[n].prec)
+            mpfr_free_nodes[n].prec = mpfr_free_nodes[succ].prec;
+          mpfr_free_list_remove (succ);
         }
-      else
-        mpfr_free_list = (idx_t *) mxRealloc (mpfr_free_list,
-                                              new_capacity * sizeof(idx_t));
-      if (mpfr_free_list == NULL)
-        return;  // Memory allocation failed.
-
-      mexMakeMemoryPersistent (mpfr_free_list);
-      mpfr_free_list_capacity = new_capacity;
     }
-
-  // Reinitialize MPFR variables (free significant memory).
-  for (size_t i = idx->start - 1; i < idx->end; i++)
+  else if ((succ != 0)
+           && (mpfr_free_nodes[succ].range.start == idx->end + 1))
     {
-      mpfr_clear (mpfr_data + i);
-      mpfr_init (mpfr_data + i);
+      DBG_PRINTF ("mmgr: Rule 2 for [%d:%d] + [%d:%d].\n",
+                  idx->start, idx->end, mpfr_free_nodes[succ].range.start,
+                  mpfr_free_nodes[succ].range.end);
+      n = succ;
+      mpfr_free_bin_remove (n);
+      mpfr_free_nodes[n].range.start = idx->start;
+      if (prec < mpfr_free_nodes[n].prec)
+        mpfr_free_nodes[n].prec = prec;
+    }
+  else
+    {
+      n = mpfr_free_node_new ();
+      if (n == 0)
+        return;  // Memory allocation failed.
+      mpfr_free_nodes[n].range = *idx;
+      mpfr_free_nodes[n].prec  = prec;
+      mpfr_free_tree = mpfr_free_tree_insert (mpfr_free_tree, n);
     }
+  mpfr_free_bin_insert (n);
+}
 
-  // Append reinitialized variables to pool.
-  mpfr_free_list[mpfr_free_list_size].start = idx->start;
-  mpfr_free_list[mpfr_free_list_size].end   = idx->end;
-  mpfr_free_list_size++;
 
-  mpfr_free_list_compress ();
+/**
+ * Mark MPFR variable as no longer used.
+ *
+ * The variables are merged with adjacent free ranges of the same segment
+ * (Rule 2).  If the resulting range ends at `mpfr_data_size`, it is returned
+ * to the unused part of the segments (Rule 1).
+ *
+ * @param[in] idx Pointer to index (1-based, idx_t) of MPFR variable to be no
+ *                longer used.
+ *
+ * @returns success of MPFR variables creation.
+ */
+void
+mex_mpfr_mark_free (idx_t *idx)
+{
+  mpfr_mark_free (idx);
+  mpfr_free_list_trim ();
 }
 
 
 /**
  * Constructor for new MPFR variables.
  *
+ * The MPFR variables have an unspecified precision and value.  Previously
+ * freed variables of at least precision @c prec are preferred, as setting
+ * their precision to @c prec does not allocate memory.  Newly initialized
+ * variables have precision @c prec.
+ *
  * @param[in] count Number of MPFR variables to create.
+ * @param[in] prec Desired precision of the MPFR variables.
  * @param[out] idx If function returns `1`, pointer to index (1-based, idx_t)
  *                 of MPFR variables, otherwise the value of `idx` remains
  *                 unchanged.
@@ -210,61 +881,702 @@ mex_mpfr_mark_free (idx_t *idx)
  * @returns success of MPFR variable creation.
  */
 int
-mex_mpfr_allocate (size_t count, idx_t *idx)
+mex_mpfr_allocate (size_t count, mpfr_prec_t prec, idx_t *idx)
 {
   // Check for trivial case, failure as indices do not make sense.
   if (count == 0)
     return (0);
 
   // Try to reuse a free marked variable from the pool.
-  for (size_t i = 0; i < mpfr_free_list_size; i++)
-    if (count <= length (mpfr_free_list + i))
-      {
-        idx->start = mpfr_free_list[i].start;
-        idx->end   = mpfr_free_list[i].start + count - 1;
-        DBG_PRINTF ("New MPFR variable [%d:%d] reused.\n",
-                    idx->start, idx->end);
-        if (count < length (mpfr_free_list + i))
-          mpfr_free_list[i].start += count;
-        else
-          mpfr_free_list_remove (i);
-        return (is_valid (idx));
-      }
-
-  // Check if there is enough space to create new MPFR variables.
-  if ((mpfr_data_size + count) > mpfr_data_capacity)
+  size_t n = mpfr_free_list_find (count, prec);
+  if (n != 0)
     {
-      // Determine new capacity.
-      size_t new_capacity = mpfr_data_capacity;
-      while ((mpfr_data_size + count) > new_capacity)
-        new_capacity += DATA_CHUNK_SIZE;
-
-      DBG_PRINTF ("Increase capacity to '%d'.\n", new_capacity);
-      // Reallocate memory.
-      if (mpfr_data == NULL)
+      idx->start = mpfr_free_nodes[n].range.start;
+      idx->end   = mpfr_free_nodes[n].range.start + count - 1;
+      DBG_PRINTF ("New MPFR variable [%d:%d] reused.\n",
+                  idx->start, idx->end);
+      if (count < length (&mpfr_free_nodes[n].range))
         {
-          mpfr_data = (mpfr_ptr) mxMalloc (new_capacity * sizeof(mpfr_t));
-          mexAtExit (mpfr_tidy_up);
+          // Shrinking from the start preserves the order of the tree.
+          mpfr_free_bin_remove (n);
+          mpfr_free_nodes[n].range.start += count;
+          mpfr_free_bin_insert (n);
         }
       else
-        mpfr_data =
-          (mpfr_ptr) mxRealloc (mpfr_data, new_capacity * sizeof(mpfr_t));
-      if (mpfr_data == NULL)
-        return (0); // Memory allocation failed.
+        mpfr_free_list_remove (n);
+      mpfr_segment_init (idx, prec);
+      mpfr_stats_allocated (count);
+      return (is_valid (idx));
+    }
 
-      mexMakeMemoryPersistent (mpfr_data);
+  // Find the first segment with enough unused space.  Create a new segment
+  // if necessary.
+  size_t s = (mpfr_data_size < mpfr_data_capacity)
+             ? mpfr_segment_of (mpfr_data_size) : mpfr_segments_size;
+  for (;; s++)
+    {
+      if ((s == mpfr_segments_size) && ! mpfr_segment_new (count))
+        return (0);  // Memory allocation failed.
 
-      // Initialize new MPFR variables.
-      for (size_t i = mpfr_data_capacity; i < new_capacity; i++)
-        mpfr_init (mpfr_data + i);
+      size_t seg_end = mpfr_segments[s].base + mpfr_segments[s].length;
+      if (mpfr_data_size + count <= seg_end)
+        break;
 
-      mpfr_data_capacity = new_capacity;
+      // The remaining variables of the segment become a free range.
+      if (mpfr_data_size < seg_end)
+        {
+          idx_t tail = { mpfr_data_size + 1, seg_end };
+          if (! mpfr_free_list_insert (tail, 0))  // Maybe not initialized.
+            return (0);  // Memory allocation failed.
+          DBG_PRINTF ("mmgr: [%d:%d] left free at end of segment.\n",
+                      tail.start, tail.end);
+          mpfr_data_size = seg_end;
+        }
     }
 
   idx->start      = mpfr_data_size + 1;
   mpfr_data_size += count;
   idx->end        = mpfr_data_size;
   DBG_PRINTF ("New MPFR variable [%d:%d] allocated.\n", idx->start, idx->end);
+  mpfr_segment_init (idx, prec);
+  mpfr_stats_allocated (count);
   return (is_valid (idx));
 }
 
+
+/**
+ * Ensure that at least @c num handles are unused.
+ *
+ * @param num number of handles.
+ *
+ * @returns success of memory allocation.
+ */
+static int
+mpfr_handles_reserve (size_t num)
+{
+  size_t needed = mpfr_handles_size + num + 1;  // Handle `0` is reserved.
+
+  if (needed <= mpfr_handles_capacity)
+    return (1);
+
+  // Extend space.
+  size_t new_capacity = ((needed + DATA_CHUNK_SIZE - 1) / DATA_CHUNK_SIZE)
+                        * DATA_CHUNK_SIZE;
+  DBG_PRINTF ("Increase capacity to '%d'.\n", new_capacity);
+  idx_t *new_handles = NULL;
+  if (mpfr_handles == NULL)
+    {
+      new_handles = (idx_t *) mxMalloc (new_capacity * sizeof(idx_t));
+      mexAtExit (mpfr_tidy_up);
+    }
+  else
+    new_handles = (idx_t *) mxRealloc (mpfr_handles,
+                                       new_capacity * sizeof(idx_t));
+  if (new_handles == NULL)
+    return (0);  // Memory allocation failed.
+
+  mexMakeMemoryPersistent (new_handles);
+  mpfr_handles = new_handles;
+
+  // Handle `0` means "no handle".  Prepend the new handles to the unused
+  // ones.
+  size_t first = (mpfr_handles_capacity == 0) ? 1 : mpfr_handles_capacity;
+  mpfr_handles[0].start = 0;
+  mpfr_handles[0].end   = 0;
+  for (size_t h = first; h < new_capacity; h++)
+    {
+      mpfr_handles[h].start = 0;
+      mpfr_handles[h].end   = (h + 1 < new_capacity) ? (h + 1)
+                              : mpfr_handles_unused;
+    }
+  mpfr_handles_unused   = first;
+  mpfr_handles_capacity = new_capacity;
+  return (1);
+}
+
+
+/**
+ * Assign an index range to an unused handle.
+ *
+ * At least one handle must be unused, see `mpfr_handles_reserve`.
+ *
+ * @param idx index (1-based, idx_t) of the MPFR variables.
+ *
+ * @returns handle (1-based) of @c idx.
+ */
+static size_t
+mpfr_handle_assign (idx_t idx)
+{
+  size_t h = mpfr_handles_unused;
+
+  mpfr_handles_unused = mpfr_handles[h].end;
+  mpfr_handles[h]     = idx;
+  mpfr_handles_size++;
+  DBG_PRINTF ("mmgr: handle %d for [%d:%d].\n", (int) h, idx.start, idx.end);
+  return (h);
+}
+
+
+/**
+ * Mark a used handle as unused.
+ *
+ * @param handle valid handle (1-based).
+ */
+static void
+mpfr_handle_release (size_t handle)
+{
+  mpfr_handles[handle].start = 0;
+  mpfr_handles[handle].end   = mpfr_handles_unused;
+  mpfr_handles_unused        = handle;
+  mpfr_handles_size--;
+}
+
+
+/**
+ * Create MPFR variables referred to by a handle.
+ *
+ * See `mex_mpfr_allocate` for the MPFR variables.
+ *
+ * @param[in] count Number of MPFR variables to create.
+ * @param[in] prec Desired precision of the MPFR variables.
+ * @param[out] handle If function returns `1`, handle (1-based) of the index
+ *                    range of the MPFR variables, otherwise the value of
+ *                    `handle` remains unchanged.
+ *
+ * @returns success of MPFR variable creation.
+ */
+int
+mex_mpfr_handle_new (size_t count, mpfr_prec_t prec, size_t *handle)
+{
+  idx_t idx;
+
+  if (! mpfr_handles_reserve (1) || ! mex_mpfr_allocate (count, prec, &idx))
+    return (0);
+
+  *handle = mpfr_handle_assign (idx);
+  return (1);
+}
+
+
+/**
+ * Get the index range of a handle.
+ *
+ * @param[in] handle handle (1-based) of an index range.
+ * @param[out] idx If function returns `1`, index (1-based, idx_t) of the MPFR
+ *                 variables, otherwise the value of `idx` remains unchanged.
+ *
+ * @returns `0` if `handle` is invalid, otherwise `handle` is valid.
+ */
+int
+mex_mpfr_handle_get (size_t handle, idx_t *idx)
+{
+  if ((handle == 0) || (handle >= mpfr_handles_capacity)
+      || (mpfr_handles[handle].start == 0))
+    return (0);
+
+  *idx = mpfr_handles[handle];
+  return (1);
+}
+
+
+/**
+ * Mark the MPFR variables of a handle as no longer used and release the
+ * handle.
+ *
+ * @param[in] handle valid handle (1-based) of an index range.
+ */
+void
+mex_mpfr_handle_free (size_t handle)
+{
+  idx_t idx;
+
+  if (! mex_mpfr_handle_get (handle, &idx))
+    return;
+
+  mex_mpfr_mark_free (&idx);
+  mpfr_handle_release (handle);
+}
+
+
+/**
+ * Create MPFR variables for several handles.
+ *
+ * The index ranges are allocated as one contiguous index range (see
+ * `mex_mpfr_allocate`) of the minimal precision, which is split afterwards.
+ * If the function fails, no MPFR variables are created.
+ *
+ * @param[in] num number of handles to create.
+ * @param[in] count number of MPFR variables for each handle.
+ * @param[in] prec desired precision of the MPFR variables for each handle.
+ * @param[out] handle If function returns `1`, handles (1-based) of the index
+ *                    ranges of the MPFR variables, otherwise the value of
+ *                    `handle` remains unchanged.
+ *
+ * @returns success of MPFR variable creation.
+ */
+int
+mex_mpfr_handle_new_batch (size_t num, const size_t *count,
+                           const mpfr_prec_t *prec, size_t *handle)
+{
+  size_t      total    = 0;
+  mpfr_prec_t min_prec = MPFR_PREC_MAX;
+
+  for (size_t i = 0; i < num; i++)
+    {
+      if (count[i] == 0)
+        return (0);
+      total += count[i];
+      if (prec[i] < min_prec)
+        min_prec = prec[i];
+    }
+
+  idx_t idx;
+  if ((num == 0) || ! mpfr_handles_reserve (num)
+      || ! mex_mpfr_allocate (total, min_prec, &idx))
+    return (0);
+  mpfr_stats_allocations += num - 1;  // Count each index range.
+
+  for (size_t i = 0, start = idx.start; i < num; start += count[i++])
+    {
+      idx_t range = { start, start + count[i] - 1 };
+      if (prec[i] > min_prec)
+        mpfr_segment_init (&range, prec[i]);
+      handle[i] = mpfr_handle_assign (range);
+    }
+  return (1);
+}
+
+
+/**
+ * Mark the MPFR variables of several handles as no longer used and release
+ * the handles.
+ *
+ * Invalid handles are ignored.  Rule 1 is applied once for all handles.
+ *
+ * @param[in] num number of handles.
+ * @param[in] handle handles (1-based) of index ranges.
+ */
+void
+mex_mpfr_handle_free_batch (size_t num, const size_t *handle)
+{
+  idx_t idx;
+
+  for (size_t i = 0; i < num; i++)
+    if (mex_mpfr_handle_get (handle[i], &idx))
+      {
+        mpfr_mark_free (&idx);
+        mpfr_handle_release (handle[i]);
+      }
+  mpfr_free_list_trim ();
+}
+
+
+/**
+ * Collect the free ranges of a subtree in address order.
+ *
+ * @param[in] n root of the subtree.
+ * @param[out] ranges array of free ranges.
+ * @param[in] i position in @c ranges for the first free range.
+ *
+ * @returns position in @c ranges after the last free range.
+ */
+static size_t
+mpfr_free_tree_collect (size_t n, idx_t *ranges, size_t i)
+{
+  if (n == 0)
+    return (i);
+
+  i           = mpfr_free_tree_collect (mpfr_free_nodes[n].left, ranges, i);
+  ranges[i++] = mpfr_free_nodes[n].range;
+  return (mpfr_free_tree_collect (mpfr_free_nodes[n].right, ranges, i));
+}
+
+
+/**
+ * Compare two handles by the start index of their index range (qsort).
+ */
+static int
+mpfr_handle_cmp (const void *a, const void *b)
+{
+  size_t start_a = mpfr_handles[*((const size_t *) a)].start;
+  size_t start_b = mpfr_handles[*((const size_t *) b)].start;
+
+  return ((start_a > start_b) - (start_a < start_b));
+}
+
+
+/**
+ * Return unused MPFR variables between occupied index ranges to the pool of
+ * free MPFR variables.  Their limbs are released.
+ *
+ * @param start first unused index (1-based).
+ * @param end last unused index (1-based), `end < start` for none.
+ *
+ * @returns success of the insertion.
+ */
+static int
+mpfr_compact_release (size_t start, size_t end)
+{
+  // Free ranges must not cross segment boundaries.
+  while (start <= end)
+    {
+      mpfr_segment_t *seg   = &mpfr_segments[mpfr_segment_of (start - 1)];
+      size_t          first = start - 1 - seg->base;
+      size_t          last  = seg->base + seg->length;
+      idx_t           range = { start, (end < last) ? end : last };
+
+      last = range.end - seg->base;
+      mex_gmp_limb_arena_begin ();
+      for (size_t i = first; (i < seg->initialized) && (i < last); i++)
+        {
+          mpfr_clear (seg->data + i);
+          mpfr_init2 (seg->data + i, MPFR_PREC_MIN);
+        }
+      mex_gmp_limb_arena_end ();
+      if (! mpfr_free_list_insert (range, (last <= seg->initialized)
+                                   ? MPFR_PREC_MIN : 0))
+        return (0);  // Memory allocation failed.
+
+      start = range.end + 1;
+    }
+  return (1);
+}
+
+
+/**
+ * Compact the pool of MPFR variables and release unused memory.
+ *
+ * The index ranges of handles are relocated to the lowest possible position
+ * in address order, the MPFR variables are moved by `mpfr_swap` without
+ * copying their values.  Index ranges without handle (see
+ * `mex_mpfr_allocate`) remain in place.  Afterwards the limbs of all unused
+ * MPFR variables and all unused segments are released.
+ *
+ * Index ranges obtained from handles before the compaction are no longer
+ * valid.
+ *
+ * @returns number of released MPFR variables of the capacity.
+ */
+size_t
+mex_mpfr_compact (void)
+{
+  size_t old_capacity = mpfr_data_capacity;
+  size_t num_free     = mpfr_free_list_size;
+  size_t num_handles  = 0;
+  size_t num_pinned   = 0;
+  size_t moved        = 0;
+
+  idx_t  *free_ranges = (idx_t *) mxMalloc ((num_free + 1) * sizeof(idx_t));
+  size_t *handles     = (size_t *) mxMalloc ((mpfr_handles_size + 1)
+                                             * sizeof(size_t));
+  idx_t  *pinned      = (idx_t *) mxMalloc ((num_free + mpfr_handles_size + 1)
+                                            * sizeof(idx_t));
+  if ((free_ranges == NULL) || (handles == NULL) || (pinned == NULL))
+    {
+      mxFree (free_ranges);
+      mxFree (handles);
+      mxFree (pinned);
+      return (0);  // Memory allocation failed.
+    }
+
+  // Collect free ranges and handles of allocated index ranges in address
+  // order.  Handles of invalid or overlapping index ranges are not relocated.
+  mpfr_free_tree_collect (mpfr_free_tree, free_ranges, 0);
+  for (size_t h = 1; h < mpfr_handles_capacity; h++)
+    {
+      idx_t *range = &mpfr_handles[h];
+      size_t pred  = 0;
+      size_t succ  = 0;
+      if ((range->start == 0) || ! is_valid (range))
+        continue;
+      mpfr_free_tree_neighbors (range->start, &pred, &succ);
+      if (((pred != 0) && (mpfr_free_nodes[pred].range.end >= range->start))
+          || ((succ != 0) && (mpfr_free_nodes[succ].range.start <= range->end)))
+        continue;
+      handles[num_handles++] = h;
+    }
+  qsort (handles, num_handles, sizeof(size_t), mpfr_handle_cmp);
+  size_t j = 0;
+  for (size_t i = 0; i < num_handles; i++)
+    if ((j == 0) || (mpfr_handles[handles[j - 1]].end
+                     < mpfr_handles[handles[i]].start))
+      handles[j++] = handles[i];
+  num_handles = j;
+
+  // All other allocated index ranges are pinned.
+  size_t f = 0;
+  j = 0;
+  for (size_t pos = 1; pos <= mpfr_data_size;)
+    {
+      size_t next_free = (f < num_free) ? free_ranges[f].start
+                         : mpfr_data_size + 1;
+      size_t next_handle = (j < num_handles)
+                           ? mpfr_handles[handles[j]].start
+                           : mpfr_data_size + 1;
+      size_t next = (next_free < next_handle) ? next_free : next_handle;
+      if (pos < next)
+        {
+          pinned[num_pinned].start = pos;
+          pinned[num_pinned].end   = next - 1;
+          num_pinned++;
+        }
+      if (next > mpfr_data_size)
+        break;
+      if (next_free < next_handle)
+        pos = free_ranges[f++].end + 1;
+      else
+        pos = mpfr_handles[handles[j++]].end + 1;
+    }
+
+  // Relocate the index ranges of handles in address order to the lowest
+  // position, which is not pinned and within one segment.  This position is
+  // never above the current position.
+  size_t pos = 1;
+  size_t k   = 0;
+  for (j = 0; j < num_handles; j++)
+    {
+      idx_t *range = &mpfr_handles[handles[j]];
+      size_t len   = length (range);
+      for (;;)
+        {
+          while ((k < num_pinned) && (pinned[k].end < pos))
+            k++;
+          mpfr_segment_t *seg = &mpfr_segments[mpfr_segment_of (pos - 1)];
+          size_t seg_end = seg->base + seg->length;
+          if (pos + len - 1 > seg_end)
+            pos = seg_end + 1;
+          else if ((k < num_pinned) && (pinned[k].start < pos + len))
+            pos = pinned[k].end + 1;
+          else
+            break;
+        }
+      if (pos < range->start)
+        {
+          // Swapping in ascending order is safe for overlapping ranges.
+          idx_t dest = { pos, pos + len - 1 };
+          mpfr_segment_init (&dest, MPFR_PREC_MIN);
+          mpfr_ptr dest_ptr = mex_mpfr_ptr (&dest);
+          mpfr_ptr src_ptr  = mex_mpfr_ptr (range);
+          for (size_t i = 0; i < len; i++)
+            mpfr_swap (dest_ptr + i, src_ptr + i);
+          DBG_PRINTF ("mmgr: [%d:%d] relocated to [%d:%d].\n",
+                      range->start, range->end, dest.start, dest.end);
+          *range = dest;
+          moved += len;
+        }
+      pos = range->end + 1;
+    }
+
+  // Rebuild the pool of free MPFR variables from the gaps between pinned
+  // and relocated index ranges.
+  while (mpfr_free_tree != 0)
+    mpfr_free_list_remove (mpfr_free_tree);
+  size_t new_size = (num_pinned > 0) ? pinned[num_pinned - 1].end : 0;
+  if ((num_handles > 0) && (mpfr_handles[handles[num_handles - 1]].end
+                            > new_size))
+    new_size = mpfr_handles[handles[num_handles - 1]].end;
+  mpfr_data_size = new_size;
+  pos = 1;
+  k   = 0;
+  j   = 0;
+  while ((k < num_pinned) || (j < num_handles))
+    {
+      idx_t *next = NULL;
+      if ((j == num_handles) || ((k < num_pinned)
+                                 && (pinned[k].start
+                                     < mpfr_handles[handles[j]].start)))
+        next = &pinned[k++];
+      else
+        next = &mpfr_handles[handles[j++]];
+      if (! mpfr_compact_release (pos, next->start - 1))
+        break;  // Memory allocation failed.
+      pos = next->end + 1;
+    }
+
+  // Release unused segments and the limbs of unused MPFR variables.
+  while ((mpfr_segments_size > 0)
+         && (mpfr_segments[mpfr_segments_size - 1].base >= new_size))
+    {
+      mpfr_segment_t *seg = &mpfr_segments[mpfr_segments_size - 1];
+      for (size_t i = 0; i < seg->initialized; i++)
+        mpfr_clear (seg->data + i);
+      mxFree (seg->data);
+      mpfr_data_capacity -= seg->length;
+      mpfr_segments_size--;
+    }
+  if (mpfr_segments_size > 0)
+    {
+      mpfr_segment_t *seg  = &mpfr_segments[mpfr_segments_size - 1];
+      size_t          used = new_size - seg->base;
+      for (; seg->initialized > used; seg->initialized--)
+        mpfr_clear (seg->data + seg->initialized - 1);
+    }
+
+  // Return the chunks of the freed limbs.
+  mex_gmp_limb_arena_trim ();
+
+  DBG_PRINTF ("mmgr: %d variables relocated, capacity %d -> %d.\n",
+              (int) moved, (int) old_capacity, (int) mpfr_data_capacity);
+  mxFree (free_ranges);
+  mxFree (handles);
+  mxFree (pinned);
+  return (old_capacity - mpfr_data_capacity);
+}
+
+
+/**
+ * Get the statistics of the pool of MPFR variables.
+ *
+ * @param reset if non-zero, reset the counters `allocations` and `frees` and
+ *              the high-water marks to the current values after reading.
+ *
+ * @returns current pool statistics.
+ */
+mpfr_pool_stats_t
+mex_mpfr_get_pool_stats (int reset)
+{
+  mpfr_pool_stats_t stats;
+
+  stats.live_variables       = mpfr_stats_live;
+  stats.live_high_water      = mpfr_stats_live_high_water;
+  stats.data_size            = mpfr_data_size;
+  stats.data_size_high_water = mpfr_stats_size_high_water;
+  stats.data_capacity        = mpfr_data_capacity;
+  stats.segments             = mpfr_segments_size;
+  stats.handles              = mpfr_handles_size;
+  stats.free_ranges          = mpfr_free_list_size;
+  stats.free_variables       = 0;
+  stats.largest_free_range   = 0;
+  stats.allocations          = mpfr_stats_allocations;
+  stats.frees                = mpfr_stats_frees;
+  stats.limb_bytes           = 0;
+
+  for (uint64_t bins = mpfr_free_bins_map; bins; bins &= bins - 1)
+    for (size_t n = mpfr_free_bins[__builtin_ctzll (bins)]; n != 0;
+         n = mpfr_free_nodes[n].next)
+      {
+        size_t len = length (&mpfr_free_nodes[n].range);
+        stats.free_variables += len;
+        if (len > stats.largest_free_range)
+          stats.largest_free_range = len;
+      }
+
+  for (size_t s = 0; s < mpfr_segments_size; s++)
+    for (size_t i = 0; i < mpfr_segments[s].initialized; i++)
+      stats.limb_bytes += mpfr_custom_get_size (
+        mpfr_get_prec (mpfr_segments[s].data + i));
+
+  if (reset)
+    {
+      mpfr_stats_live_high_water = mpfr_stats_live;
+      mpfr_stats_size_high_water = mpfr_data_size;
+      mpfr_stats_allocations     = 0;
+      mpfr_stats_frees           = 0;
+    }
+  return (stats);
+}
+
+
+/**
+ * Compare two precisions (qsort).
+ */
+static int
+mpfr_prec_cmp (const void *a, const void *b)
+{
+  mpfr_prec_t pa = *((const mpfr_prec_t *) a);
+  mpfr_prec_t pb = *((const mpfr_prec_t *) b);
+
+  return ((pa > pb) - (pa < pb));
+}
+
+
+/**
+ * Count the initialized MPFR variables by precision.
+ *
+ * Free MPFR variables keep their limbs and are counted, too.
+ *
+ * @param[out] prec  ascending distinct precisions, allocated by `mxMalloc`.
+ * @param[out] count number of MPFR variables of precision `prec[i]`,
+ *                   allocated by `mxMalloc`.
+ *
+ * @returns number of distinct precisions or `SIZE_MAX`, if memory allocation
+ *          failed.
+ */
+size_t
+mex_mpfr_get_prec_histogram (mpfr_prec_t **prec, size_t **count)
+{
+  size_t num_vars = 0;
+
+  for (size_t s = 0; s < mpfr_segments_size; s++)
+    num_vars += mpfr_segments[s].initialized;
+
+  // Allocate at least one element, `mxMalloc (0)` may return NULL.
+  *prec  = (mpfr_prec_t *) mxMalloc ((num_vars + 1) * sizeof(mpfr_prec_t));
+  *count = (size_t *) mxMalloc ((num_vars + 1) * sizeof(size_t));
+  if ((*prec == NULL) || (*count == NULL))
+    return (SIZE_MAX);  // Memory allocation failed.
+
+  size_t k = 0;
+  for (size_t s = 0; s < mpfr_segments_size; s++)
+    for (size_t i = 0; i < mpfr_segments[s].initialized; i++)
+      (*prec)[k++] = mpfr_get_prec (mpfr_segments[s].data + i);
+  qsort (*prec, num_vars, sizeof(mpfr_prec_t), mpfr_prec_cmp);
+
+  // Run-length encoding of the sorted precisions.
+  size_t num_precs = 0;
+  for (size_t i = 0; i < num_vars; i++)
+    if ((num_precs > 0) && ((*prec)[num_precs - 1] == (*prec)[i]))
+      (*count)[num_precs - 1]++;
+    else
+      {
+        (*prec)[num_precs]  = (*prec)[i];
+        (*count)[num_precs] = 1;
+        num_precs++;
+      }
+  return (num_precs);
+}
+
+
+/**
+ * Precompute the MPFR constant caches (pi, log(2), Euler's constant, and
+ * Catalan's constant) on all threads of the OpenMP team.
+ *
+ * In thread-safe MPFR builds each thread has its own caches, which live as
+ * long as the thread.  The OpenMP threads are reused by all MEX calls, thus
+ * the caches are only computed again for a higher precision.
+ *
+ * @param prec precision of the constants.
+ */
+void
+mex_mpfr_cache_warm_up (mpfr_prec_t prec)
+{
+  // The inexact constants must not raise flags of the user.
+  mpfr_flags_t flags = mpfr_flags_save ();
+  #pragma omp parallel
+  {
+    mpfr_t c;
+    mpfr_init2 (c, prec);
+    mpfr_const_pi (c, MPFR_RNDN);
+    mpfr_const_log2 (c, MPFR_RNDN);
+    mpfr_const_euler (c, MPFR_RNDN);
+    mpfr_const_catalan (c, MPFR_RNDN);
+    mpfr_clear (c);
+    mpfr_flags_clear (MPFR_FLAGS_ALL);
+  }
+  mpfr_flags_restore (flags, MPFR_FLAGS_ALL);
+}
+
+
+/**
+ * Free the MPFR constant caches and memory pools of all threads of the
+ * OpenMP team and the global caches.
+ */
+void
+mex_mpfr_cache_free (void)
+{
+  #pragma omp parallel
+  {
+    mpfr_free_cache2 (MPFR_FREE_LOCAL_CACHE);
+  }
+  mpfr_free_cache2 (MPFR_FREE_GLOBAL_CACHE);
+}
@@ -0,0 +1,336 @@
+/*
+ * This file is part of APA.
+ *
+ *  APA is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  APA is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with APA.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mex_mpfr_interface.h"
+
+// Default cost model, roughly matching a current x86_64 machine.  Use
+// `apa ('omp_cost_model', 'tune')` to calibrate it.
+
+mex_mpfr_omp_model_t mex_mpfr_omp_model =
+{
+  500.0,                          // threshold
+  50.0,                           // chunk_cost
+  16.0,                           // irregular_chunks
+  { 0.5, 1.0, 2.0, 30.0, 300.0 }, // weight
+  { 1.0, 1.0, 1.6, 2.0, 2.0 }     // exponent
+};
+
+int mex_omp_par = 1;
+
+double *mex_mpfr_flags_out = NULL;
+
+
+/**
+ * Get the cost class of an MPFR command.
+ *
+ * @param cmd_code code of an MPFR command (1000 - 1999).
+ *
+ * @returns cost class `MEX_MPFR_OMP_*`.
+ */
+int
+mex_mpfr_omp_cost_class (uint64_t cmd_code)
+{
+  switch (cmd_code)
+    {
+      // add, sub, dim, sum, and their variants.
+      case 1031: case 1033: case 1050: case 1061:
+      case 1330: case 1331: case 1332: case 1340: case 1341: case 1342:
+      case 1343: case 1344: case 1345:
+        return (MEX_MPFR_OMP_ADD);
+
+      // mul, sqr, div, roots, fma, remainders, and integer powers.
+      case 1036: case 1038: case 1039: case 1042: case 1043: case 1044:
+      case 1045: case 1046: case 1047: case 1056: case 1057: case 1058:
+      case 1059: case 1060: case 1062: case 1093: case 1094: case 1096:
+      case 1156: case 1157: case 1158: case 1159:
+      case 1350: case 1351: case 1352: case 1360: case 1361: case 1362:
+      case 1363: case 1364: case 1365:
+      // String conversion.
+      case 1009: case 1016: case 1021: case 1217:
+        return (MEX_MPFR_OMP_MUL);
+
+      // log, exp, pow, trigonometric, hyperbolic, agm, and constants.
+      case 1055: case 1083: case 1084: case 1085: case 1086: case 1087:
+      case 1088: case 1089: case 1090: case 1091: case 1092: case 1097:
+      case 1098: case 1099: case 1100: case 1101: case 1102: case 1103:
+      case 1104: case 1105: case 1106: case 1107: case 1108: case 1109:
+      case 1110: case 1111: case 1112: case 1113: case 1114: case 1115:
+      case 1116: case 1117: case 1118: case 1137: case 1139: case 1140:
+      case 1141: case 1142:
+        return (MEX_MPFR_OMP_ELEMENTARY);
+
+      // eint, li2, gamma, beta, zeta, erf, and Bessel functions.
+      case 1119: case 1120: case 1121: case 1122: case 1123: case 1124:
+      case 1125: case 1126: case 1127: case 1128: case 1129: case 1130:
+      case 1131: case 1132: case 1133: case 1134: case 1135: case 1136:
+      case 1138:
+        return (MEX_MPFR_OMP_SPECIAL);
+
+      default:
+        return (MEX_MPFR_OMP_CHEAP);
+    }
+}
+
+
+/**
+ * Check if the cost of an MPFR command varies by orders of magnitude with
+ * its arguments.
+ *
+ * @param cmd_code code of an MPFR command (1000 - 1999).
+ *
+ * @returns `1` for special functions and string conversion, otherwise `0`.
+ */
+int
+mex_mpfr_omp_irregular (uint64_t cmd_code)
+{
+  switch (cmd_code)
+    {
+      case 1009: case 1016: case 1217:  // set_str, init_set_str, strtofr
+      case 1021:                        // get_str
+        return (1);
+
+      default:
+        return (mex_mpfr_omp_cost_class (cmd_code) == MEX_MPFR_OMP_SPECIAL);
+    }
+}
+
+
+/**
+ * Plan the execution of the elementwise loops of a command.
+ *
+ * Sets `mex_omp_par` and the OpenMP runtime schedule used by
+ * `schedule (runtime)`.
+ *
+ * @param cmd_code code of an MPFR command (1000 - 1999).
+ * @param N number of MPFR variables processed by the command.
+ * @param prec precision of the MPFR variables.
+ */
+void
+mex_mpfr_omp_plan (uint64_t cmd_code, size_t N, mpfr_prec_t prec)
+{
+  mex_mpfr_omp_model_t *m   = &mex_mpfr_omp_model;
+  int                   cls = mex_mpfr_omp_cost_class (cmd_code);
+
+  double cost = m->weight[cls] * pow ((double) prec / 64.0, m->exponent[cls]);
+  mex_omp_par = (N > 1) && ((double) N * cost >= m->threshold);
+  if (! mex_omp_par)
+    return;
+
+  // Irregular commands are scheduled in many small chunks, such that idle
+  // threads take over the remaining work of a thread stuck at hard
+  // arguments.
+  double threads = (double) omp_get_max_threads ();
+  if (mex_mpfr_omp_irregular (cmd_code) && (m->irregular_chunks > 0.0))
+    {
+      double chunk = floor ((double) N / (m->irregular_chunks * threads));
+      omp_set_schedule (omp_sched_dynamic, (chunk < 1.0) ? 1 : (int) chunk);
+    }
+
+  // Elementary functions take argument dependent time, balance the load with
+  // chunks of at least `chunk_cost`, but four per thread.
+  else if ((cls >= MEX_MPFR_OMP_ELEMENTARY)
+           && ! mex_mpfr_omp_irregular (cmd_code))
+    {
+      double chunk     = ceil (m->chunk_cost / cost);
+      double max_chunk = floor ((double) N / (4.0 * threads));
+      if (chunk > max_chunk)
+        chunk = max_chunk;
+      if (chunk < 1.0)
+        chunk = 1.0;
+      omp_set_schedule (omp_sched_dynamic, (int) chunk);
+    }
+  else
+    omp_set_schedule (omp_sched_static, 0);
+}
+
+
+/**
+ * Time a representative MPFR function of a cost class.
+ *
+ * @param cls cost class `MEX_MPFR_OMP_*`.
+ * @param prec precision of the operands.
+ *
+ * @returns seconds per call.
+ */
+static double
+omp_tune_time_class (int cls, mpfr_prec_t prec)
+{
+  mpfr_t x, y, z;
+  mpfr_inits2 (prec, x, y, z, (mpfr_ptr) 0);
+  mpfr_set_ui (x, 7, MPFR_RNDN);
+  mpfr_div_ui (x, x, 9, MPFR_RNDN);
+  mpfr_set_ui (y, 13, MPFR_RNDN);
+  mpfr_div_ui (y, y, 11, MPFR_RNDN);
+
+  // Repeat the call until at least 2 milliseconds elapsed.
+  size_t reps    = 0;
+  double t_start = omp_get_wtime ();
+  double t       = 0.0;
+  do
+    {
+      for (size_t i = 0; i < 16; i++)
+        switch (cls)
+          {
+            case MEX_MPFR_OMP_CHEAP:      mpfr_neg (z, x, MPFR_RNDN);    break;
+            case MEX_MPFR_OMP_ADD:        mpfr_add (z, x, y, MPFR_RNDN); break;
+            case MEX_MPFR_OMP_MUL:        mpfr_mul (z, x, y, MPFR_RNDN); break;
+            case MEX_MPFR_OMP_ELEMENTARY: mpfr_exp (z, x, MPFR_RNDN);    break;
+            case MEX_MPFR_OMP_SPECIAL:    mpfr_erf (z, y, MPFR_RNDN);    break;
+          }
+      reps += 16;
+      t     = omp_get_wtime () - t_start;
+    }
+  while (t < 2e-3);
+
+  mpfr_clears (x, y, z, (mpfr_ptr) 0);
+  return (t / (double) reps);
+}
+
+
+/**
+ * Calibrate the cost model by timing representative MPFR functions of each
+ * cost class and the OpenMP overhead on this machine.
+ *
+ * @returns calibrated cost model.
+ */
+mex_mpfr_omp_model_t
+mex_mpfr_omp_tune (void)
+{
+  mex_mpfr_omp_model_t model = mex_mpfr_omp_model;
+  mpfr_flags_t         flags = mpfr_flags_save ();
+
+  // The unit of cost is one `mpfr_add` at 64 bit precision.
+  double unit = omp_tune_time_class (MEX_MPFR_OMP_ADD, 64);
+  for (int cls = 0; cls < MEX_MPFR_OMP_NUM_CLASSES; cls++)
+    {
+      double t_low  = omp_tune_time_class (cls, 64);
+      double t_high = omp_tune_time_class (cls, 1024);
+      model.weight[cls]   = t_low / unit;
+      model.exponent[cls] = fmax (0.0, log (t_high / t_low) / log (16.0));
+    }
+
+  // Overhead of starting a parallel loop and of scheduling a dynamic chunk.
+  int    threads = omp_get_max_threads ();
+  size_t reps    = 1000;
+  size_t chunks  = 100 * (size_t) threads;
+  double sum     = 0.0;
+  double t_start = omp_get_wtime ();
+  for (size_t r = 0; r < reps; r++)
+    {
+      #pragma omp parallel for schedule (static) reduction (+:sum)
+      for (int i = 0; i < threads; i++)
+        {
+          mpfr_flags_clear (MPFR_FLAGS_ALL);
+          sum += (double) i;
+        }
+    }
+  double t_fork = (omp_get_wtime () - t_start) / (double) reps;
+
+  t_start = omp_get_wtime ();
+  for (size_t r = 0; r < 10; r++)
+    {
+      #pragma omp parallel for schedule (dynamic, 1) reduction (+:sum)
+      for (size_t i = 0; i < chunks; i++)
+        sum += (double) i;
+    }
+  double t_chunk = ((omp_get_wtime () - t_start) / 10.0 - t_fork)
+                   * (double) threads / (double) chunks;
+  DBG_PRINTF ("unit = %e s, fork = %e s, chunk = %e s (%e)\n", unit, t_fork,
+              t_chunk, sum);
+
+  // Run in parallel, if the serial time is at least twice the overhead,
+  // and make the overhead of a chunk at most 10% of its time.
+  model.threshold  = 2.0 * t_fork / unit;
+  model.chunk_cost = fmax (1.0, 10.0 * t_chunk / unit);
+
+  // The timed functions must not raise flags of the user.
+  mpfr_flags_restore (flags, MPFR_FLAGS_ALL);
+  return (model);
+}
+
+
+/**
+ * Convert a cost model to a vector of length `MEX_MPFR_OMP_MODEL_LENGTH`
+ * `[threshold, chunk_cost, irregular_chunks, weight(1:5), exponent(1:5)]`.
+ *
+ * @param[in] model cost model.
+ * @param[out] vec vector representation.
+ */
+void
+mex_mpfr_omp_model_to_vector (const mex_mpfr_omp_model_t *model, double *vec)
+{
+  vec[0] = model->threshold;
+  vec[1] = model->chunk_cost;
+  vec[2] = model->irregular_chunks;
+  for (int cls = 0; cls < MEX_MPFR_OMP_NUM_CLASSES; cls++)
+    {
+      vec[3 + cls]                            = model->weight[cls];
+      vec[3 + MEX_MPFR_OMP_NUM_CLASSES + cls] = model->exponent[cls];
+    }
+}
+
+
+/**
+ * Convert a vector `[threshold, chunk_cost, irregular_chunks, weight(1:5),
+ * exponent(1:5)]` to a cost model.
+ *
+ * @param[in] vec vector representation.
+ * @param[out] model If function returns `1`, the cost model, otherwise
+ *                   `model` remains unchanged.
+ *
+ * @returns `0` if a value is negative or not finite, otherwise `1`.
+ */
+int
+mex_mpfr_omp_model_from_vector (const double *vec,
+                                mex_mpfr_omp_model_t *model)
+{
+  for (size_t i = 0; i < MEX_MPFR_OMP_MODEL_LENGTH; i++)
+    if (! mxIsFinite (vec[i]) || (vec[i] < 0.0))
+      return (0);
+
+  model->threshold        = vec[0];
+  model->chunk_cost       = vec[1];
+  model->irregular_chunks = vec[2];
+  for (int cls = 0; cls < MEX_MPFR_OMP_NUM_CLASSES; cls++)
+    {
+      model->weight[cls]   = vec[3 + cls];
+      model->exponent[cls] = vec[3 + MEX_MPFR_OMP_NUM_CLASSES + cls];
+    }
+  return (1);
+}
+
+
+/**
+ * Take the MPFR exception flags of a worker thread at the end of a parallel
+ * region.  The flags of the worker thread are cleared.
+ *
+ * MPFR flags are thread-local.  Each parallel region running MPFR functions
+ * reduces the flags of its threads with `reduction (|:flags)` and sets them
+ * in the calling thread with `mpfr_flags_set` afterwards.
+ *
+ * @returns flags of the calling thread, or `0` for the primary thread of the
+ *          team, which keeps its flags.
+ */
+mpfr_flags_t
+mex_mpfr_omp_flags_collect (void)
+{
+  if (omp_get_thread_num () == 0)
+    return (0);
+  mpfr_flags_t flags = mpfr_flags_save ();
+  mpfr_flags_clear (MPFR_FLAGS_ALL);
+  return (flags);
+}
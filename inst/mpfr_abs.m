@@ -12,6 +12,12 @@ function ret = mpfr_abs (rop, op, rnd)
 % contrary to IEEE 754, the NaN flag is set as usual.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1049, rop, op, rnd);
 end
 
@@ -10,6 +10,15 @@ function ret = mpfr_add (rop, op1, op2, rnd)
 % ‘IEEE_DBL_MANT_DIG’, and if not defined 53 bits).
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op1, 'mpfr_t'))
+    op1 = op1.handle;
+  end
+  if (isa (op2, 'mpfr_t'))
+    op2 = op2.handle;
+  end
   ret = mex_apa_interface (1031, rop, op1, op2, rnd);
 end
 
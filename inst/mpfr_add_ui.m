@@ -10,6 +10,12 @@ function ret = mpfr_add_ui (rop, op1, op2, rnd)
 % ‘IEEE_DBL_MANT_DIG’, and if not defined 53 bits).
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op1, 'mpfr_t'))
+    op1 = op1.handle;
+  end
   ret = mex_apa_interface (1331, rop, op1, op2, rnd);
 end
 
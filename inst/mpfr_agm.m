@@ -10,6 +10,15 @@ function ret = mpfr_agm (rop, op1, op2, rnd)
 % one is finite (resp. infinite), set ROP to +0 (resp. NaN).
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op1, 'mpfr_t'))
+    op1 = op1.handle;
+  end
+  if (isa (op2, 'mpfr_t'))
+    op2 = op2.handle;
+  end
   ret = mex_apa_interface (1137, rop, op1, op2, rnd);
 end
 
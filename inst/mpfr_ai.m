@@ -9,6 +9,12 @@ function ret = mpfr_ai (rop, x, rnd)
 % should be used and will be implemented in a future version.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (x, 'mpfr_t'))
+    x = x.handle;
+  end
   ret = mex_apa_interface (1138, rop, x, rnd);
 end
 
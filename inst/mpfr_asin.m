@@ -11,6 +11,12 @@ function ret = mpfr_asin (rop, op, rnd)
 % with large OP and small precision of ROP.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1106, rop, op, rnd);
 end
 
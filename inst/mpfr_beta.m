@@ -6,6 +6,15 @@ function ret = mpfr_beta (rop, op1, op2, rnd)
 % underflow, and might use a huge internal precision in some cases.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op1, 'mpfr_t'))
+    op1 = op1.handle;
+  end
+  if (isa (op2, 'mpfr_t'))
+    op2 = op2.handle;
+  end
   ret = mex_apa_interface (1126, rop, op1, op2, rnd);
 end
 
@@ -14,6 +14,12 @@ function ret = mpfr_cbrt (rop, op, rnd)
 % Functions allowing a negative N may be implemented in the future.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1045, rop, op, rnd);
 end
 
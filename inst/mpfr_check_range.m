@@ -24,6 +24,9 @@ function ret = mpfr_check_range (x, t, rnd)
 % could have been set due to internal computations.
 %
 
+  if (isa (x, 'mpfr_t'))
+    x = x.handle;
+  end
   ret = mex_apa_interface (1196, x, t, rnd);
 end
 
@@ -15,6 +15,12 @@ function ret = mpfr_cmp (op1, op2)
 % conversion first).
 %
 
+  if (isa (op1, 'mpfr_t'))
+    op1 = op1.handle;
+  end
+  if (isa (op2, 'mpfr_t'))
+    op2 = op2.handle;
+  end
   ret = mex_apa_interface (1063, op1, op2);
 end
 
@@ -15,6 +15,9 @@ function ret = mpfr_cmp_ld (op1, op2)
 % conversion first).
 %
 
+  if (isa (op1, 'mpfr_t'))
+    op1 = op1.handle;
+  end
   ret = mex_apa_interface (1037, op1, op2);
 end
 
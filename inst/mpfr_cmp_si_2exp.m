@@ -5,6 +5,9 @@ function ret = mpfr_cmp_si_2exp (op1, op2, e)
 % above.
 %
 
+  if (isa (op1, 'mpfr_t'))
+    op1 = op1.handle;
+  end
   ret = mex_apa_interface (1066, op1, op2, e);
 end
 
@@ -6,6 +6,12 @@ function ret = mpfr_cmpabs (op1, op2)
 % one of the operands is NaN, set the _erange_ flag and return zero.
 %
 
+  if (isa (op1, 'mpfr_t'))
+    op1 = op1.handle;
+  end
+  if (isa (op2, 'mpfr_t'))
+    op2 = op2.handle;
+  end
   ret = mex_apa_interface (1067, op1, op2);
 end
 
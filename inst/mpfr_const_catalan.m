@@ -9,6 +9,9 @@ function ret = mpfr_const_catalan (rop, rnd)
 % ‘mpfr_free_cache2’.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
   ret = mex_apa_interface (1142, rop, rnd);
 end
 
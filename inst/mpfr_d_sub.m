@@ -9,6 +9,12 @@ function ret = mpfr_d_sub (rop, op1, op2, rnd)
 % ‘mpfr_sub_d’.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op2, 'mpfr_t'))
+    op2 = op2.handle;
+  end
   ret = mex_apa_interface (1343, rop, op1, op2, rnd);
 end
 
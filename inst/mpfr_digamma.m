@@ -6,6 +6,12 @@ function ret = mpfr_digamma (rop, op, rnd)
 % negative integer, set ROP to NaN.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1125, rop, op, rnd);
 end
 
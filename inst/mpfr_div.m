@@ -10,6 +10,15 @@ function ret = mpfr_div (rop, op1, op2, rnd)
 % ‘mpfr_add_d’ apply to ‘mpfr_d_div’ and ‘mpfr_div_d’.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op1, 'mpfr_t'))
+    op1 = op1.handle;
+  end
+  if (isa (op2, 'mpfr_t'))
+    op2 = op2.handle;
+  end
   ret = mex_apa_interface (1039, rop, op1, op2, rnd);
 end
 
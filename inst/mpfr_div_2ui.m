@@ -6,6 +6,12 @@ function ret = mpfr_div_2ui (rop, op1, op2, rnd)
 % identical.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op1, 'mpfr_t'))
+    op1 = op1.handle;
+  end
   ret = mex_apa_interface (1053, rop, op1, op2, rnd);
 end
 
@@ -8,6 +8,15 @@ function ret = mpfr_dot (rop, a, b, n, rnd)
 % overflows and underflows.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (a, 'mpfr_t'))
+    a = a.handle;
+  end
+  if (isa (b, 'mpfr_t'))
+    b = b.handle;
+  end
   ret = mex_apa_interface (1062, rop, a, b, n, rnd);
 end
 
@@ -5,6 +5,12 @@ function ret = mpfr_erfc (rop, op, rnd)
 % complementary error function on OP) rounded in the direction RND.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1130, rop, op, rnd);
 end
 
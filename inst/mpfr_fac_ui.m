@@ -4,6 +4,9 @@ function ret = mpfr_fac_ui (rop, op, rnd)
 % Set ROP to the factorial of OP, rounded in the direction RND.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
   ret = mex_apa_interface (1055, rop, op, rnd);
 end
 
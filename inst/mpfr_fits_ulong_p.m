@@ -15,6 +15,9 @@ function ret = mpfr_fits_ulong_p (op, rnd)
 % non-negative number less than or equal to ‘ULONG_MAX’.
 %
 
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1023, op, rnd);
 end
 
@@ -35,6 +35,12 @@ function ret = mpfr_floor (rop, op)
 % to 8 again with even rounding.)
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1145, rop, op);
 end
 
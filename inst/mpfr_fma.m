@@ -8,6 +8,18 @@ function ret = mpfr_fma (rop, op1, op2, op3, rnd)
 % That is, the fused operation matters only for rounding.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op1, 'mpfr_t'))
+    op1 = op1.handle;
+  end
+  if (isa (op2, 'mpfr_t'))
+    op2 = op2.handle;
+  end
+  if (isa (op3, 'mpfr_t'))
+    op3 = op3.handle;
+  end
   ret = mex_apa_interface (1056, rop, op1, op2, op3, rnd);
 end
 
@@ -8,6 +8,21 @@ function ret = mpfr_fmma (rop, op1, op2, op3, op4, rnd)
 % intermediate products were computed with rounding toward zero.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op1, 'mpfr_t'))
+    op1 = op1.handle;
+  end
+  if (isa (op2, 'mpfr_t'))
+    op2 = op2.handle;
+  end
+  if (isa (op3, 'mpfr_t'))
+    op3 = op3.handle;
+  end
+  if (isa (op4, 'mpfr_t'))
+    op4 = op4.handle;
+  end
   ret = mex_apa_interface (1058, rop, op1, op2, op3, op4, rnd);
 end
 
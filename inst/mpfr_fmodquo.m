@@ -23,6 +23,15 @@ function [ret, q] = mpfr_fmodquo (r, x, y, rnd)
 % additive argument reduction.
 %
 
+  if (isa (r, 'mpfr_t'))
+    r = r.handle;
+  end
+  if (isa (x, 'mpfr_t'))
+    x = x.handle;
+  end
+  if (isa (y, 'mpfr_t'))
+    y = y.handle;
+  end
   [ret, q] = mex_apa_interface (1157, r, x, y, rnd);
 end
 
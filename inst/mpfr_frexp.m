@@ -9,6 +9,12 @@ function ret = mpfr_frexp (exp, y, x, rnd)
 % undefined.
 %
 
+  if (isa (y, 'mpfr_t'))
+    y = y.handle;
+  end
+  if (isa (x, 'mpfr_t'))
+    x = x.handle;
+  end
   ret = mex_apa_interface (1019, exp, y, x, rnd);
 end
 
@@ -13,6 +13,12 @@ function ret = mpfr_gamma (rop, op, rnd)
 % might also occur.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1121, rop, op, rnd);
 end
 
@@ -13,6 +13,15 @@ function ret = mpfr_gamma_inc (rop, op, op2, rnd)
 % might also occur.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
+  if (isa (op2, 'mpfr_t'))
+    op2 = op2.handle;
+  end
   ret = mex_apa_interface (1122, rop, op, op2, rnd);
 end
 
@@ -11,6 +11,9 @@ function ret = mpfr_get_d_2exp (exp, op, rnd)
 % value is returned, and EXP is undefined.
 %
 
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1018, exp, op, rnd);
 end
 
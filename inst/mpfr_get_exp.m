@@ -8,6 +8,9 @@ function ret = mpfr_get_exp (x)
 % undefined.
 %
 
+  if (isa (x, 'mpfr_t'))
+    x = x.handle;
+  end
   ret = mex_apa_interface (1176, x);
 end
 
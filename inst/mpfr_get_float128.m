@@ -13,6 +13,9 @@ function ret = mpfr_get_float128 (op, rnd)
 % ‘mpfr_set_decimal64’ and ‘mpfr_set_decimal128’ respectively.
 %
 
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1413, op, rnd);
 end
 
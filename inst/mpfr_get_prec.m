@@ -5,6 +5,9 @@ function ret = mpfr_get_prec (x)
 % its significand.
 %
 
+  if (isa (x, 'mpfr_t'))
+    x = x.handle;
+  end
   ret = mex_apa_interface (1004, x);
 end
 
@@ -13,6 +13,9 @@ function ret = mpfr_get_si (op, rnd)
 % and ‘mpfr_fits_uintmax_p’.
 %
 
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1416, op, rnd);
 end
 
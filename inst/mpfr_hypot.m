@@ -9,6 +9,15 @@ function ret = mpfr_hypot (rop, x, y, rnd)
 % other number is NaN.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (x, 'mpfr_t'))
+    x = x.handle;
+  end
+  if (isa (y, 'mpfr_t'))
+    y = y.handle;
+  end
   ret = mex_apa_interface (1060, rop, x, y, rnd);
 end
 
@@ -10,6 +10,9 @@ function mpfr_init (x)
 % ‘mpfr_init2’.
 %
 
+  if (isa (x, 'mpfr_t'))
+    x = x.handle;
+  end
   mex_apa_interface (1218, x);
 end
 
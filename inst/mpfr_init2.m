@@ -16,6 +16,9 @@ function mpfr_init2 (x, prec)
 % undefined).
 %
 
+  if (isa (x, 'mpfr_t'))
+    x = x.handle;
+  end
   mex_apa_interface (1000, x, prec);
 end
 
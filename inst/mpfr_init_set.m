@@ -6,6 +6,12 @@ function ret = mpfr_init_set (rop, op, rnd)
 % precision, as set by ‘mpfr_set_default_prec’.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1014, rop, op, rnd);
 end
 
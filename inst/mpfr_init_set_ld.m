@@ -6,6 +6,9 @@ function ret = mpfr_init_set_ld (rop, op, rnd)
 % precision, as set by ‘mpfr_set_default_prec’.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
   ret = mex_apa_interface (1313, rop, op, rnd);
 end
 
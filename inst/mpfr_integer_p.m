@@ -4,6 +4,9 @@ function ret = mpfr_integer_p (op)
 % Return non-zero iff OP is an integer.
 %
 
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1160, op);
 end
 
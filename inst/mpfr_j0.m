@@ -9,6 +9,12 @@ function ret = mpfr_j0 (rop, op, rnd)
 % OP.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1131, rop, op, rnd);
 end
 
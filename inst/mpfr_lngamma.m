@@ -9,6 +9,12 @@ function ret = mpfr_lngamma (rop, op, rnd)
 % ROP to NaN.  See also ‘mpfr_lgamma’.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1123, rop, op, rnd);
 end
 
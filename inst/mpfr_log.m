@@ -8,6 +8,12 @@ function ret = mpfr_log (rop, op, rnd)
 % sign of the zero has no influence on the result).
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1083, rop, op, rnd);
 end
 
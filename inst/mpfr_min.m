@@ -7,6 +7,15 @@ function ret = mpfr_min (rop, op1, op2, rnd)
 % different signs, then ROP is set to −0 (resp. +0).
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op1, 'mpfr_t'))
+    op1 = op1.handle;
+  end
+  if (isa (op2, 'mpfr_t'))
+    op2 = op2.handle;
+  end
   ret = mex_apa_interface (1169, rop, op1, op2, rnd);
 end
 
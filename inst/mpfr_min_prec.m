@@ -5,6 +5,9 @@ function ret = mpfr_min_prec (x)
 % of X, and 0 for special values, including 0.
 %
 
+  if (isa (x, 'mpfr_t'))
+    x = x.handle;
+  end
   ret = mex_apa_interface (1165, x);
 end
 
@@ -10,6 +10,15 @@ function ret = mpfr_modf (iop, fop, op, rnd)
 % the return value).
 %
 
+  if (isa (iop, 'mpfr_t'))
+    iop = iop.handle;
+  end
+  if (isa (fop, 'mpfr_t'))
+    fop = fop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1155, iop, fop, op, rnd);
 end
 
@@ -5,6 +5,12 @@ function ret = mpfr_mul_2si (rop, op1, op2, rnd)
 % Just increases the exponent by OP2 when ROP and OP1 are identical.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op1, 'mpfr_t'))
+    op1 = op1.handle;
+  end
   ret = mex_apa_interface (1052, rop, op1, op2, rnd);
 end
 
@@ -8,6 +8,12 @@ function ret = mpfr_mul_ui (rop, op1, op2, rnd)
 % ‘mpfr_mul_d’.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op1, 'mpfr_t'))
+    op1 = op1.handle;
+  end
   ret = mex_apa_interface (1351, rop, op1, op2, rnd);
 end
 
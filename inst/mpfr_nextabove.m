@@ -5,6 +5,9 @@ function mpfr_nextabove (x)
 % minus infinity).
 %
 
+  if (isa (x, 'mpfr_t'))
+    x = x.handle;
+  end
   mex_apa_interface (1167, x);
 end
 
@@ -5,6 +5,9 @@ function mpfr_nextbelow (x)
 % minus infinity).
 %
 
+  if (isa (x, 'mpfr_t'))
+    x = x.handle;
+  end
   mex_apa_interface (1168, x);
 end
 
@@ -10,6 +10,12 @@ function mpfr_nexttoward (x, y)
 % sign.  No underflow, overflow, or inexact exception is raised.
 %
 
+  if (isa (x, 'mpfr_t'))
+    x = x.handle;
+  end
+  if (isa (y, 'mpfr_t'))
+    y = y.handle;
+  end
   mex_apa_interface (1166, x, y);
 end
 
@@ -7,6 +7,9 @@ function ret = mpfr_number_p (op)
 % otherwise.
 %
 
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1071, op);
 end
 
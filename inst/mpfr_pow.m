@@ -24,6 +24,15 @@ function ret = mpfr_pow (rop, op1, op2, rnd)
 % these rules are not used for ‘pow’.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op1, 'mpfr_t'))
+    op1 = op1.handle;
+  end
+  if (isa (op2, 'mpfr_t'))
+    op2 = op2.handle;
+  end
   ret = mex_apa_interface (1092, rop, op1, op2, rnd);
 end
 
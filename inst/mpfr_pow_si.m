@@ -24,6 +24,12 @@ function ret = mpfr_pow_si (rop, op1, op2, rnd)
 % these rules are not used for ‘pow’.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op1, 'mpfr_t'))
+    op1 = op1.handle;
+  end
   ret = mex_apa_interface (1094, rop, op1, op2, rnd);
 end
 
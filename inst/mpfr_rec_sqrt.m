@@ -9,6 +9,12 @@ function ret = mpfr_rec_sqrt (rop, op, rnd)
 % +Inf.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1044, rop, op, rnd);
 end
 
@@ -28,6 +28,12 @@ function ret = mpfr_rint_trunc (rop, op, rnd)
 % than 8.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1153, rop, op, rnd);
 end
 
@@ -35,6 +35,12 @@ function ret = mpfr_set (rop, op, rnd)
 % ‘mpfr_set_decimal128’) number before MPFR can work with it.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1005, rop, op, rnd);
 end
 
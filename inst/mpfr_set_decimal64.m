@@ -35,6 +35,9 @@ function ret = mpfr_set_decimal64 (rop, op, rnd)
 % ‘mpfr_set_decimal128’) number before MPFR can work with it.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
   ret = mex_apa_interface (1308, rop, op, rnd);
 end
 
@@ -15,6 +15,9 @@ function mpfr_set_prec (x, prec)
 % Interface::).
 %
 
+  if (isa (x, 'mpfr_t'))
+    x = x.handle;
+  end
   mex_apa_interface (1003, x, prec);
 end
 
@@ -6,6 +6,9 @@ function ret = mpfr_set_sj_2exp (rop, op, e, rnd)
 % converted to +0.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
   ret = mex_apa_interface (1321, rop, op, e, rnd);
 end
 
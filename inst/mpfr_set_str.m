@@ -18,6 +18,9 @@ function ret = mpfr_set_str (rop, s, base, rnd)
 % or from an overflow.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
   ret = mex_apa_interface (1009, rop, s, base, rnd);
 end
 
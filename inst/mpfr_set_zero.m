@@ -7,6 +7,9 @@ function mpfr_set_zero (x, sign)
 % ‘mpfr_set_nan’, the sign bit of the result is unspecified.
 %
 
+  if (isa (x, 'mpfr_t'))
+    x = x.handle;
+  end
   mex_apa_interface (1012, x, sign);
 end
 
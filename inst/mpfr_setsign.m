@@ -6,6 +6,12 @@ function ret = mpfr_setsign (rop, op, s, rnd)
 % zero), even when OP is a NaN.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1179, rop, op, s, rnd);
 end
 
@@ -7,6 +7,9 @@ function ret = mpfr_sgn (op)
 % efficient.
 %
 
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1074, op);
 end
 
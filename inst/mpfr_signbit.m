@@ -5,6 +5,9 @@ function ret = mpfr_signbit (op)
 % negative, −0, or a NaN whose representation has its sign bit set).
 %
 
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1178, op);
 end
 
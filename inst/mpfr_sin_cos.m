@@ -10,6 +10,15 @@ function ret = mpfr_sin_cos (sop, cop, op, rnd)
 % of OP.
 %
 
+  if (isa (sop, 'mpfr_t'))
+    sop = sop.handle;
+  end
+  if (isa (cop, 'mpfr_t'))
+    cop = cop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1101, sop, cop, op, rnd);
 end
 
@@ -5,6 +5,12 @@ function ret = mpfr_sinh (rop, op, rnd)
 % the direction RND.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1110, rop, op, rnd);
 end
 
@@ -8,6 +8,15 @@ function ret = mpfr_sinh_cosh (sop, cop, op, rnd)
 % for a more detailed description of the return value).
 %
 
+  if (isa (sop, 'mpfr_t'))
+    sop = sop.handle;
+  end
+  if (isa (cop, 'mpfr_t'))
+    cop = cop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1112, sop, cop, op, rnd);
 end
 
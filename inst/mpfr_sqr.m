@@ -4,6 +4,12 @@ function ret = mpfr_sqr (rop, op, rnd)
 % Set ROP to the square of OP rounded in the direction RND.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1038, rop, op, rnd);
 end
 
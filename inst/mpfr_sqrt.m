@@ -6,6 +6,12 @@ function ret = mpfr_sqrt (rop, op, rnd)
 % Set ROP to NaN if OP is negative.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1042, rop, op, rnd);
 end
 
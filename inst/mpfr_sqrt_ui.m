@@ -6,6 +6,9 @@ function ret = mpfr_sqrt_ui (rop, op, rnd)
 % Set ROP to NaN if OP is negative.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
   ret = mex_apa_interface (1043, rop, op, rnd);
 end
 
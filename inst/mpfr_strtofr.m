@@ -62,6 +62,9 @@ function [ret, endptr] = mpfr_strtofr (rop, nptr, base, rnd)
 % is a valid representation for NaN in base 17.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
   [ret, endptr] = mex_apa_interface (1217, rop, nptr, base, rnd);
 end
 
@@ -9,6 +9,12 @@ function ret = mpfr_sub_si (rop, op1, op2, rnd)
 % ‘mpfr_sub_d’.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op1, 'mpfr_t'))
+    op1 = op1.handle;
+  end
   ret = mex_apa_interface (1342, rop, op1, op2, rnd);
 end
 
@@ -14,6 +14,12 @@ function mpfr_swap (x, y)
 % Custom Interface::).
 %
 
+  if (isa (x, 'mpfr_t'))
+    x = x.handle;
+  end
+  if (isa (y, 'mpfr_t'))
+    y = y.handle;
+  end
   mex_apa_interface (1013, x, y);
 end
 
@@ -5,6 +5,12 @@ function ret = mpfr_unordered_p (op1, op2)
 % compared), zero otherwise.
 %
 
+  if (isa (op1, 'mpfr_t'))
+    op1 = op1.handle;
+  end
+  if (isa (op2, 'mpfr_t'))
+    op2 = op2.handle;
+  end
   ret = mex_apa_interface (1081, op1, op2);
 end
 
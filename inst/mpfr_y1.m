@@ -8,6 +8,12 @@ function ret = mpfr_y1 (rop, op, rnd)
 % on the parity and sign of N.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1135, rop, op, rnd);
 end
 
@@ -8,6 +8,12 @@ function ret = mpfr_yn (rop, n, op, rnd)
 % on the parity and sign of N.
 %
 
+  if (isa (rop, 'mpfr_t'))
+    rop = rop.handle;
+  end
+  if (isa (op, 'mpfr_t'))
+    op = op.handle;
+  end
   ret = mex_apa_interface (1136, rop, n, op, rnd);
 end
 
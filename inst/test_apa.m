@@ -75,21 +75,533 @@ function test_apa ()
   assert (isequal (obj.idx, [1, 1]));
   assert (mpfr_t.get_data_size () == 1);
   assert (mpfr_t.get_data_capacity () == DATA_CHUNK_SIZE);
+  % N^2 variables do not fit into the first segment.  A new segment of at
+  % least the previous capacity is appended.
   obj = mpfr_t (eye (N));
-  assert (isequal (obj.idx, [2, N^2 + 1]));
-  assert (mpfr_t.get_data_size () == N^2 + 1);
-  assert (mpfr_t.get_data_capacity () == 2 * DATA_CHUNK_SIZE);
+  data_size = DATA_CHUNK_SIZE + N^2;
+  assert (isequal (obj.idx, [DATA_CHUNK_SIZE + 1, data_size]));
+  assert (mpfr_t.get_data_size () == data_size);
+  assert (mpfr_t.get_data_capacity () == 3 * DATA_CHUNK_SIZE);
 
   % Bad input
   apa ('verbose', 1);
   for i = {1/2, inf, -42, -1, -2, nan, 'c', eye(3)}
     assert (strcmp (check_error ('mpfr_t.allocate (i{1})'), 'apa:mexFunction'));
-    assert (mpfr_t.get_data_size () == N^2 + 1);
-    assert (mpfr_t.get_data_capacity () == 2 * DATA_CHUNK_SIZE);
+    assert (mpfr_t.get_data_size () == data_size);
+    assert (mpfr_t.get_data_capacity () == 3 * DATA_CHUNK_SIZE);
+  end
+  for i = {0, inf, -42, 1/6, nan, 'c', eye(3)}
+    assert (strcmp (check_error ('mpfr_t.allocate (1, i{1})'), ...
+                    'apa:mexFunction'));
+    assert (mpfr_t.get_data_size () == data_size);
+  end
+  % Index ranges must not cross segment boundaries.
+  for i = {[DATA_CHUNK_SIZE, DATA_CHUNK_SIZE + 1], [1, data_size]}
+    assert (strcmp (check_error ('mpfr_get_prec (i{1})'), 'apa:mexFunction'));
+  end
+  apa ('verbose', default_verbosity_level);
+
+
+  % ==============
+  % GMP limb arena
+  % ==============
+
+  % Good input
+  % Each variable needs new limbs, as no variable had such a precision yet.
+  A = rand (5);
+  apa ('limb_arena', false);
+  assert (apa ('limb_arena') == false);
+  mex_apa_interface (3003, 1);  % Reset counters.
+  B = mpfr_t (A, 4000);
+  stats = mex_apa_interface (3003);
+  assert ((stats.hits == 0) && (stats.misses == numel (A)));
+  assert (isequal (double (B), A));
+  apa ('limb_arena', true);
+  assert (apa ('limb_arena') == true);
+  mex_apa_interface (3003, 1);
+  C = mpfr_t (A, 5000);
+  stats = mex_apa_interface (3003);
+  assert ((stats.hits == numel (A)) && (stats.misses == 0));
+  assert (isequal (double (C), A));
+
+  % Bad input
+  for i = {2, -1, nan, 'c', [true, false]}
+    assert (strcmp (check_error ('apa (''limb_arena'', i{1})'), ...
+                    'apa:badInput'));
+  end
+  assert (apa ('limb_arena') == true);
+
+
+  % ==============
+  % mpfr_t.compact
+  % ==============
+
+  % Good input
+  % After freeing `obj` and `E` all remaining variables fit into the first
+  % segment.  The other segment is released.
+  clear obj;
+  D = mpfr_t (1:10);
+  E = mpfr_t (eye (3));
+  F = mpfr_t (-5:-1);
+  clear E;
+  assert (mpfr_t.compact () == 2 * DATA_CHUNK_SIZE);
+  assert (mpfr_t.get_data_capacity () == DATA_CHUNK_SIZE);
+  assert (mpfr_t.get_data_size () == 2 * numel (A) + 10 + 5);
+  assert (isequal (double (B), A));
+  assert (isequal (double (C), A));
+  assert (isequal (double (D), 1:10));
+  assert (isequal (double (F), -5:-1));
+  assert (mpfr_t.compact () == 0);
+  G = mpfr_t (eye (N));
+  assert (isequal (double (G), eye (N)));
+  % Handles stay valid after compaction and can be passed as operands.
+  assert (isa (G.handle, 'uint64') && isscalar (G.handle));
+  assert (all (mpfr_get_prec (G.handle) == mpfr_get_prec (G)));
+  mpfr_add (G.handle, G.handle, G.handle, mpfr_get_default_rounding_mode ());
+  assert (isequal (double (G), 2 * eye (N)));
+  mpfr_add (G, G, G, mpfr_get_default_rounding_mode ());
+  assert (isequal (double (G), 4 * eye (N)));
+  clear D F G;
+
+  % Bad input
+  apa ('verbose', 1);
+  for i = {0, 1/2, inf, -1, nan, 'c', eye(3)}
+    assert (strcmp (check_error ('mex_apa_interface (1905, i{1})'), ...
+                    'apa:mexFunction'));
+  end
+  apa ('verbose', default_verbosity_level);
+
+
+  % =================
+  % Memory statistics
+  % =================
+
+  % Good input
+  apa ('memory', 'reset');
+  stats = apa ('memory');
+  assert ((stats.allocations == 0) && (stats.frees == 0));
+  assert (stats.live_variables == 2 * numel (A));
+  assert (stats.live_high_water == stats.live_variables);
+  assert (stats.live_variables + stats.free_variables == stats.data_size);
+  D = mpfr_t (zeros (1, 7), 6000);
+  clear D;
+  stats = apa ('memory');
+  assert ((stats.allocations == 1) && (stats.frees == 1));
+  assert (stats.live_high_water == 2 * numel (A) + 7);
+  assert (any (all (stats.limb_bytes_by_prec(:,1:2) == [6000, 7], 2)));
+  assert (sum (stats.limb_bytes_by_prec(:,3)) == stats.limb_bytes);
+  assert (isstruct (stats.limb_arena));
+
+  % Bad input
+  for i = {1, 'c', true}
+    assert (strcmp (check_error ('apa (''memory'', i{1})'), 'apa:badInput'));
+  end
+
+
+  % ==================
+  % mpfr_t.zeros_batch
+  % ==================
+
+  % Good input
+  apa ('memory', 'reset');
+  [D, E] = mpfr_t.zeros_batch ({[2, 3], [4, 1]}, [100, 200]);
+  assert (isequal (double (D), zeros (2, 3)));
+  assert (isequal (double (E), zeros (4, 1)));
+  assert (all (mpfr_get_prec (D) == 100) && all (mpfr_get_prec (E) == 200));
+  handles = mex_apa_interface (1909, [3; 4; 5], 53);  % mpfr_t.allocate_handles
+  assert (numel (unique (handles)) == 3);
+  mex_apa_interface (1910, handles);  % mpfr_t.free_handles
+  clear D E;
+  stats = apa ('memory');
+  assert ((stats.allocations == 5) && (stats.frees == 5));
+  assert (stats.live_variables == 2 * numel (A));
+
+  % Bad input
+  apa ('verbose', 1);
+  for i = {{[1, 0], 53}, {[], 53}, {[1, 2], [53, 53, 53]}, {1, 1}, {-1, 53}}
+    assert (strcmp (check_error ('mex_apa_interface (1909, i{1}{:})'), ...
+                    'apa:mexFunction'));
+  end
+  assert (strcmp (check_error ('mex_apa_interface (1910, handles)'), ...
+                  'apa:mexFunction'));
+  apa ('verbose', default_verbosity_level);
+
+
+  % =====================
+  % mpfr_t.command_buffer
+  % =====================
+
+  % Good input
+  % Recurrence from "doc/examples/listing_14_1.m" with and without command
+  % buffer.
+  u = mpfr_t ([2, 2], 600);
+  v = mpfr_t ([-4, -4], 600);
+  x = mpfr_t ([0, 0], 600);
+  y = mpfr_t ([0, 0], 600);
+  z = mpfr_t ([0, 0], 600);
+  s = @(a, i) a.idx(1) + [i, i] - 1;
+  buf = mpfr_t.command_buffer ( ...
+    {@mpfr_ui_div, s(x,2), 1130, s(v,2), MPFR_RNDN}, ...
+    {@mpfr_ui_sub, s(y,2), 111, s(x,2), MPFR_RNDN}, ...
+    {@mpfr_mul, s(z,2), s(v,2), s(u,2), MPFR_RNDN}, ...
+    {@mpfr_ui_div, s(x,2), 3000, s(z,2), MPFR_RNDN}, ...
+    {@mpfr_set, s(u,2), s(v,2), MPFR_RNDN}, ...
+    {@mpfr_add, s(v,2), s(y,2), s(x,2), MPFR_RNDN});
+  for k = 2:199
+    mpfr_ui_div (s(x,1), 1130, s(v,1), MPFR_RNDN);
+    mpfr_ui_sub (s(y,1), 111, s(x,1), MPFR_RNDN);
+    mpfr_mul (s(z,1), s(v,1), s(u,1), MPFR_RNDN);
+    mpfr_ui_div (s(x,1), 3000, s(z,1), MPFR_RNDN);
+    mpfr_set (s(u,1), s(v,1), MPFR_RNDN);
+    mpfr_add (s(v,1), s(y,1), s(x,1), MPFR_RNDN);
+    ret = mpfr_t.run_command_buffer (buf);
+    assert (numel (ret) == 6);
+  end
+  assert (mpfr_equal_p (s(v,1), s(v,2)) && mpfr_equal_p (s(u,1), s(u,2)));
+  assert (abs (double (v(2)) - 100) < 1e-10);
+  clear u v x y z;
+
+  % mpfr_t variables are stored by their handle, which remains valid after
+  % moving the variables by `mpfr_t.compact`.
+  g = mpfr_t (zeros (1, 100));
+  a = mpfr_t (1);
+  b = mpfr_t (2);
+  buf = mpfr_t.command_buffer ({@mpfr_add, a, a, b, MPFR_RNDN});
+  clear g;
+  mpfr_t.compact ();
+  mpfr_t.run_command_buffer (buf);
+  assert (double (a) == 3);
+  clear a b;
+
+  % Bad input
+  for i = {{@sin, 1}, {@mpfr_add, 'c'}, {@mpfr_add, [1, 2, 3]}}
+    assert (strcmp (check_error ('mpfr_t.command_buffer (i{1})'), ...
+                    'mpfr_t:command_buffer'));
+  end
+  apa ('verbose', 1);
+  for i = {[1911, 0], [1005, 9], [1005, 1, 4, 1], [1005, 1, 3, 0]}
+    assert (strcmp (check_error ('mpfr_t.run_command_buffer (i{1})'), ...
+                    'apa:mexFunction'));
+  end
+  apa ('verbose', default_verbosity_level);
+
+
+  % ================
+  % mpfr_t.eval_expr
+  % ================
+
+  % Good input
+  S = warning ('off', 'mpfr_t:inexactOperation');
+  a = mpfr_t (rand (3, 4), 100);
+  b = mpfr_t (rand (3, 4), 100);
+  c = mpfr_t (rand (3, 4), 100);
+  d = mpfr_t (rand (3, 4) + 1, 100);
+  e = mpfr_t (rand (3, 4), 100);
+  f = mpfr_t.eval_expr ({a, b, '.*', c, d, './', '+', e, 'sqrt', '-'});
+  assert (isequal (f.dims, [3, 4]) && all (mpfr_get_prec (f) == 100));
+  assert (all (mpfr_equal_p (f, a.*b + c./d - sqrt(e))));
+  f = mpfr_t.eval_expr ({a, 2, '.*', mpfr_t(3, 100), '-', 'abs', ...
+                         'uminus'}, MPFR_RNDN, 200);
+  assert (all (mpfr_get_prec (f) == 200));
+  assert (isequal (double (f), -abs (2 * double (a) - 3)));
+  f = mpfr_t.eval_expr ({a});
+  assert (isequal (double (f), double (a)));
+  warning (S);
+  clear a b c d e f;
+
+  % Bad input
+  a = mpfr_t (1:3);
+  for i = {{}, {a, '*'}, {a, 'foo'}, {1, 2, '+'}, {a, mpfr_t(1:2), '+'}}
+    assert (strcmp (check_error ('mpfr_t.eval_expr (i{1})'), ...
+                    'mpfr_t:eval_expr'));
+  end
+  apa ('verbose', 1);
+  for i = {[1, 1; 1, 1], [3; 1], [4; 1], [5; 1], [1; 2], [1, 1, 3; 1, 1, 9], ...
+           [1, 1], ones(3, 1)}
+    err_id = check_error ('mex_apa_interface (2005, a, i{1}, 53, 0, a)');
+    assert (strcmp (err_id, 'apa:mexFunction'));
+  end
+  err_id = check_error ('mex_apa_interface (2005, a, [1; 1], 53, 0)');
+  assert (strcmp (err_id, 'apa:mexFunction'));
+  apa ('verbose', default_verbosity_level);
+  clear a;
+
+
+  % =========
+  % Profiling
+  % =========
+
+  % Good input
+  apa ('profile', 'reset');
+  apa ('profile', true);
+  a = mpfr_t (1:10, 200);  % mpfr_set_d (1300)
+  apa ('profile', false);
+  report = apa ('profile');
+  assert (~ report.enabled);
+  i = find (report.cmd_code == 1300);
+  assert (isscalar (i) && (report.calls(i) == 1));
+  assert ((report.elements(i) == 10) && (report.bits(i) == 10 * 200));
+  assert ((report.max_prec(i) == 200) && (report.seconds(i) >= 0));
+  assert (report.errors(i) == 0);
+  apa ('profile', true);
+  assert (strcmp (check_error ('mex_apa_interface (1031)'), 'apa:mexFunction'));
+  apa ('profile', false);
+  report = apa ('profile');
+  i = find (report.cmd_code == 1031);
+  assert (isscalar (i) && (report.calls(i) == 1) && (report.errors(i) == 1));
+  b = mpfr_t (1:10, 200);
+  report = apa ('profile');
+  assert (report.calls(report.cmd_code == 1300) == 1);
+  apa ('profile', 'reset');
+  report = apa ('profile');
+  assert (isempty (report.cmd_code));
+  clear a b;
+
+  % Bad input
+  for i = {2, -1, 'c', [true, false]}
+    assert (strcmp (check_error ('apa (''profile'', i{1})'), 'apa:badInput'));
+  end
+
+
+  % =======
+  % Tracing
+  % =======
+
+  % Good input
+  trace_file = [tempname(), '.json'];
+  apa ('trace', trace_file);
+  assert (strcmp (apa ('trace'), trace_file));
+  S = warning ('off', 'mpfr_t:inexactOperation');
+  A = mpfr_t (magic (4) + eye (4));
+  x = A \ mpfr_t (ones (4, 1));
+  c = cellstr (x);
+  warning (S);
+  % Failing commands end their trace event.
+  assert (strcmp (check_error ('mex_apa_interface (1031)'), 'apa:mexFunction'));
+  apa ('trace', false);
+  assert (isempty (apa ('trace')));
+  trace = strtrim (fileread (trace_file));
+  delete (trace_file);
+  assert (numel (strfind (trace, '"ph": "B"')) ...
+          == numel (strfind (trace, '"ph": "E"')));
+  for i = {'"cmd 2003"', '"GETRF panel"', '"GESV substitution"', ...
+           '"mpfr_t to string"', '"tid": 0'}
+    assert (~ isempty (strfind (trace, i{1})));
+  end
+  assert (strcmp (trace([1, end]), '[]'));
+  clear A x c trace;
+
+  % Bad input
+  for i = {true, 1, ''}
+    assert (strcmp (check_error ('apa (''trace'', i{1})'), 'apa:badInput'));
+  end
+  apa ('verbose', 1);
+  assert (strcmp (check_error ('apa (''trace'', tempdir ())'), 'apa:badInput'));
+  apa ('verbose', default_verbosity_level);
+
+
+  % =================
+  % OpenMP cost model
+  % =================
+
+  % Good input
+  % Serial and parallel execution give the same results.
+  model = apa ('omp_cost_model');
+  assert (isequal (fieldnames (model), {'threshold'; 'chunk_cost'; ...
+                   'irregular_chunks'; 'weight'; 'exponent'}));
+  S = warning ('off', 'mpfr_t:inexactOperation');
+  x = mpfr_t ((1:100)' / 7, 128);
+  serial = model;
+  parallel = model;
+  serial.threshold = 1e300;
+  parallel.threshold = 0;
+  parallel.chunk_cost = 1;
+  apa ('omp_cost_model', serial);
+  assert (isequal (apa ('omp_cost_model'), serial));
+  y = mpfr_t (zeros (100, 1), 128);
+  rnd = mpfr_get_default_rounding_mode ();
+  mpfr_exp (y, x, rnd);
+  y1 = double (y + x .* x);
+  apa ('omp_cost_model', parallel);
+  mpfr_exp (y, x, rnd);
+  y2 = double (y + x .* x);
+  warning (S);
+  assert (isequal (y1, y2));
+  model_file = [tempname(), '.txt'];
+  tuned = apa ('omp_cost_model', model_file);  % Calibrate and store.
+  assert (all (tuned.weight > 0) && (tuned.threshold > 0));
+  apa ('omp_cost_model', model);
+  assert (isequal (apa ('omp_cost_model', model_file), tuned));  % Load.
+  assert (isequal (apa ('omp_cost_model'), tuned));
+  % Files without `irregular_chunks`.
+  fid = fopen (model_file, 'w');
+  fprintf (fid, '%.17g\n', [tuned.threshold; tuned.chunk_cost; ...
+                             tuned.weight(:); tuned.exponent(:)]);
+  fclose (fid);
+  loaded = apa ('omp_cost_model', model_file);
+  assert (loaded.irregular_chunks == 16);
+  assert (isequal (rmfield (loaded, 'irregular_chunks'), ...
+                   rmfield (tuned, 'irregular_chunks')));
+  delete (model_file);
+  apa ('omp_cost_model', model);
+  clear x y y1 y2;
+
+  % Bad input
+  bad = model;
+  bad.weight(1) = -1;
+  for i = {true, 1, '', rmfield(model, 'weight'), bad}
+    assert (strcmp (check_error ('apa (''omp_cost_model'', i{1})'), ...
+                    'apa:badInput'));
+  end
+  assert (isequal (apa ('omp_cost_model'), model));
+
+
+  % ==============
+  % OpenMP threads
+  % ==============
+
+  % Good input
+  threads = apa ('threads');
+  assert (threads.threads == 0);
+  assert (strcmp (threads.affinity, 'none'));
+  nested = threads.nested;
+  apa ('threads', 2);
+  apa ('nested', false);
+  threads = apa ('threads');
+  assert ((threads.team_size == 2) && (threads.nested_team_size == 1));
+  assert (apa ('nested') == false);
+  x = mpfr_t (magic (4));
+  assert (isequal (double (x * x), magic (4)^2));
+  apa ('nested', true);
+  assert (apa ('nested') == true);
+  apa ('threads', 0);
+  apa ('nested', nested);
+  if (isunix () && ~ ismac ())
+    apa ('affinity', 'spread');
+    assert (strcmp (apa ('affinity'), 'spread'));
+    apa ('affinity', 'none');
+  end
+  clear x;
+
+  % Bad input
+  for i = {{'threads', -1}, {'threads', 1.5}, {'threads', 'c'}, ...
+           {'nested', 2}, {'affinity', 'far'}, {'affinity', 1}}
+    assert (strcmp (check_error ('apa (i{1}{:})'), 'apa:badInput'));
+  end
+  threads = apa ('threads');
+  assert (threads.threads == 0);
+
+
+  % ====================
+  % mpfr_t.warm_up_cache
+  % ====================
+
+  % Good input
+  mpfr_t.warm_up_cache (256);
+  x = mpfr_t (zeros (1, 8), 256);
+  y = mpfr_t (zeros (1, 8), 256);
+  mpfr_const_pi (x, MPFR_RNDN);
+  mpfr_t.free_cache ();
+  mpfr_const_pi (y, MPFR_RNDN);
+  assert (all (mpfr_equal_p (x, y)));
+  mpfr_t.warm_up_cache ();
+  assert (abs (double (x(1)) - pi) < eps);
+  clear x y;
+
+  % Bad input
+  apa ('verbose', 1);
+  for i = {'mpfr_t.warm_up_cache (0)', 'mpfr_t.warm_up_cache (''c'')'}
+    assert (strcmp (check_error (i{1}), 'apa:mexFunction'));
   end
   apa ('verbose', default_verbosity_level);
 
 
+  % =================
+  % String conversion
+  % =================
+
+  % Good input
+  % Serial and parallel conversion of numbers and special values agree.
+  model = apa ('omp_cost_model');
+  serial = model;
+  serial.threshold = 1e300;
+  parallel = model;
+  parallel.threshold = 0;
+  x = mpfr_t ([1/3, -pi, 0, inf, -inf, nan, 1e300, -1e-300], 200);
+  y = mpfr_t (zeros (1, 8), 200);
+  rnd = mpfr_get_default_rounding_mode ();
+  apa ('omp_cost_model', serial);
+  [s1, e1] = mpfr_get_str (10, 0, x, rnd);
+  [s2, e2] = mpfr_get_str (16, 5, x, rnd);
+  apa ('omp_cost_model', parallel);
+  [p1, f1] = mpfr_get_str (10, 0, x, rnd);
+  [p2, f2] = mpfr_get_str (16, 5, x, rnd);
+  assert (isequal (s1, p1) && isequal (e1([1:3,7:8]), f1([1:3,7:8])));
+  assert (isequal (s2, p2) && isequal (e2([1:3,7:8]), f2([1:3,7:8])));
+  assert (isequal (p1(4:6), {'@Inf@'; '-@Inf@'; '@NaN@'}));
+  assert (numel (p1{1}) == mpfr_get_str_ndigits (10, 200));
+  assert (all (cellfun (@numel, p2([1:3,7:8])) == 5));
+  strs = strcat ('0.', p1, 'e', cellfun (@num2str, num2cell (f1), ...
+                                         'UniformOutput', false));
+  ret = mpfr_set_str (y, strs, 10, rnd);
+  assert (all (ret([1:3,7:8]) == 0));
+  assert (all (mpfr_equal_p (x([1:3,7:8]), y([1:3,7:8]))));
+  ret = mpfr_set_str (y, {'1.5', '', '0x1p4', 'c', '2', '3', '4', '5'}, ...
+                      [10, 10, 0, 10, 10, 10, 10, 10], rnd);
+  assert (isequal (ret(:)', [0, -1, 0, -1, 0, 0, 0, 0]));
+  assert (double (y(1)) == 1.5 && double (y(3)) == 16);
+  apa ('omp_cost_model', model);
+  clear x y;
+
+  % Bad input
+  x = mpfr_t (1:3);
+  apa ('verbose', 1);
+  for i = {-1, inf, nan}
+    assert (strcmp (check_error ('mpfr_get_str (10, i{1}, x, rnd)'), ...
+                    'apa:mexFunction'));
+  end
+  apa ('verbose', default_verbosity_level);
+  [s, e] = mpfr_get_str (99, 0, x, rnd);
+  assert (all (cellfun (@isempty, s)));
+  clear x;
+
+
+  % ====================
+  % MPFR exception flags
+  % ====================
+
+  % Good input
+  % Flags raised by worker threads are merged into the global flags.
+  apa ('omp_cost_model', parallel);
+  x = mpfr_t (ones (1, 2000));
+  x(7) = -1;
+  x(2000) = 1e10;
+  y = mpfr_t (zeros (1, 2000));
+  mpfr_clear_flags ();
+  mpfr_exp (y, x, rnd);
+  assert (mpfr_overflow_p () ~= 0);
+  mpfr_clear_flags ();
+  [flags, ret] = mpfr_t.elementwise_flags (@mpfr_exp, y, x, rnd);
+  assert (isequal (size (flags), [1, 2000]) && isequal (size (ret), [1, 2000]));
+  assert (isequal (find (bitand (flags, 2)), 2000));
+  assert (all (bitand (flags, 8)));
+  assert (mpfr_overflow_p () ~= 0);
+  flags = mpfr_t.elementwise_flags (@mpfr_sqrt, y, x, rnd);
+  assert (isequal (find (flags), 7) && (flags(7) == 4));
+  assert (mpfr_nanflag_p () ~= 0);
+  mpfr_clear_flags ();
+  apa ('omp_cost_model', model);
+
+  % Bad input
+  assert (strcmp (check_error ('mpfr_t.elementwise_flags (@sin, y, x)'), ...
+                  'mpfr_t:elementwise_flags'));
+  apa ('verbose', 1);
+  err = check_error ('mpfr_t.elementwise_flags (@mpfr_set_nan, y)');
+  assert (strcmp (err, 'apa:mexFunction'));
+  apa ('verbose', default_verbosity_level);
+  clear x y;
+
+
   % ==================
   % mpfr_t constructor
   % ==================
@@ -415,6 +927,58 @@ function test_apa ()
       end
     end
   end
+  % The tiled multiplication (default) accumulates in the same order as the
+  % plain loops (strategy 1), also across tile and K-block boundaries.
+  S = warning ('off', 'mpfr_t:inexactOperation');
+  a = mpfr_t (rand (37, 300), 100);
+  b = mpfr_t (rand (300, 70), 100);
+  rnd = mpfr_get_default_rounding_mode ();
+  assert (all (mpfr_equal_p (mtimes (a, b, rnd, 100, 1), a * b)));
+  % The dot products of strategy 7 are correctly rounded.  At precision 1000
+  % all dot products are exact.
+  a = mpfr_t (rand (5, 300), 53);
+  b = mpfr_t (rand (300, 4), 53);
+  c = mpfr_t (mtimes (a, b, rnd, 1000, 1), 53);
+  assert (all (mpfr_equal_p (mtimes (a, b, rnd, 53, 7), c)));
+  assert (all (mpfr_equal_p (mtimes (a, b, rnd, 53, 9), c)));
+  assert (all (mpfr_equal_p (mtimes (a, b, rnd, 53, 10), c)));
+  a = mpfr_t (-rand (5, 300) .* 2.^(round (100 * rand (5, 300)) - 50), 80);
+  for rnd = [MPFR_RNDN(), MPFR_RNDZ(), MPFR_RNDU(), MPFR_RNDD()]
+    c = mtimes (a, b, rnd, 60, 7);
+    assert (all (mpfr_equal_p (mtimes (a, b, rnd, 60, 9), c)));
+    assert (all (mpfr_equal_p (mtimes (a, b, rnd, 60, 10), c)));
+  end
+  rnd = mpfr_get_default_rounding_mode ();
+  a = mpfr_t ([1e20, 1, -1e20]);
+  b = mpfr_t ([1; 1; 1]);
+  assert (double (mtimes (a, b, rnd, 53, 1)) == 0);
+  assert (double (mtimes (a, b, rnd, 53, 7)) == 1);
+  assert (double (mtimes (a, b, rnd, 53, 9)) == 1);
+  assert (double (mtimes (a, b, rnd, 53, 10)) == 1);
+  % The Strassen-Winograd recursion, also for odd dimensions.
+  for cutoff = [1, 4, 100]
+    a = rand (37, 30);
+    b = rand (30, 21);
+    c = mtimes (mpfr_t (a), mpfr_t (b), rnd, 53, 11, cutoff);
+    assert (max (max (abs (double (c) - a * b))) < 1e-13);
+  end
+  % A double operand is not converted, the products are correctly rounded
+  % like strategy 7.
+  a = mpfr_t (rand (5, 300), 100);
+  b = rand (300, 4);
+  for rnd = [MPFR_RNDN(), MPFR_RNDZ(), MPFR_RNDU(), MPFR_RNDD()]
+    c = mtimes (a, mpfr_t (b), rnd, 60, 7);
+    assert (all (mpfr_equal_p (mtimes (a, b, rnd, 60), c)));
+    c = mtimes (mpfr_t (b'), a', rnd, 60, 7);
+    assert (all (mpfr_equal_p (mtimes (b', a', rnd, 60), c)));
+  end
+  rnd = mpfr_get_default_rounding_mode ();
+  assert (double (mpfr_t ([1e20, 1, -1e20]) * [1; 1; 1]) == 1);
+  assert (double ([1e20, 1, -1e20] * mpfr_t ([1; 1; 1])) == 1);
+  c = times (mpfr_t (1, 100), [1, 3; 7, 9], MPFR_RNDN(), 2);
+  assert (isequal (c.dims, [2, 2]) && all (mpfr_get_prec (c) == 2));
+  assert (isequal (double (c), [1, 3; 8, 8]));
+  warning (S);
   
   % LU-factorization
   S = warning ('off', 'mpfr_t:inexactOperation');
@@ -425,6 +989,15 @@ function test_apa ()
       assert (norm (double (P' * L * U - A)) < 2*eps)
     end
   end
+  % Several tiles.
+  for dims = {[70, 70], [45, 90], [90, 45]}
+    A = mpfr_t (rand (dims{1}), 100);
+    [L, U, P] = lu (A);
+    assert (norm (double (P' * L * U - A), 1) < 1e-25);
+  end
+  A = mpfr_t (rand (70), 100);
+  x = A \ mpfr_t (ones (70, 3), 100);
+  assert (norm (double (A * x - 1), 1) < 1e-20);
   warning (S);
 
   % ====================
@@ -436,6 +1009,14 @@ function test_apa ()
     assert (isequal (double (op (mpfr_t (1:3), mpfr_t (1:3))), op ((1:3), (1:3))));
     assert (isequal (double (op (mpfr_t (1:3), (1:3))), op ((1:3), (1:3))));
     assert (isequal (double (op ((1:3), mpfr_t (1:3))), op ((1:3), (1:3))));
+    assert (isequal (double (op (mpfr_t (2), [1:3; 3:-1:1])), ...
+                     op (2, [1:3; 3:-1:1])));
+    assert (isequal (double (op ([1:3; 3:-1:1], mpfr_t (2))), ...
+                     op ([1:3; 3:-1:1], 2)));
+    assert (isequal (double (op (mpfr_t ([1, NaN, 3]), [1, 2, NaN])), ...
+                     op ([1, NaN, 3], [1, 2, NaN])));
+    assert (isequal (double (op ([1, NaN, 3], mpfr_t ([1, 2, NaN]))), ...
+                     op ([1, NaN, 3], [1, 2, NaN])));
   end
 
 